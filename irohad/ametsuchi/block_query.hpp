@@ -6,6 +6,8 @@
 #ifndef IROHA_BLOCK_QUERY_HPP
 #define IROHA_BLOCK_QUERY_HPP
 
+#include <functional>
+
 #include <boost/optional.hpp>
 #include <rxcpp/rx.hpp>
 #include "ametsuchi/tx_cache_response.hpp"
@@ -53,6 +55,15 @@ namespace iroha {
        */
       virtual std::vector<wBlock> getTopBlocks(uint32_t count) = 0;
 
+      /**
+       * Get height of the block with given hash from the index of blocks
+       * @param hash - hash of the block
+       * @return height of the block, boost::none if the block is not indexed
+       * or storage query has failed
+       */
+      virtual boost::optional<shared_model::interface::types::HeightType>
+      getBlockHeight(const shared_model::crypto::Hash &hash) = 0;
+
       /**
        * Get height of the top block.
        * @return height
@@ -70,6 +81,28 @@ namespace iroha {
       virtual boost::optional<TxCacheStatusType> checkTxPresence(
           const shared_model::crypto::Hash &hash) = 0;
 
+      /**
+       * Synchronously checks presence of several transactions with a single
+       * storage query
+       * @param hashes - transactions' hashes
+       * @return status of each transaction in the order of hashes if storage
+       * query was successful, boost::none otherwise
+       */
+      virtual boost::optional<std::vector<TxCacheStatusType>>
+      checkTxsPresence(
+          const std::vector<shared_model::crypto::Hash> &hashes) = 0;
+
+      /**
+       * Visit hashes of all transactions with known status, i.e. committed
+       * or rejected ones
+       * @param visitor - function called for each hash
+       * @return number of visited hashes if storage query was successful,
+       * boost::none otherwise
+       */
+      virtual boost::optional<size_t> forEachTxHash(
+          const std::function<void(const shared_model::crypto::Hash &)>
+              &visitor) = 0;
+
       /**
        * Get the top-most block
        * @return result of Model Block or error message
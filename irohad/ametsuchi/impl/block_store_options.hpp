@@ -0,0 +1,28 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_STORE_OPTIONS_HPP
+#define IROHA_BLOCK_STORE_OPTIONS_HPP
+
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Block storage implementation and its parameters
+     */
+    struct BlockStoreOptions {
+      enum class Type {
+        kFlatFile,     ///< one file per block
+        kSegmentedLog  ///< blocks packed into append-only segment files
+      };
+      Type type = Type::kFlatFile;
+      SegmentedLog::Options segmented_log;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_STORE_OPTIONS_HPP
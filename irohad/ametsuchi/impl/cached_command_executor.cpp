@@ -0,0 +1,402 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/cached_command_executor.hpp"
+
+#include <boost/algorithm/cxx11/all_of.hpp>
+#include "common/visitor.hpp"
+#include "interfaces/commands/add_asset_quantity.hpp"
+#include "interfaces/commands/command_variant.hpp"
+#include "interfaces/commands/subtract_asset_quantity.hpp"
+#include "interfaces/commands/transfer_asset.hpp"
+#include "interfaces/transaction.hpp"
+#include "utils/string_builder.hpp"
+
+namespace {
+  /**
+   * Same as split_part(str, delimiter, 2) of postgres
+   */
+  std::string secondPart(const std::string &str, char delimiter) {
+    auto begin = str.find(delimiter);
+    if (begin == std::string::npos) {
+      return {};
+    }
+    auto end = str.find(delimiter, begin + 1);
+    return str.substr(begin + 1,
+                      end == std::string::npos ? end : end - begin - 1);
+  }
+
+  /**
+   * Make an error with the query arguments in the same format as the one of
+   * PostgresCommandExecutor, so the results of both executors are equal
+   */
+  template <typename QueryArgsCallable>
+  iroha::ametsuchi::CommandResult makeCommandError(
+      std::string command_name,
+      iroha::ametsuchi::CommandError::ErrorCodeType code,
+      QueryArgsCallable &&query_args) {
+    return iroha::expected::makeError(iroha::ametsuchi::CommandError{
+        std::move(command_name),
+        code,
+        std::forward<QueryArgsCallable>(query_args)(
+            shared_model::detail::PrettyStringBuilder().init(
+                "Query arguments"))});
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using shared_model::interface::permissions::Grantable;
+    using shared_model::interface::permissions::Role;
+
+    CachedCommandExecutor::CachedCommandExecutor(
+        WsvCache &cache, std::unique_ptr<CommandExecutor> executor)
+        : cache_(cache), executor_(std::move(executor)), do_validation_(true) {}
+
+    bool CachedCommandExecutor::isExecutedInMemory(
+        const shared_model::interface::Command &command) {
+      return visit_in_place(
+          command.get(),
+          [](const shared_model::interface::AddAssetQuantity &) {
+            return true;
+          },
+          [](const shared_model::interface::SubtractAssetQuantity &) {
+            return true;
+          },
+          [](const shared_model::interface::TransferAsset &transfer) {
+            // postgres updates the same row twice in this case
+            return transfer.srcAccountId() != transfer.destAccountId();
+          },
+          [](const auto &) { return false; });
+    }
+
+    bool CachedCommandExecutor::isExecutedInMemory(
+        const shared_model::interface::Transaction &transaction) {
+      return boost::algorithm::all_of(
+          transaction.commands(), [](const auto &command) {
+            return CachedCommandExecutor::isExecutedInMemory(command);
+          });
+    }
+
+    void CachedCommandExecutor::collectKeys(
+        const shared_model::interface::Transaction &transaction,
+        WsvCache::Keys &keys) {
+      const auto &creator = transaction.creatorAccountId();
+      auto asset_command = [&](const auto &command) {
+        keys.accounts.push_back(creator);
+        keys.assets.push_back(command.assetId());
+        keys.balances.emplace_back(creator, command.assetId());
+      };
+      for (const auto &command : transaction.commands()) {
+        visit_in_place(
+            command.get(),
+            [&](const shared_model::interface::AddAssetQuantity &add) {
+              asset_command(add);
+            },
+            [&](const shared_model::interface::SubtractAssetQuantity &sub) {
+              asset_command(sub);
+            },
+            [&](const shared_model::interface::TransferAsset &transfer) {
+              keys.accounts.push_back(creator);
+              keys.accounts.push_back(transfer.srcAccountId());
+              keys.accounts.push_back(transfer.destAccountId());
+              if (creator != transfer.srcAccountId()) {
+                keys.grantable_permissions.emplace_back(
+                    creator, transfer.srcAccountId());
+              }
+              keys.assets.push_back(transfer.assetId());
+              keys.balances.emplace_back(transfer.srcAccountId(),
+                                         transfer.assetId());
+              keys.balances.emplace_back(transfer.destAccountId(),
+                                         transfer.assetId());
+            },
+            [](const auto &) {});
+      }
+    }
+
+    void CachedCommandExecutor::setCreatorAccountId(
+        const shared_model::interface::types::AccountIdType
+            &creator_account_id) {
+      creator_account_id_ = creator_account_id;
+      if (executor_) {
+        executor_->setCreatorAccountId(creator_account_id);
+      }
+    }
+
+    void CachedCommandExecutor::doValidation(bool do_validation) {
+      do_validation_ = do_validation;
+      if (executor_) {
+        executor_->doValidation(do_validation);
+      }
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::AddAssetQuantity &command) {
+      const auto &account_id = creator_account_id_;
+      const auto &asset_id = command.assetId();
+      const auto precision = command.amount().precision();
+      auto error = [&](CommandError::ErrorCodeType code) {
+        return makeCommandError("AddAssetQuantity", code, [&](auto &&args) {
+          return args.append("account_id", account_id)
+              .append("asset_id", asset_id)
+              .append("amount", command.amount().toStringRepr())
+              .append("precision", std::to_string(precision))
+              .finalize();
+        });
+      };
+
+      try {
+        const bool has_perm = not do_validation_
+            or hasGlobalOrDomainPermission(
+                   Role::kAddAssetQty, Role::kAddDomainAssetQty, asset_id);
+        const auto asset_precision = cache_.assetPrecision(asset_id);
+        const bool has_asset =
+            asset_precision and *asset_precision >= precision;
+        auto new_value = Decimal(command.amount())
+            + cache_.balance(account_id, asset_id).value_or(Decimal(0, 0));
+        const bool fits = new_value.lessThanPowerOfTwo(256 - precision);
+
+        if (has_perm and has_asset and fits
+            and cache_.accountExists(account_id)) {
+          cache_.setBalance(account_id, asset_id, std::move(new_value));
+          return {};
+        }
+        if (not has_perm) {
+          return error(2);
+        }
+        if (not has_asset) {
+          return error(3);
+        }
+        if (not fits) {
+          return error(4);
+        }
+        return error(1);
+      } catch (const std::exception &) {
+        return error(1);
+      }
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::AddPeer &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::AddSignatory &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::AppendRole &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::CreateAccount &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::CreateAsset &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::CreateDomain &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::CreateRole &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::DetachRole &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::GrantPermission &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::RemoveSignatory &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::RevokePermission &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::SetAccountDetail &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::SetQuorum &command) {
+      return delegate(command);
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::SubtractAssetQuantity &command) {
+      const auto &account_id = creator_account_id_;
+      const auto &asset_id = command.assetId();
+      const auto precision = command.amount().precision();
+      auto error = [&](CommandError::ErrorCodeType code) {
+        return makeCommandError(
+            "SubtractAssetQuantity", code, [&](auto &&args) {
+              return args.append("creator_account_id", account_id)
+                  .append("asset_id", asset_id)
+                  .append("amount", command.amount().toStringRepr())
+                  .append("precision", std::to_string(precision))
+                  .finalize();
+            });
+      };
+
+      try {
+        const bool has_perm = not do_validation_
+            or hasGlobalOrDomainPermission(Role::kSubtractAssetQty,
+                                           Role::kSubtractDomainAssetQty,
+                                           asset_id);
+        const auto asset_precision = cache_.assetPrecision(asset_id);
+        const bool has_asset =
+            asset_precision and *asset_precision >= precision;
+        auto new_value =
+            cache_.balance(account_id, asset_id).value_or(Decimal(0, 0))
+            - Decimal(command.amount());
+        const bool enough = not new_value.isNegative();
+
+        if (has_perm and has_asset and enough
+            and cache_.accountExists(account_id)) {
+          cache_.setBalance(account_id, asset_id, std::move(new_value));
+          return {};
+        }
+        if (not has_perm) {
+          return error(2);
+        }
+        if (not has_asset) {
+          return error(3);
+        }
+        if (not enough) {
+          return error(4);
+        }
+        return error(1);
+      } catch (const std::exception &) {
+        return error(1);
+      }
+    }
+
+    CommandResult CachedCommandExecutor::operator()(
+        const shared_model::interface::TransferAsset &command) {
+      const auto &src_account_id = command.srcAccountId();
+      const auto &dest_account_id = command.destAccountId();
+      if (src_account_id == dest_account_id) {
+        return delegate(command);
+      }
+      const auto &asset_id = command.assetId();
+      const auto precision = command.amount().precision();
+      auto error = [&](CommandError::ErrorCodeType code) {
+        return makeCommandError("TransferAsset", code, [&](auto &&args) {
+          return args.append("src_account_id", src_account_id)
+              .append("dest_account_id", dest_account_id)
+              .append("asset_id", asset_id)
+              .append("amount", command.amount().toStringRepr())
+              .append("precision", std::to_string(precision))
+              .finalize();
+        });
+      };
+
+      try {
+        const bool has_perm = not do_validation_
+            or (cache_.accountPermissions(dest_account_id).test(Role::kReceive)
+                and (creator_account_id_ != src_account_id
+                         ? cache_
+                               .grantablePermissions(creator_account_id_,
+                                                     src_account_id)
+                               .test(Grantable::kTransferMyAssets)
+                         : cache_.accountPermissions(creator_account_id_)
+                               .test(Role::kTransfer)));
+        const bool has_src = cache_.accountExists(src_account_id);
+        const bool has_dest = cache_.accountExists(dest_account_id);
+        const auto asset_precision = cache_.assetPrecision(asset_id);
+        const bool has_asset =
+            asset_precision and *asset_precision >= precision;
+        const Decimal amount(command.amount());
+        auto new_src_value =
+            cache_.balance(src_account_id, asset_id).value_or(Decimal(0, 0))
+            - amount;
+        auto new_dest_value = amount
+            + cache_.balance(dest_account_id, asset_id)
+                  .value_or(Decimal(0, 0));
+        const bool enough = not new_src_value.isNegative();
+        const bool fits = new_dest_value.lessThanPowerOfTwo(256 - precision);
+
+        if (has_perm and has_src and has_dest and has_asset and enough
+            and fits) {
+          cache_.setBalance(
+              src_account_id, asset_id, std::move(new_src_value));
+          cache_.setBalance(
+              dest_account_id, asset_id, std::move(new_dest_value));
+          return {};
+        }
+        if (not has_perm) {
+          return error(2);
+        }
+        if (not has_dest) {
+          return error(4);
+        }
+        if (not has_src) {
+          return error(3);
+        }
+        if (not has_asset) {
+          return error(5);
+        }
+        if (not enough) {
+          return error(6);
+        }
+        if (not fits) {
+          return error(7);
+        }
+        return error(1);
+      } catch (const std::exception &) {
+        return error(1);
+      }
+    }
+
+    template <typename CommandType>
+    CommandResult CachedCommandExecutor::delegate(const CommandType &command) {
+      if (not executor_) {
+        return expected::makeError(
+            CommandError{"", 1, "Command is not executed in memory"});
+      }
+      try {
+        cache_.flush();
+      } catch (const std::exception &e) {
+        cache_.clear();
+        return expected::makeError(CommandError{
+            "", 1, std::string("Failed to write cached changes: ") + e.what()});
+      }
+      auto result = (*executor_)(command);
+      cache_.clear();
+      return result;
+    }
+
+    bool CachedCommandExecutor::hasGlobalOrDomainPermission(
+        Role global_permission,
+        Role domain_permission,
+        const shared_model::interface::types::AssetIdType &asset_id) {
+      const auto &permissions = cache_.accountPermissions(creator_account_id_);
+      return permissions.test(global_permission)
+          or (secondPart(creator_account_id_, '@') == secondPart(asset_id, '#')
+              and permissions.test(domain_permission));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,145 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_CACHED_COMMAND_EXECUTOR_HPP
+#define IROHA_CACHED_COMMAND_EXECUTOR_HPP
+
+#include "ametsuchi/command_executor.hpp"
+
+#include <memory>
+
+#include "ametsuchi/impl/wsv_cache.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Command;
+    class Transaction;
+  }  // namespace interface
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Command executor which validates and applies asset quantity commands
+     * in memory, on a write-through cache of the world state, with the same
+     * results and error codes as PostgresCommandExecutor. Other commands are
+     * delegated to the wrapped executor: the cache is flushed before, and
+     * cleared after them, since they may change any cached value
+     */
+    class CachedCommandExecutor : public CommandExecutor {
+     public:
+      /**
+       * @param cache - cache of the session used by the executor
+       * @param executor - executor of the same session for the commands
+       * which are not executed in memory, may be null if the cache has no
+       * session, then such commands fail
+       */
+      CachedCommandExecutor(WsvCache &cache,
+                            std::unique_ptr<CommandExecutor> executor);
+
+      /**
+       * @return true if the command is executed in memory
+       */
+      static bool isExecutedInMemory(
+          const shared_model::interface::Command &command);
+
+      /**
+       * @return true if all commands of the transaction are executed in
+       * memory, so the transaction does not touch the database until flush
+       */
+      static bool isExecutedInMemory(
+          const shared_model::interface::Transaction &transaction);
+
+      /**
+       * Add keys of the values used by commands of the transaction, which
+       * are executed in memory, to the given ones
+       */
+      static void collectKeys(
+          const shared_model::interface::Transaction &transaction,
+          WsvCache::Keys &keys);
+
+      void setCreatorAccountId(
+          const shared_model::interface::types::AccountIdType
+              &creator_account_id) override;
+
+      void doValidation(bool do_validation) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddAssetQuantity &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddPeer &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AddSignatory &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::AppendRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateAccount &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateAsset &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateDomain &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::CreateRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::DetachRole &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::GrantPermission &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::RemoveSignatory &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::RevokePermission &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SetAccountDetail &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SetQuorum &command) override;
+
+      CommandResult operator()(
+          const shared_model::interface::SubtractAssetQuantity &command)
+          override;
+
+      CommandResult operator()(
+          const shared_model::interface::TransferAsset &command) override;
+
+     private:
+      /**
+       * Execute the command with the wrapped executor
+       */
+      template <typename CommandType>
+      CommandResult delegate(const CommandType &command);
+
+      /**
+       * @return true if the creator has the global permission, or the domain
+       * one and the asset belongs to the domain of the creator
+       */
+      bool hasGlobalOrDomainPermission(
+          shared_model::interface::permissions::Role global_permission,
+          shared_model::interface::permissions::Role domain_permission,
+          const shared_model::interface::types::AssetIdType &asset_id);
+
+      WsvCache &cache_;
+      std::unique_ptr<CommandExecutor> executor_;
+
+      bool do_validation_;
+      shared_model::interface::types::AccountIdType creator_account_id_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_CACHED_COMMAND_EXECUTOR_HPP
@@ -5,6 +5,10 @@
 
 #include "ametsuchi/impl/flat_file/flat_file.hpp"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <ciso646>
 #include <iomanip>
 #include <iostream>
@@ -13,6 +17,8 @@
 #include <boost/filesystem.hpp>
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/range/algorithm/find_if.hpp>
+#include "ametsuchi/impl/mapped_file.hpp"
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
 #include "common/files.hpp"
 
 using namespace iroha::ametsuchi;
@@ -38,6 +44,9 @@ boost::optional<std::unique_ptr<FlatFile>> FlatFile::create(
   }
 
   auto res = FlatFile::check_consistency(path);
+  if (not res) {
+    return boost::none;
+  }
   return std::make_unique<FlatFile>(*res, path, private_tag{});
 }
 
@@ -95,6 +104,35 @@ boost::optional<FlatFile::Bytes> FlatFile::get(Identifier id) const {
   return buf;
 }
 
+boost::optional<FlatFile::BytesView> FlatFile::getView(Identifier id) const {
+  const auto filename =
+      boost::filesystem::path{dump_dir_} / FlatFile::id_to_name(id);
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    log_->info("get({}) file not found", id);
+    return boost::none;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    log_->info("get({}) problem with opening file", id);
+    return boost::none;
+  }
+  if (st.st_size == 0) {
+    ::close(fd);
+    return BytesView{nullptr, 0, nullptr};
+  }
+  // the mapping keeps the file content available after the descriptor is
+  // closed
+  auto mapping = MappedFile::map(fd, st.st_size);
+  ::close(fd);
+  if (not mapping) {
+    log_->info("get({}) problem with mapping file", id);
+    return boost::none;
+  }
+  return BytesView{(*mapping)->data(), (*mapping)->size(), *mapping};
+}
+
 std::string FlatFile::directory() const {
   return dump_dir_;
 }
@@ -137,6 +175,20 @@ boost::optional<Identifier> FlatFile::check_consistency(
     return ps;
   }();
 
+  // files after the first missing block are removed below, which would wipe
+  // a segmented log opened by mistake
+  auto const segment = boost::range::find_if(
+      files, [](const boost::filesystem::path &p) {
+        return p.extension() == SegmentedLog::kSegmentExtension;
+      });
+  if (segment != files.end()) {
+    log->error(
+        "check_consistency({}), directory contains segmented log file {}",
+        dump_dir,
+        segment->string());
+    return boost::none;
+  }
+
   auto const missing = boost::range::find_if(
       files | boost::adaptors::indexed(1), [](const auto &it) {
         return FlatFile::id_to_name(it.index()) != it.value().filename();
@@ -57,6 +57,11 @@ namespace iroha {
 
       boost::optional<Bytes> get(Identifier id) const override;
 
+      /**
+       * Memory-map the file of the entry instead of reading it
+       */
+      boost::optional<BytesView> getView(Identifier id) const override;
+
       std::string directory() const override;
 
       Identifier last_id() const override;
@@ -64,7 +69,8 @@ namespace iroha {
       /**
        * Checking consistency of storage for provided folder
        * If some block in the middle is missing all blocks following it are
-       * deleted
+       * deleted. Fails without deleting anything if the folder contains
+       * segments of a segmented log
        * @param dump_dir - folder of storage
        * @return - last available identifier
        */
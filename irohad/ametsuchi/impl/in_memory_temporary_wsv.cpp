@@ -0,0 +1,89 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/in_memory_temporary_wsv.hpp"
+
+#include "interfaces/commands/command.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    InMemoryTemporaryWsv::InMemoryTemporaryWsv(std::unique_ptr<WsvCache> cache,
+                                               SignaturesResults signatures)
+        : cache_(std::move(cache)),
+          signatures_(std::move(signatures)),
+          command_executor_(*cache_, nullptr) {}
+
+    expected::Result<void, validation::CommandError>
+    InMemoryTemporaryWsv::apply(
+        const shared_model::interface::Transaction &transaction) {
+      auto signatures = signatures_.find(transaction.hash());
+      if (signatures == signatures_.end()) {
+        return expected::makeError(validation::CommandError{
+            "signatures validation",
+            1,
+            "Transaction " + transaction.toString() + " is not in the fork",
+            false});
+      }
+      if (auto error = boost::get<expected::Error<validation::CommandError>>(
+              &signatures->second)) {
+        return *error;
+      }
+
+      command_executor_.setCreatorAccountId(transaction.creatorAccountId());
+      command_executor_.doValidation(true);
+      const auto checkpoint = cache_->checkpoint();
+      const auto &commands = transaction.commands();
+      for (size_t i = 0; i < commands.size(); ++i) {
+        auto result =
+            boost::apply_visitor(command_executor_, commands[i].get());
+        if (auto error = boost::get<expected::Error<CommandError>>(&result)) {
+          cache_->rollback(checkpoint);
+          return expected::makeError(
+              validation::CommandError{error->error.command_name,
+                                       error->error.error_code,
+                                       error->error.error_extra,
+                                       true,
+                                       i});
+        }
+      }
+      return {};
+    }
+
+    std::unique_ptr<TemporaryWsv::SavepointWrapper>
+    InMemoryTemporaryWsv::createSavepoint(const std::string &name) {
+      return std::make_unique<SavepointWrapperImpl>(*cache_);
+    }
+
+    std::unique_ptr<TemporaryWsv> InMemoryTemporaryWsv::fork(
+        const std::vector<
+            shared_model::interface::types::TransactionsCollectionType>
+            &batches) {
+      return nullptr;
+    }
+
+    void InMemoryTemporaryWsv::join(TemporaryWsv &fork) {
+      // never called, since there are no forks of this wsv
+    }
+
+    InMemoryTemporaryWsv::SavepointWrapperImpl::SavepointWrapperImpl(
+        WsvCache &cache)
+        : cache_(cache),
+          checkpoint_(cache_.checkpoint()),
+          is_released_(false) {}
+
+    void InMemoryTemporaryWsv::SavepointWrapperImpl::release() {
+      is_released_ = true;
+    }
+
+    InMemoryTemporaryWsv::SavepointWrapperImpl::~SavepointWrapperImpl() {
+      if (not is_released_) {
+        cache_.rollback(checkpoint_);
+      }
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
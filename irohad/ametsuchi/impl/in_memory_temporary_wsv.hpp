@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_IN_MEMORY_TEMPORARY_WSV_HPP
+#define IROHA_IN_MEMORY_TEMPORARY_WSV_HPP
+
+#include "ametsuchi/temporary_wsv.hpp"
+
+#include <unordered_map>
+
+#include "ametsuchi/impl/cached_command_executor.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
+#include "cryptography/hash.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Fork of TemporaryWsvImpl, which applies a known set of transactions
+     * on a cache without a session. Signatures of the transactions are
+     * validated on creation of the fork, since validity of signatures does
+     * not depend on commands executed in memory
+     */
+    class InMemoryTemporaryWsv : public TemporaryWsv {
+      friend class TemporaryWsvImpl;
+
+     public:
+      /// results of signatures validation by hashes of transactions
+      using SignaturesResults =
+          std::unordered_map<shared_model::crypto::Hash,
+                             expected::Result<void, validation::CommandError>,
+                             shared_model::crypto::Hash::Hasher>;
+
+      struct SavepointWrapperImpl : public TemporaryWsv::SavepointWrapper {
+        explicit SavepointWrapperImpl(WsvCache &cache);
+
+        void release() override;
+
+        ~SavepointWrapperImpl() override;
+
+       private:
+        WsvCache &cache_;
+        WsvCache::Checkpoint checkpoint_;
+        bool is_released_;
+      };
+
+      /**
+       * @param cache - values used by the transactions
+       * @param signatures - signatures validation results of the
+       * transactions
+       */
+      InMemoryTemporaryWsv(std::unique_ptr<WsvCache> cache,
+                           SignaturesResults signatures);
+
+      expected::Result<void, validation::CommandError> apply(
+          const shared_model::interface::Transaction &transaction) override;
+
+      std::unique_ptr<TemporaryWsv::SavepointWrapper> createSavepoint(
+          const std::string &name) override;
+
+      /**
+       * @return nullptr, forks are not forked further
+       */
+      std::unique_ptr<TemporaryWsv> fork(
+          const std::vector<
+              shared_model::interface::types::TransactionsCollectionType>
+              &batches) override;
+
+      void join(TemporaryWsv &fork) override;
+
+     private:
+      std::unique_ptr<WsvCache> cache_;
+      SignaturesResults signatures_;
+      CachedCommandExecutor command_executor_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_IN_MEMORY_TEMPORARY_WSV_HPP
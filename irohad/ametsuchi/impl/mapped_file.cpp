@@ -0,0 +1,40 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/mapped_file.hpp"
+
+#include <sys/mman.h>
+
+#include <ciso646>
+
+using namespace iroha::ametsuchi;
+
+boost::optional<std::shared_ptr<const MappedFile>> MappedFile::map(
+    int fd, size_t size) {
+  if (size == 0) {
+    return boost::none;
+  }
+  void *data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    return boost::none;
+  }
+  return std::make_shared<const MappedFile>(
+      static_cast<const uint8_t *>(data), size, private_tag{});
+}
+
+MappedFile::MappedFile(const uint8_t *data, size_t size, private_tag)
+    : data_(data), size_(size) {}
+
+MappedFile::~MappedFile() {
+  ::munmap(const_cast<uint8_t *>(data_), size_);
+}
+
+const uint8_t *MappedFile::data() const {
+  return data_;
+}
+
+size_t MappedFile::size() const {
+  return size_;
+}
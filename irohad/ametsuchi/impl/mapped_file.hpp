@@ -0,0 +1,55 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_MAPPED_FILE_HPP
+#define IROHA_MAPPED_FILE_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include <boost/optional.hpp>
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Read-only shared memory mapping of a file region starting at offset 0.
+     * The mapping is released when the object is destroyed, it does not
+     * depend on the file descriptor it was created from, and stays valid
+     * after the file is closed or removed.
+     */
+    class MappedFile {
+      struct private_tag {};
+
+     public:
+      /**
+       * Map the first size bytes of the file
+       * @param fd - descriptor of a file opened for reading
+       * @param size - length of the mapping, may exceed the current file
+       * size, but only the bytes present in the file may be accessed
+       * @return mapping or none if mmap fails or size is zero
+       */
+      static boost::optional<std::shared_ptr<const MappedFile>> map(
+          int fd, size_t size);
+
+      MappedFile(const uint8_t *data, size_t size, private_tag);
+
+      MappedFile(const MappedFile &) = delete;
+      MappedFile &operator=(const MappedFile &) = delete;
+
+      ~MappedFile();
+
+      const uint8_t *data() const;
+
+      size_t size() const;
+
+     private:
+      const uint8_t *data_;
+      size_t size_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_MAPPED_FILE_HPP
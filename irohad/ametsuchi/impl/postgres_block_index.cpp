@@ -6,6 +6,7 @@
 #include "ametsuchi/impl/postgres_block_index.hpp"
 
 #include <boost/range/adaptor/indexed.hpp>
+#include <boost/range/size.hpp>
 
 #include "ametsuchi/tx_cache_response.hpp"
 #include "common/visitor.hpp"
@@ -14,6 +15,8 @@
 #include "interfaces/iroha_internal/block.hpp"
 
 namespace {
+  using iroha::ametsuchi::makeArray;
+
   // Return transfer asset if command contains it
   boost::optional<const shared_model::interface::TransferAsset &>
   getTransferAsset(const shared_model::interface::Command &cmd) noexcept {
@@ -27,93 +30,97 @@ namespace {
         [](const auto &) -> ReturnType { return boost::none; });
   }
 
-  // make index tx hash -> block where hash is stored
-  std::string makeHashIndex(
-      const shared_model::interface::types::HashType &hash,
-      shared_model::interface::types::HeightType height,
-      size_t index) {
-    boost::format base(
-        "INSERT INTO position_by_hash(hash, height, index) VALUES ('%s', "
-        "'%s', '%s');");
-    return (base % hash.hex() % height % index).str();
-  }
-
-  std::string makeCommittedTxHashIndex(
-      const shared_model::interface::types::HashType &rejected_tx_hash) {
-    boost::format base(
-        "INSERT INTO tx_status_by_hash(hash, status) VALUES ('%s', "
-        "TRUE);");
-    return (base % rejected_tx_hash.hex()).str();
-  }
-
-  std::string makeRejectedTxHashIndex(
-      const shared_model::interface::types::HashType &rejected_tx_hash) {
-    boost::format base(
-        "INSERT INTO tx_status_by_hash(hash, status) VALUES ('%s', "
-        "FALSE);");
-    return (base % rejected_tx_hash.hex()).str();
-  }
-
-  // make index account_id:height -> list of tx indexes
-  // (where tx is placed in the block)
-  std::string makeCreatorHeightIndex(
-      const shared_model::interface::types::AccountIdType creator,
-      shared_model::interface::types::HeightType height,
-      size_t tx_index) {
-    boost::format base(
-        "INSERT INTO index_by_creator_height(creator_id, height, index) VALUES "
-        "('%s', '%s', '%s');");
-    return (base % creator % height % tx_index).str();
-  }
-
-  // Make index account_id -> list of blocks where his txs exist
-  std::string makeAccountHeightIndex(
-      const shared_model::interface::types::AccountIdType &account_id,
-      shared_model::interface::types::HeightType height) {
-    boost::format base(
-        "INSERT INTO height_by_account_set(account_id, "
-        "height) VALUES "
-        "('%s', '%s');");
-    return (base % account_id % height).str();
-  }
+  using Column = std::vector<std::string>;
+
+  /**
+   * Rows of the index tables collected for a block, stored by columns.
+   * Height is the same for all rows and is not stored
+   */
+  struct IndexRows {
+    // tx hash -> position in the block (position_by_hash), and
+    // account_id:height -> list of tx indexes (index_by_creator_height)
+    Column tx_hashes;
+    Column tx_creators;
+    Column tx_indexes;
+
+    // tx hash -> committed or rejected (tx_status_by_hash)
+    Column status_hashes;
+    Column statuses;
+
+    // account_id -> list of blocks where its txs exist (height_by_account_set)
+    Column accounts;
+
+    // account_id:height:asset_id -> list of tx indexes
+    // (position_by_account_asset)
+    Column asset_accounts;
+    Column asset_ids;
+    Column asset_indexes;
+  };
 
   // Collect all assets belonging to creator, sender, and receiver
   // to make account_id:height:asset_id -> list of tx indexes
   // for transfer asset in command
-  std::string makeAccountAssetIndex(
+  void addAccountAssetIndex(
+      IndexRows &rows,
       const shared_model::interface::types::AccountIdType &account_id,
-      shared_model::interface::types::HeightType height,
-      size_t index,
+      const std::string &index,
       const shared_model::interface::Transaction::CommandsType &commands) {
-    return std::accumulate(
-        commands.begin(),
-        commands.end(),
-        std::string{},
-        [&](auto query, const auto &cmd) {
-          auto transfer = getTransferAsset(cmd);
-          if (not transfer) {
-            return query;
-          }
-          const auto &src_id = transfer.value().srcAccountId();
-          const auto &dest_id = transfer.value().destAccountId();
-
-          query += makeAccountHeightIndex(src_id, height);
-          query += makeAccountHeightIndex(dest_id, height);
-
-          const auto ids = {account_id, src_id, dest_id};
-          const auto &asset_id = transfer.value().assetId();
-          // flat map accounts to unindexed keys
-          for (const auto &id : ids) {
-            boost::format base(
-                "INSERT INTO position_by_account_asset(account_id, "
-                "height, asset_id, "
-                "index) "
-                "VALUES ('%s', '%s', '%s', '%s');");
-            query += (base % id % height % asset_id % index).str();
-          }
-          return query;
-        });
+    for (const auto &cmd : commands) {
+      auto transfer = getTransferAsset(cmd);
+      if (not transfer) {
+        continue;
+      }
+      const auto &src_id = transfer.value().srcAccountId();
+      const auto &dest_id = transfer.value().destAccountId();
+
+      rows.accounts.push_back(src_id);
+      rows.accounts.push_back(dest_id);
+
+      const auto ids = {account_id, src_id, dest_id};
+      const auto &asset_id = transfer.value().assetId();
+      // flat map accounts to unindexed keys
+      for (const auto &id : ids) {
+        rows.asset_accounts.push_back(id);
+        rows.asset_ids.push_back(asset_id);
+        rows.asset_indexes.push_back(index);
+      }
+    }
   }
+
+  const std::string kInsertPositionByHash = R"(
+      INSERT INTO position_by_hash(hash, height, index)
+      SELECT decode(hash, 'hex'), CAST(:height AS bigint), index
+      FROM unnest(CAST(:hashes AS text[]), CAST(:indexes AS bigint[]))
+          AS t(hash, index))";
+
+  const std::string kInsertTxStatusByHash = R"(
+      INSERT INTO tx_status_by_hash(hash, status, height)
+      SELECT decode(hash, 'hex'), status, CAST(:height AS bigint)
+      FROM unnest(CAST(:hashes AS text[]), CAST(:statuses AS boolean[]))
+          AS t(hash, status))";
+
+  const std::string kInsertIndexByCreatorHeight = R"(
+      INSERT INTO index_by_creator_height(creator_id, height, index)
+      SELECT creator_id, CAST(:height AS bigint), index
+      FROM unnest(CAST(:creators AS text[]), CAST(:indexes AS bigint[]))
+          AS t(creator_id, index))";
+
+  const std::string kInsertHeightByAccountSet = R"(
+      INSERT INTO height_by_account_set(account_id, height)
+      SELECT account_id, CAST(:height AS bigint)
+      FROM unnest(CAST(:accounts AS text[])) AS t(account_id))";
+
+  const std::string kInsertHeightByBlockHash = R"(
+      INSERT INTO height_by_block_hash(hash, height)
+      VALUES (decode(:hash, 'hex'), CAST(:height AS bigint)))";
+
+  const std::string kInsertPositionByAccountAsset = R"(
+      INSERT INTO position_by_account_asset(account_id, height, asset_id, index)
+      SELECT account_id, CAST(:height AS bigint), asset_id, index
+      FROM unnest(CAST(:accounts AS text[]),
+                  CAST(:assets AS text[]),
+                  CAST(:indexes AS bigint[]))
+          AS t(account_id, asset_id, index))";
 }  // namespace
 
 namespace iroha {
@@ -124,38 +131,66 @@ namespace iroha {
 
     void PostgresBlockIndex::index(
         const shared_model::interface::Block &block) {
-      auto height = block.height();
-      auto indexed_txs = block.transactions() | boost::adaptors::indexed(0);
-      auto rejected_txs_hashes = block.rejected_transactions_hashes();
-      std::string tx_index_query = std::accumulate(
-          indexed_txs.begin(),
-          indexed_txs.end(),
-          std::string{},
-          [height](auto query, const auto &tx) {
-            const auto &creator_id = tx.value().creatorAccountId();
-            const auto index = tx.index();
-
-            query += makeAccountHeightIndex(creator_id, height);
-            query += makeAccountAssetIndex(
-                creator_id, height, index, tx.value().commands());
-            query += makeHashIndex(tx.value().hash(), height, index);
-            query += makeCommittedTxHashIndex(tx.value().hash());
-            query += makeCreatorHeightIndex(creator_id, height, index);
-            return query;
-          });
-
-      std::string rejected_tx_index_query =
-          std::accumulate(rejected_txs_hashes.begin(),
-                          rejected_txs_hashes.end(),
-                          std::string{},
-                          [](auto query, const auto &rejected_tx_hash) {
-                            query += makeRejectedTxHashIndex(rejected_tx_hash);
-                            return query;
-                          });
-
-      auto index_query = tx_index_query + rejected_tx_index_query;
+      const auto height = std::to_string(block.height());
+      const auto &transactions = block.transactions();
+      const auto &rejected_txs_hashes = block.rejected_transactions_hashes();
+
+      IndexRows rows;
+      rows.tx_hashes.reserve(boost::size(transactions));
+      rows.tx_creators.reserve(boost::size(transactions));
+      rows.tx_indexes.reserve(boost::size(transactions));
+      for (const auto &tx : transactions | boost::adaptors::indexed(0)) {
+        const auto &creator_id = tx.value().creatorAccountId();
+        const auto index = std::to_string(tx.index());
+        const auto hash = tx.value().hash().hex();
+
+        rows.accounts.push_back(creator_id);
+        addAccountAssetIndex(rows, creator_id, index, tx.value().commands());
+        rows.tx_hashes.push_back(hash);
+        rows.tx_creators.push_back(creator_id);
+        rows.tx_indexes.push_back(index);
+        rows.status_hashes.push_back(hash);
+        rows.statuses.push_back("t");
+      }
+      for (const auto &rejected_tx_hash : rejected_txs_hashes) {
+        rows.status_hashes.push_back(rejected_tx_hash.hex());
+        rows.statuses.push_back("f");
+      }
+
+      // each index table is filled with a single statement, which gets its
+      // rows as array parameters instead of values embedded into the query
       try {
-        sql_ << index_query;
+        const auto &block_hash = block.hash().hex();
+        sql_ << kInsertHeightByBlockHash, soci::use(block_hash, "hash"),
+            soci::use(height, "height");
+        if (not rows.tx_hashes.empty()) {
+          const auto hashes = makeArray(rows.tx_hashes);
+          const auto creators = makeArray(rows.tx_creators);
+          const auto indexes = makeArray(rows.tx_indexes);
+          sql_ << kInsertPositionByHash, soci::use(height, "height"),
+              soci::use(hashes, "hashes"), soci::use(indexes, "indexes");
+          sql_ << kInsertIndexByCreatorHeight, soci::use(height, "height"),
+              soci::use(creators, "creators"), soci::use(indexes, "indexes");
+        }
+        if (not rows.status_hashes.empty()) {
+          const auto hashes = makeArray(rows.status_hashes);
+          const auto statuses = makeArray(rows.statuses);
+          sql_ << kInsertTxStatusByHash, soci::use(height, "height"),
+              soci::use(hashes, "hashes"), soci::use(statuses, "statuses");
+        }
+        if (not rows.accounts.empty()) {
+          const auto accounts = makeArray(rows.accounts);
+          sql_ << kInsertHeightByAccountSet, soci::use(height, "height"),
+              soci::use(accounts, "accounts");
+        }
+        if (not rows.asset_accounts.empty()) {
+          const auto accounts = makeArray(rows.asset_accounts);
+          const auto assets = makeArray(rows.asset_ids);
+          const auto indexes = makeArray(rows.asset_indexes);
+          sql_ << kInsertPositionByAccountAsset, soci::use(height, "height"),
+              soci::use(accounts, "accounts"), soci::use(assets, "assets"),
+              soci::use(indexes, "indexes");
+        }
       } catch (const std::exception &e) {
         log_->error(e.what());
       }
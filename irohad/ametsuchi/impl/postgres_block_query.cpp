@@ -5,6 +5,8 @@
 
 #include "ametsuchi/impl/postgres_block_query.hpp"
 
+#include <unordered_map>
+
 #include <boost/format.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/for_each.hpp>
@@ -14,6 +16,8 @@
 
 namespace iroha {
   namespace ametsuchi {
+    constexpr size_t PostgresBlockQuery::kTxHashPageSize;
+
     PostgresBlockQuery::PostgresBlockQuery(
         soci::session &sql,
         KeyValueStorage &file_store,
@@ -71,13 +75,33 @@ namespace iroha {
       return getBlocks(last_id - count + 1, count);
     }
 
+    boost::optional<shared_model::interface::types::HeightType>
+    PostgresBlockQuery::getBlockHeight(const shared_model::crypto::Hash &hash) {
+      // heights start from 1, so 0 stays when the hash is not found
+      long long height = 0;
+      const auto &hash_str = hash.hex();
+      try {
+        sql_ << "SELECT height FROM height_by_block_hash "
+                "WHERE hash = decode(:hash, 'hex')",
+            soci::into(height), soci::use(hash_str);
+      } catch (const std::exception &e) {
+        log_->error("Failed to execute query: {}", e.what());
+        return boost::none;
+      }
+      if (height == 0) {
+        return boost::none;
+      }
+      return static_cast<shared_model::interface::types::HeightType>(height);
+    }
+
     boost::optional<TxCacheStatusType> PostgresBlockQuery::checkTxPresence(
         const shared_model::crypto::Hash &hash) {
       int res = -1;
       const auto &hash_str = hash.hex();
 
       try {
-        sql_ << "SELECT status FROM tx_status_by_hash WHERE hash = :hash",
+        sql_ << "SELECT status FROM tx_status_by_hash "
+                "WHERE hash = decode(:hash, 'hex')",
             soci::into(res), soci::use(hash_str);
       } catch (const std::exception &e) {
         log_->error("Failed to execute query: {}", e.what());
@@ -98,6 +122,89 @@ namespace iroha {
           tx_cache_status_responses::Missing{hash});
     }
 
+    boost::optional<std::vector<TxCacheStatusType>>
+    PostgresBlockQuery::checkTxsPresence(
+        const std::vector<shared_model::crypto::Hash> &hashes) {
+      std::vector<TxCacheStatusType> result;
+      if (hashes.empty()) {
+        return result;
+      }
+
+      // hex strings need no escaping in an array literal
+      std::string hashes_array = "{";
+      for (const auto &hash : hashes) {
+        if (hashes_array.size() > 1) {
+          hashes_array += ',';
+        }
+        hashes_array += hash.hex();
+      }
+      hashes_array += '}';
+
+      // hashes are unique in the table, so there are at most as many rows
+      // as requested hashes
+      std::vector<std::string> found_hashes(hashes.size());
+      std::vector<int> statuses(hashes.size());
+      try {
+        sql_ << "SELECT encode(hash, 'hex'), CAST(status AS int) "
+                "FROM tx_status_by_hash WHERE hash = ANY("
+                "SELECT decode(h, 'hex') FROM unnest(CAST(:hashes AS text[])) "
+                "AS t(h))",
+            soci::into(found_hashes), soci::into(statuses),
+            soci::use(hashes_array, "hashes");
+      } catch (const std::exception &e) {
+        log_->error("Failed to execute query: {}", e.what());
+        return boost::none;
+      }
+
+      std::unordered_map<std::string, int> status_by_hash;
+      for (size_t i = 0; i < found_hashes.size(); ++i) {
+        status_by_hash.emplace(found_hashes[i], statuses[i]);
+      }
+      result.reserve(hashes.size());
+      for (const auto &hash : hashes) {
+        auto it = status_by_hash.find(hash.hex());
+        if (it == status_by_hash.end()) {
+          result.emplace_back(tx_cache_status_responses::Missing{hash});
+        } else if (it->second > 0) {
+          result.emplace_back(tx_cache_status_responses::Committed{hash});
+        } else {
+          result.emplace_back(tx_cache_status_responses::Rejected{hash});
+        }
+      }
+      return result;
+    }
+
+    boost::optional<size_t> PostgresBlockQuery::forEachTxHash(
+        const std::function<void(const shared_model::crypto::Hash &)>
+            &visitor) {
+      size_t count = 0;
+      // hashes are read in pages ordered by the indexed hash column, so the
+      // whole table is never loaded into memory at once
+      std::string last_hash;
+      const int limit = kTxHashPageSize;
+      try {
+        std::vector<std::string> page(kTxHashPageSize);
+        do {
+          page.resize(kTxHashPageSize);
+          sql_ << "SELECT encode(hash, 'hex') FROM tx_status_by_hash "
+                  "WHERE hash > decode(:last_hash, 'hex') "
+                  "ORDER BY hash LIMIT :limit",
+              soci::into(page), soci::use(last_hash), soci::use(limit);
+          for (const auto &hash : page) {
+            visitor(shared_model::crypto::Hash::fromHexString(hash));
+          }
+          count += page.size();
+          if (not page.empty()) {
+            last_hash = page.back();
+          }
+        } while (page.size() == kTxHashPageSize);
+      } catch (const std::exception &e) {
+        log_->error("Failed to execute query: {}", e.what());
+        return boost::none;
+      }
+      return count;
+    }
+
     uint32_t PostgresBlockQuery::getTopBlockHeight() {
       return block_store_.last_id();
     }
@@ -122,12 +229,16 @@ namespace iroha {
                      std::string>
     PostgresBlockQuery::getBlock(
         shared_model::interface::types::HeightType id) const {
-      auto serialized_block = block_store_.get(id);
+      // block is parsed directly from the storage memory, without copying
+      // it to an intermediate buffer
+      auto serialized_block = block_store_.getView(id);
       if (not serialized_block) {
         auto error = boost::format("Failed to retrieve block with id %d") % id;
         return expected::makeError(error.str());
       }
-      return converter_->deserialize(bytesToString(*serialized_block));
+      return converter_->deserializeFromArray(
+          reinterpret_cast<const char *>(serialized_block->data),
+          serialized_block->size);
     }
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -47,14 +47,27 @@ namespace iroha {
 
       std::vector<wBlock> getTopBlocks(uint32_t count) override;
 
+      boost::optional<shared_model::interface::types::HeightType>
+      getBlockHeight(const shared_model::crypto::Hash &hash) override;
+
       uint32_t getTopBlockHeight() override;
 
       boost::optional<TxCacheStatusType> checkTxPresence(
           const shared_model::crypto::Hash &hash) override;
 
+      boost::optional<std::vector<TxCacheStatusType>> checkTxsPresence(
+          const std::vector<shared_model::crypto::Hash> &hashes) override;
+
+      boost::optional<size_t> forEachTxHash(
+          const std::function<void(const shared_model::crypto::Hash &)>
+              &visitor) override;
+
       expected::Result<wBlock, std::string> getTopBlock() override;
 
      private:
+      /// Number of hashes read from the database at once by forEachTxHash
+      static constexpr size_t kTxHashPageSize = 100000;
+
       /**
        * Retrieve block with given id block storage
        * @param id - height of a block to retrieve
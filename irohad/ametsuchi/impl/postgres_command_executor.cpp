@@ -5,6 +5,8 @@
 
 #include "ametsuchi/impl/postgres_command_executor.hpp"
 
+#include <cstdlib>
+
 #include <soci/postgresql/soci-postgresql.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
@@ -197,12 +199,15 @@ namespace {
   }
 
   /**
-   * Executes sql query
+   * Executes a prepared statement with arguments bound as parameters of the
+   * statement, so that they are neither escaped nor parsed as a part of the
+   * query text
    * Assumes that statement query returns 0 in case of success
    * or error code in case of failure
    * @tparam QueryArgsCallable - type of callable to get query arguments
    * @param sql - connection on which to execute statement
-   * @param cmd - sql query to be executed
+   * @param statement_name - name of the prepared statement to be executed
+   * @param arguments - text representations of the statement parameters
    * @param command_name - which command executes a query
    * @param query_args - callable to get a string representation of query
    * arguments
@@ -211,15 +216,42 @@ namespace {
   template <typename QueryArgsCallable>
   iroha::ametsuchi::CommandResult executeQuery(
       soci::session &sql,
-      const std::string &cmd,
+      const std::string &statement_name,
+      const std::vector<std::string> &arguments,
       std::string command_name,
       QueryArgsCallable &&query_args) noexcept {
-    uint32_t result;
     try {
-      sql << cmd, soci::into(result);
-      if (result != 0) {
+      std::vector<const char *> values;
+      values.reserve(arguments.size());
+      for (const auto &argument : arguments) {
+        values.push_back(argument.c_str());
+      }
+
+      auto connection =
+          static_cast<soci::postgresql_session_backend *>(sql.get_backend())
+              ->conn_;
+      std::unique_ptr<PGresult, decltype(&PQclear)> result(
+          PQexecPrepared(connection,
+                         statement_name.c_str(),
+                         static_cast<int>(values.size()),
+                         values.data(),
+                         nullptr,
+                         nullptr,
+                         0),
+          &PQclear);
+      if (PQresultStatus(result.get()) != PGRES_TUPLES_OK
+          or PQntuples(result.get()) != 1) {
+        return getCommandError(std::move(command_name),
+                               result ? PQresultErrorMessage(result.get())
+                                      : PQerrorMessage(connection),
+                               std::forward<QueryArgsCallable>(query_args));
+      }
+
+      auto code = static_cast<iroha::ametsuchi::CommandError::ErrorCodeType>(
+          std::strtoul(PQgetvalue(result.get(), 0, 0), nullptr, 10));
+      if (code != 0) {
         return makeCommandError(std::move(command_name),
-                                result,
+                                code,
                                 std::forward<QueryArgsCallable>(query_args));
       }
       return {};
@@ -313,14 +345,13 @@ namespace {
         .str();
   }
 
-  template <typename Format>
-  void appendCommandName(const std::string &name,
-                         Format &cmd,
-                         bool do_validation) {
-    auto command_name = name
+  /**
+   * @return name of the prepared statement of the command
+   */
+  std::string commandName(const std::string &name, bool do_validation) {
+    return name
         + (do_validation ? PreparedStatement::validationPrefix
                          : PreparedStatement::noValidationPrefix);
-    cmd % command_name;
   }
 
   /**
@@ -814,13 +845,6 @@ namespace iroha {
       auto amount = command.amount().toStringRepr();
       int precision = command.amount().precision();
 
-      // 14.09.2018 nickaleks: IR-1707 move common logic to separate function
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%, '%5%')");
-
-      appendCommandName("addAssetQuantity", cmd, do_validation_);
-
-      cmd = (cmd % account_id % asset_id % precision % amount);
-
       auto str_args = [&account_id, &asset_id, &amount, precision] {
         return getQueryArgsStringBuilder()
             .append("account_id", account_id)
@@ -830,39 +854,39 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "AddAssetQuantity", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("addAssetQuantity", do_validation_),
+                          {account_id,
+                           asset_id,
+                           std::to_string(precision),
+                           amount},
+                          "AddAssetQuantity",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AddPeer &command) {
       auto &peer = command.peer();
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("addPeer", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % peer.pubkey().hex() % peer.address());
-
       auto str_args = [&peer] {
         return getQueryArgsStringBuilder()
             .append("peer", peer.toString())
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AddPeer", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("addPeer", do_validation_),
+                          {creator_account_id_,
+                           peer.pubkey().hex(),
+                           peer.address()},
+                          "AddPeer",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AddSignatory &command) {
       auto &account_id = command.accountId();
       auto pubkey = command.pubkey().hex();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("addSignatory", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % pubkey);
-
       auto str_args = [&account_id, &pubkey] {
         return getQueryArgsStringBuilder()
             .append("account_id", account_id)
@@ -870,19 +894,17 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AddSignatory", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("addSignatory", do_validation_),
+                          {creator_account_id_, account_id, pubkey},
+                          "AddSignatory",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::AppendRole &command) {
       auto &account_id = command.accountId();
       auto &role_name = command.roleName();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("appendRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % role_name);
-
       auto str_args = [&account_id, &role_name] {
         return getQueryArgsStringBuilder()
             .append("account_id", account_id)
@@ -890,7 +912,11 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "AppendRole", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("appendRole", do_validation_),
+                          {creator_account_id_, account_id, role_name},
+                          "AppendRole",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -901,12 +927,6 @@ namespace iroha {
       shared_model::interface::types::AccountIdType account_id =
           account_name + "@" + domain_id;
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("createAccount", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % domain_id % pubkey);
-
       auto str_args = [&account_id, &domain_id, &pubkey] {
         return getQueryArgsStringBuilder()
             .append("account_id", account_id)
@@ -915,8 +935,11 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "CreateAccount", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("createAccount", do_validation_),
+                          {creator_account_id_, account_id, domain_id, pubkey},
+                          "CreateAccount",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -924,12 +947,6 @@ namespace iroha {
       auto &domain_id = command.domainId();
       auto asset_id = command.assetName() + "#" + domain_id;
       int precision = command.precision();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', %5%)");
-
-      appendCommandName("createAsset", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % asset_id % domain_id % precision);
-
       auto str_args = [&domain_id, &asset_id, precision] {
         return getQueryArgsStringBuilder()
             .append("domain_id", domain_id)
@@ -938,19 +955,20 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateAsset", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("createAsset", do_validation_),
+                          {creator_account_id_,
+                           asset_id,
+                           domain_id,
+                           std::to_string(precision)},
+                          "CreateAsset",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::CreateDomain &command) {
       auto &domain_id = command.domainId();
       auto &default_role = command.userDefaultRole();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("createDomain", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % domain_id % default_role);
-
       auto str_args = [&domain_id, &default_role] {
         return getQueryArgsStringBuilder()
             .append("domain_id", domain_id)
@@ -958,7 +976,11 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateDomain", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("createDomain", do_validation_),
+                          {creator_account_id_, domain_id, default_role},
+                          "CreateDomain",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -966,12 +988,6 @@ namespace iroha {
       auto &role_id = command.roleName();
       auto &permissions = command.rolePermissions();
       auto perm_str = permissions.toBitstring();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("createRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % role_id % perm_str);
-
       auto str_args = [&role_id, &perm_str] {
         // TODO [IR-1889] Akvinikym 21.11.18: integrate
         // PermissionSet::toString() instead of bit string, when it is created
@@ -981,19 +997,17 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "CreateRole", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("createRole", do_validation_),
+                          {creator_account_id_, role_id, perm_str},
+                          "CreateRole",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::DetachRole &command) {
       auto &account_id = command.accountId();
       auto &role_name = command.roleName();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("detachRole", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % role_name);
-
       auto str_args = [&account_id, &role_name] {
         return getQueryArgsStringBuilder()
             .append("account_id", account_id)
@@ -1001,7 +1015,11 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "DetachRole", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("detachRole", do_validation_),
+                          {creator_account_id_, account_id, role_name},
+                          "DetachRole",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1015,13 +1033,6 @@ namespace iroha {
       const auto perm_str =
           shared_model::interface::GrantablePermissionSet({permission})
               .toBitstring();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("grantPermission", cmd, do_validation_);
-
-      cmd =
-          (cmd % creator_account_id_ % permittee_account_id % perm_str % perm);
-
       auto str_args = [&creator_account_id = creator_account_id_,
                        &permittee_account_id,
                        permission = perm_converter_->toString(permission)] {
@@ -1032,20 +1043,20 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "GrantPermission", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("grantPermission", do_validation_),
+                          {creator_account_id_,
+                           permittee_account_id,
+                           perm_str,
+                           perm},
+                          "GrantPermission",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::RemoveSignatory &command) {
       auto &account_id = command.accountId();
       auto &pubkey = command.pubkey().hex();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%')");
-
-      appendCommandName("removeSignatory", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % pubkey);
-
       auto str_args = [&account_id, &pubkey] {
         return getQueryArgsStringBuilder()
             .append("account_id", account_id)
@@ -1053,8 +1064,11 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "RemoveSignatory", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("removeSignatory", do_validation_),
+                          {creator_account_id_, account_id, pubkey},
+                          "RemoveSignatory",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1070,13 +1084,6 @@ namespace iroha {
                              .set(permission)
                              .toBitstring();
 
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%')");
-
-      appendCommandName("revokePermission", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % permittee_account_id % perms
-             % without_perm_str);
-
       auto str_args = [&creator_account_id = creator_account_id_,
                        &permittee_account_id,
                        permission = perm_converter_->toString(permission)] {
@@ -1087,8 +1094,14 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "RevokePermission", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("revokePermission", do_validation_),
+                          {creator_account_id_,
+                           permittee_account_id,
+                           perms,
+                           without_perm_str},
+                          "RevokePermission",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1105,14 +1118,6 @@ namespace iroha {
       std::string filled_json = "{" + creator_account_id_ + ", " + key + "}";
       std::string val = "\"" + value + "\"";
 
-      auto cmd = boost::format(
-          "EXECUTE %1% ('%2%', '%3%', '%4%', '%5%', '%6%', '%7%')");
-
-      appendCommandName("setAccountDetail", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % json % filled_json % val
-             % empty_json);
-
       auto str_args = [&account_id, &key, &value] {
         return getQueryArgsStringBuilder()
             .append("account_id", account_id)
@@ -1121,20 +1126,22 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "SetAccountDetail", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("setAccountDetail", do_validation_),
+                          {creator_account_id_,
+                           account_id,
+                           json,
+                           filled_json,
+                           val,
+                           empty_json},
+                          "SetAccountDetail",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
         const shared_model::interface::SetQuorum &command) {
       auto &account_id = command.accountId();
       int quorum = command.newQuorum();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%)");
-
-      appendCommandName("setQuorum", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % account_id % quorum);
-
       auto str_args = [&account_id, quorum] {
         return getQueryArgsStringBuilder()
             .append("account_id", account_id)
@@ -1142,7 +1149,13 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(sql_, cmd.str(), "SetQuorum", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("setQuorum", do_validation_),
+                          {creator_account_id_,
+                           account_id,
+                           std::to_string(quorum)},
+                          "SetQuorum",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1150,12 +1163,6 @@ namespace iroha {
       auto &asset_id = command.assetId();
       auto amount = command.amount().toStringRepr();
       uint32_t precision = command.amount().precision();
-      auto cmd = boost::format("EXECUTE %1% ('%2%', '%3%', %4%, '%5%')");
-
-      appendCommandName("subtractAssetQuantity", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % asset_id % precision % amount);
-
       auto str_args = [&creator_account_id = creator_account_id_,
                        &asset_id,
                        &amount,
@@ -1168,8 +1175,14 @@ namespace iroha {
             .finalize();
       };
 
-      return executeQuery(
-          sql_, cmd.str(), "SubtractAssetQuantity", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("subtractAssetQuantity", do_validation_),
+                          {creator_account_id_,
+                           asset_id,
+                           std::to_string(precision),
+                           amount},
+                          "SubtractAssetQuantity",
+                          std::move(str_args));
     }
 
     CommandResult PostgresCommandExecutor::operator()(
@@ -1179,14 +1192,6 @@ namespace iroha {
       auto &asset_id = command.assetId();
       auto amount = command.amount().toStringRepr();
       uint32_t precision = command.amount().precision();
-      auto cmd =
-          boost::format("EXECUTE %1% ('%2%', '%3%', '%4%', '%5%', %6%, '%7%')");
-
-      appendCommandName("transferAsset", cmd, do_validation_);
-
-      cmd = (cmd % creator_account_id_ % src_account_id % dest_account_id
-             % asset_id % precision % amount);
-
       auto str_args =
           [&src_account_id, &dest_account_id, &asset_id, &amount, precision] {
             return getQueryArgsStringBuilder()
@@ -1198,8 +1203,16 @@ namespace iroha {
                 .finalize();
           };
 
-      return executeQuery(
-          sql_, cmd.str(), "TransferAsset", std::move(str_args));
+      return executeQuery(sql_,
+                          commandName("transferAsset", do_validation_),
+                          {creator_account_id_,
+                           src_account_id,
+                           dest_account_id,
+                           asset_id,
+                           std::to_string(precision),
+                           amount},
+                          "TransferAsset",
+                          std::move(str_args));
     }
 
     void PostgresCommandExecutor::prepareStatements(soci::session &sql) {
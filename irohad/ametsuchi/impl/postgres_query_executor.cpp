@@ -155,13 +155,14 @@ namespace iroha {
                                                            RangeGen &&range_gen,
                                                            Pred &&pred) {
       std::vector<std::unique_ptr<shared_model::interface::Transaction>> result;
-      auto serialized_block = block_store_.get(block_id);
+      auto serialized_block = block_store_.getView(block_id);
       if (not serialized_block) {
         log_->error("Failed to retrieve block with id {}", block_id);
         return result;
       }
-      auto deserialized_block =
-          converter_->deserialize(bytesToString(*serialized_block));
+      auto deserialized_block = converter_->deserializeFromArray(
+          reinterpret_cast<const char *>(serialized_block->data),
+          serialized_block->size);
       // boost::get of pointer returns pointer to requested type, or nullptr
       if (auto e =
               boost::get<expected::Error<std::string>>(&deserialized_block)) {
@@ -383,7 +384,7 @@ namespace iroha {
 
       // select tx with specified hash
       auto first_by_hash = R"(SELECT height, index FROM position_by_hash
-      WHERE hash = :hash LIMIT 1)";
+      WHERE hash = decode(:hash, 'hex') LIMIT 1)";
 
       // select first ever tx
       auto first_tx = R"(SELECT height, index FROM position_by_hash
@@ -620,7 +621,9 @@ namespace iroha {
 
     QueryExecutorResult PostgresQueryExecutorVisitor::operator()(
         const shared_model::interface::GetTransactions &q) {
-      auto escape = [](auto &hash) { return "'" + hash.hex() + "'"; };
+      auto escape = [](auto &hash) {
+        return "decode('" + hash.hex() + "', 'hex')";
+      };
       std::string hash_str = std::accumulate(
           std::next(q.transactionHashes().begin()),
           q.transactionHashes().end(),
@@ -634,7 +637,8 @@ namespace iroha {
       auto cmd = (boost::format(R"(WITH has_my_perm AS (%s),
       has_all_perm AS (%s),
       t AS (
-          SELECT height, hash FROM position_by_hash WHERE hash IN (%s)
+          SELECT height, encode(hash, 'hex') AS hash FROM position_by_hash
+          WHERE hash IN (%s)
       )
       SELECT height, hash, has_my_perm.perm, has_all_perm.perm FROM t
       RIGHT OUTER JOIN has_my_perm ON TRUE
@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/postgres_schema_migration.hpp"
+
+#include <vector>
+
+namespace {
+  /**
+   * Upgrade steps, element i converts schema of version i + 1 to version
+   * i + 2. Indexes are created afterwards by StorageImpl::init_
+   */
+  const std::vector<std::string> kUpgrades = {
+      R"(
+ALTER TABLE position_by_hash
+    ALTER COLUMN hash TYPE bytea USING decode(hash, 'hex'),
+    ALTER COLUMN hash SET NOT NULL,
+    ALTER COLUMN height TYPE bigint USING CAST(height AS bigint),
+    ALTER COLUMN index TYPE bigint USING CAST(index AS bigint),
+    ADD PRIMARY KEY (height, index);
+ALTER TABLE tx_status_by_hash
+    ALTER COLUMN hash TYPE bytea USING decode(hash, 'hex'),
+    ALTER COLUMN hash SET NOT NULL,
+    ALTER COLUMN status SET NOT NULL;
+ALTER TABLE height_by_account_set
+    ALTER COLUMN account_id SET NOT NULL,
+    ALTER COLUMN height TYPE bigint USING CAST(height AS bigint),
+    ALTER COLUMN height SET NOT NULL;
+ALTER TABLE index_by_creator_height
+    ALTER COLUMN creator_id SET NOT NULL,
+    ALTER COLUMN height TYPE bigint USING CAST(height AS bigint),
+    ALTER COLUMN height SET NOT NULL,
+    ALTER COLUMN index TYPE bigint USING CAST(index AS bigint),
+    ALTER COLUMN index SET NOT NULL,
+    ADD PRIMARY KEY (id);
+ALTER TABLE position_by_account_asset
+    ALTER COLUMN account_id SET NOT NULL,
+    ALTER COLUMN asset_id SET NOT NULL,
+    ALTER COLUMN height TYPE bigint USING CAST(height AS bigint),
+    ALTER COLUMN height SET NOT NULL,
+    ALTER COLUMN index TYPE bigint USING CAST(index AS bigint),
+    ALTER COLUMN index SET NOT NULL;
+)",
+      // blocks stored before this version are indexed by StorageImpl
+      R"(
+CREATE TABLE IF NOT EXISTS height_by_block_hash (
+    hash bytea NOT NULL,
+    height bigint NOT NULL,
+    PRIMARY KEY (hash)
+);
+)",
+      // statuses indexed before this version have no height
+      R"(
+ALTER TABLE tx_status_by_hash ADD COLUMN IF NOT EXISTS height bigint;
+)"};
+
+  bool tableExists(soci::session &sql, const std::string &table) {
+    int count = 0;
+    sql << "SELECT count(*) FROM information_schema.tables "
+           "WHERE table_schema = current_schema() AND table_name = :name",
+        soci::into(count), soci::use(table);
+    return count > 0;
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    int getSchemaVersion(soci::session &sql) {
+      if (tableExists(sql, "schema_version")) {
+        int version = 0;
+        sql << "SELECT version FROM schema_version", soci::into(version);
+        return version;
+      }
+      return tableExists(sql, "position_by_hash") ? 1 : 0;
+    }
+
+    expected::Result<void, std::string> migrateSchema(soci::session &sql,
+                                                      logger::Logger log) {
+      try {
+        auto version = getSchemaVersion(sql);
+        if (version == 0 or version == kSchemaVersion) {
+          return expected::Value<void>();
+        }
+        if (version > kSchemaVersion) {
+          return expected::makeError(
+              "Database schema version " + std::to_string(version)
+              + " is newer than supported version "
+              + std::to_string(kSchemaVersion));
+        }
+
+        for (; version < kSchemaVersion; ++version) {
+          log->info("Upgrading database schema from version {} to {}",
+                    version,
+                    version + 1);
+          soci::transaction tr(sql);
+          sql << kUpgrades.at(version - 1);
+          sql << "CREATE TABLE IF NOT EXISTS schema_version ("
+                 "version integer NOT NULL)";
+          sql << "DELETE FROM schema_version";
+          const int next_version = version + 1;
+          sql << "INSERT INTO schema_version(version) VALUES (:version)",
+              soci::use(next_version);
+          tr.commit();
+        }
+        // snapshot tables copy the layout of the upgraded ones, they are
+        // created again by StorageImpl::init_
+        sql << "DROP SCHEMA IF EXISTS wsv_snapshot CASCADE";
+        log->info("Database schema is upgraded to version {}", version);
+      } catch (const std::exception &e) {
+        return expected::makeError(
+            std::string("Failed to upgrade database schema: ") + e.what());
+      }
+      return expected::Value<void>();
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
@@ -0,0 +1,49 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_POSTGRES_SCHEMA_MIGRATION_HPP
+#define IROHA_POSTGRES_SCHEMA_MIGRATION_HPP
+
+#include <soci/soci.h>
+
+#include "common/result.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Version of the database schema created by StorageImpl. It is stored in
+     * schema_version table. Databases created before versioning have no such
+     * table and are treated as version 1, which has text columns and no
+     * indexes in block index tables. Version 3 adds the index of block
+     * heights by hash. Version 4 adds heights to transaction statuses.
+     */
+    constexpr int kSchemaVersion = 4;
+
+    /**
+     * Read the version of the schema of the database
+     * @param sql - session to the database
+     * @return schema version, 0 for a database without iroha tables
+     */
+    int getSchemaVersion(soci::session &sql);
+
+    /**
+     * Upgrade the schema of an existing database to kSchemaVersion. Each
+     * upgrade step converts the data in place within a transaction, so the
+     * chain does not have to be reindexed. A database without iroha tables is
+     * left untouched, it gets the current schema from StorageImpl.
+     * @param sql - session to the database
+     * @param log - logger to report progress
+     * @return error if the database has a newer schema or an upgrade failed
+     */
+    expected::Result<void, std::string> migrateSchema(
+        soci::session &sql,
+        logger::Logger log = logger::log("SchemaMigration"));
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_POSTGRES_SCHEMA_MIGRATION_HPP
@@ -41,6 +41,17 @@ namespace iroha {
           factory_(factory),
           log_(std::move(log)) {}
 
+    PostgresWsvQuery::PostgresWsvQuery(
+        std::unique_ptr<soci::session> sql,
+        std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
+        std::shared_ptr<SignatoryCache> signatory_cache,
+        logger::Logger log)
+        : psql_(std::move(sql)),
+          sql_(*psql_),
+          factory_(factory),
+          signatory_cache_(std::move(signatory_cache)),
+          log_(std::move(log)) {}
+
     template <typename T>
     boost::optional<std::shared_ptr<T>> PostgresWsvQuery::fromResult(
         shared_model::interface::CommonObjectsFactory::FactoryResult<
@@ -225,6 +236,22 @@ namespace iroha {
 
     boost::optional<std::vector<PubkeyType>> PostgresWsvQuery::getSignatories(
         const AccountIdType &account_id) {
+      if (signatory_cache_) {
+        try {
+          std::vector<PubkeyType> public_keys;
+          if (auto signatories = signatory_cache_->get(account_id, sql_)) {
+            for (const auto &public_key : (*signatories)->public_keys) {
+              public_keys.emplace_back(
+                  shared_model::crypto::Blob::fromHexString(public_key));
+            }
+          }
+          return public_keys;
+        } catch (const std::exception &e) {
+          log_->error("Failed to execute query: {}", e.what());
+          return boost::none;
+        }
+      }
+
       using T = boost::tuple<std::string>;
       auto result = execute<T>([&] {
         return (sql_.prepare
@@ -10,6 +10,7 @@
 
 #include <soci/soci.h>
 
+#include "ametsuchi/impl/signatory_cache.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
 #include "logger/logger.hpp"
 
@@ -29,6 +30,17 @@ namespace iroha {
               factory,
           logger::Logger log = logger::log("PostgresWsvQuery"));
 
+      /**
+       * @param signatory_cache - cache of the committed state, which is used
+       * by getSignatories, so the session has to see the committed state
+       */
+      PostgresWsvQuery(
+          std::unique_ptr<soci::session> sql,
+          std::shared_ptr<shared_model::interface::CommonObjectsFactory>
+              factory,
+          std::shared_ptr<SignatoryCache> signatory_cache,
+          logger::Logger log = logger::log("PostgresWsvQuery"));
+
       boost::optional<std::vector<shared_model::interface::types::RoleIdType>>
       getAccountRoles(const shared_model::interface::types::AccountIdType
                           &account_id) override;
@@ -107,6 +119,7 @@ namespace iroha {
       std::unique_ptr<soci::session> psql_;
       soci::session &sql_;
       std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory_;
+      std::shared_ptr<SignatoryCache> signatory_cache_;
       logger::Logger log_;
     };
   }  // namespace ametsuchi
@@ -0,0 +1,408 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <ciso646>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "common/files.hpp"
+
+using namespace iroha::ametsuchi;
+using Identifier = SegmentedLog::Identifier;
+
+namespace {
+  const uint32_t kDigitCapacity = 16;
+
+  uint32_t checksum(const uint8_t *data, size_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+  }
+
+  void putUint32(uint8_t *out, uint32_t value) {
+    for (int i = 3; i >= 0; --i, value >>= 8) {
+      out[i] = static_cast<uint8_t>(value & 0xFF);
+    }
+  }
+
+  uint32_t getUint32(const uint8_t *in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+      value = (value << 8) | in[i];
+    }
+    return value;
+  }
+
+  /**
+   * Check whether the file is a block of a flat file block store
+   */
+  bool isFlatFileBlock(const boost::filesystem::path &path) {
+    const auto name = path.filename().string();
+    return name.size() == FlatFile::DIGIT_CAPACITY
+        and std::all_of(name.begin(), name.end(), [](char c) {
+             return std::isdigit(static_cast<unsigned char>(c));
+           });
+  }
+
+  /**
+   * Write the whole buffer at given offset, retrying on partial writes
+   */
+  bool writeAll(int fd, const uint8_t *data, size_t size, uint64_t offset) {
+    while (size > 0) {
+      auto written = ::pwrite(fd, data, size, offset);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data += written;
+      size -= written;
+      offset += written;
+    }
+    return true;
+  }
+
+  /**
+   * Read exactly size bytes at given offset
+   */
+  bool readAll(int fd, uint8_t *data, size_t size, uint64_t offset) {
+    while (size > 0) {
+      auto read = ::pread(fd, data, size, offset);
+      if (read <= 0) {
+        if (read < 0 and errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data += read;
+      size -= read;
+      offset += read;
+    }
+    return true;
+  }
+}  // namespace
+
+// ----------| public API |----------
+
+const std::string SegmentedLog::kSegmentExtension = ".seg";
+constexpr size_t SegmentedLog::kRecordHeaderSize;
+
+boost::optional<std::unique_ptr<SegmentedLog>> SegmentedLog::create(
+    const std::string &path, Options options) {
+  auto log_ = logger::log("SegmentedLog::create()");
+
+  boost::system::error_code err;
+  if (path.empty()
+      or (not boost::filesystem::is_directory(path, err)
+          and not boost::filesystem::create_directory(path, err))) {
+    log_->error("Cannot create storage dir: {}\n{}", path, err.message());
+    return boost::none;
+  }
+
+  auto storage = std::make_unique<SegmentedLog>(path, options, private_tag{});
+  if (not storage->recover()) {
+    return boost::none;
+  }
+  return boost::make_optional(std::move(storage));
+}
+
+boost::optional<std::unique_ptr<SegmentedLog>> SegmentedLog::create(
+    const std::string &path) {
+  return create(path, Options{});
+}
+
+bool SegmentedLog::add(Identifier id, const Bytes &blob) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+
+  if (id != current_id_ + 1) {
+    log_->warn("Cannot append non-consecutive block");
+    return false;
+  }
+
+  const uint64_t record_size = kRecordHeaderSize + blob.size();
+  if (segments_.empty()
+      or (segments_.back().size > 0
+          and segments_.back().size + record_size > options_.segment_size)) {
+    if (not segments_.empty()
+        and options_.fsync_policy == FsyncPolicy::kOnSegmentClose
+        and ::fsync(segments_.back().fd) != 0) {
+      log_->warn("Cannot sync segment {}", segments_.back().first_id);
+    }
+    if (not startSegment(id)) {
+      return false;
+    }
+  }
+  auto &segment = segments_.back();
+
+  uint8_t header[kRecordHeaderSize];
+  putUint32(header, blob.size());
+  putUint32(header + 4, id);
+  putUint32(header + 8, checksum(blob.data(), blob.size()));
+
+  if (not writeAll(segment.fd, header, kRecordHeaderSize, segment.size)
+      or not writeAll(segment.fd,
+                      blob.data(),
+                      blob.size(),
+                      segment.size + kRecordHeaderSize)) {
+    log_->warn("Cannot write entry {}: {}", id, std::strerror(errno));
+    // drop partially written record, so that the next append starts at
+    // the same position
+    if (::ftruncate(segment.fd, segment.size) != 0) {
+      log_->error("Cannot truncate segment {}", segment.first_id);
+    }
+    return false;
+  }
+
+  if (options_.fsync_policy == FsyncPolicy::kOnEveryAdd
+      and ::fsync(segment.fd) != 0) {
+    log_->warn("Cannot sync entry {}", id);
+    return false;
+  }
+
+  index_.push_back(Location{static_cast<uint32_t>(segments_.size() - 1),
+                            static_cast<uint32_t>(blob.size()),
+                            segment.size + kRecordHeaderSize});
+  segment.size += record_size;
+  current_id_ = id;
+  return true;
+}
+
+boost::optional<SegmentedLog::Bytes> SegmentedLog::get(Identifier id) const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  if (id == 0 or id > index_.size()) {
+    log_->info("get({}) entry not found", id);
+    return boost::none;
+  }
+  const auto &location = index_[id - 1];
+  Bytes buf(location.size);
+  if (not readAll(segments_[location.segment].fd,
+                  buf.data(),
+                  buf.size(),
+                  location.offset)) {
+    log_->info("get({}) problem with reading segment", id);
+    return boost::none;
+  }
+  return buf;
+}
+
+boost::optional<SegmentedLog::BytesView> SegmentedLog::getView(
+    Identifier id) const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+  if (id == 0 or id > index_.size()) {
+    log_->info("get({}) entry not found", id);
+    return boost::none;
+  }
+  const auto &location = index_[id - 1];
+  auto mapping =
+      mapSegment(location.segment, location.offset + location.size);
+  if (not mapping) {
+    log_->info("get({}) problem with mapping segment", id);
+    return boost::none;
+  }
+  return BytesView{
+      mapping->data() + location.offset, location.size, std::move(mapping)};
+}
+
+std::string SegmentedLog::directory() const {
+  return dump_dir_;
+}
+
+Identifier SegmentedLog::last_id() const {
+  return current_id_.load();
+}
+
+void SegmentedLog::dropAll() {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  closeSegments();
+  iroha::remove_dir_contents(dump_dir_);
+  current_id_.store(0);
+}
+
+size_t SegmentedLog::segmentsCount() const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  return segments_.size();
+}
+
+// ----------| private API |----------
+
+SegmentedLog::SegmentedLog(const std::string &path,
+                           Options options,
+                           SegmentedLog::private_tag,
+                           logger::Logger log)
+    : current_id_(0),
+      dump_dir_(path),
+      options_(options),
+      log_{std::move(log)} {}
+
+SegmentedLog::~SegmentedLog() {
+  closeSegments();
+}
+
+bool SegmentedLog::recover() {
+  std::vector<boost::filesystem::path> files;
+  boost::system::error_code err;
+  for (boost::filesystem::directory_iterator it{dump_dir_, err}, end;
+       not err and it != end;
+       it.increment(err)) {
+    if (it->path().extension() == kSegmentExtension) {
+      files.push_back(it->path());
+    } else if (isFlatFileBlock(it->path())) {
+      log_->error("Storage dir {} contains flat file block {}",
+                  dump_dir_,
+                  it->path().string());
+      return false;
+    }
+  }
+  if (err) {
+    log_->error("Cannot list storage dir {}: {}", dump_dir_, err.message());
+    return false;
+  }
+  std::sort(files.begin(), files.end());
+
+  Identifier expected_id = 1;
+  auto file = files.begin();
+  for (; file != files.end(); ++file) {
+    if (file->filename().string() != segmentName(expected_id)) {
+      log_->warn("Segment {} does not continue the log", file->string());
+      break;
+    }
+
+    int fd = ::open(file->c_str(), O_RDWR);
+    struct stat st;
+    if (fd < 0 or ::fstat(fd, &st) != 0) {
+      log_->error("Cannot open segment {}", file->string());
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      return false;
+    }
+
+    // records of the last segment are verified completely, since a crash
+    // could leave garbage there, for others only headers are checked
+    const bool last = std::next(file) == files.end();
+    const Identifier first_id = expected_id;
+    const uint64_t file_size = st.st_size;
+    uint64_t offset = 0;
+    Bytes payload;
+    while (offset < file_size) {
+      uint8_t header[kRecordHeaderSize];
+      if (file_size - offset < kRecordHeaderSize
+          or not readAll(fd, header, kRecordHeaderSize, offset)) {
+        break;
+      }
+      const auto size = getUint32(header);
+      if (getUint32(header + 4) != expected_id
+          or file_size - offset - kRecordHeaderSize < size) {
+        break;
+      }
+      if (last) {
+        payload.resize(size);
+        if (not readAll(fd, payload.data(), size, offset + kRecordHeaderSize)
+            or checksum(payload.data(), size) != getUint32(header + 8)) {
+          break;
+        }
+      }
+      index_.push_back(Location{static_cast<uint32_t>(segments_.size()),
+                                size,
+                                offset + kRecordHeaderSize});
+      offset += kRecordHeaderSize + size;
+      ++expected_id;
+    }
+
+    segments_.push_back(Segment{first_id, fd, offset, nullptr});
+
+    if (offset != file_size) {
+      log_->warn("Truncating segment {} from {} to {} bytes",
+                 file->string(),
+                 file_size,
+                 offset);
+      if (::ftruncate(fd, offset) != 0) {
+        log_->error("Cannot truncate segment {}", file->string());
+        return false;
+      }
+      ++file;
+      break;
+    }
+  }
+
+  // everything after the first inconsistency cannot be trusted
+  for (; file != files.end(); ++file) {
+    log_->warn("Removing segment {}", file->string());
+    boost::filesystem::remove(*file, err);
+  }
+
+  current_id_.store(index_.size());
+  return true;
+}
+
+bool SegmentedLog::startSegment(Identifier first_id) {
+  const auto path = segmentPath(first_id);
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    log_->warn("Cannot create segment {}: {}", path, std::strerror(errno));
+    return false;
+  }
+  segments_.push_back(Segment{first_id, fd, 0, nullptr});
+  return true;
+}
+
+void SegmentedLog::closeSegments() {
+  for (const auto &segment : segments_) {
+    if (options_.fsync_policy != FsyncPolicy::kNever) {
+      ::fsync(segment.fd);
+    }
+    ::close(segment.fd);
+  }
+  segments_.clear();
+  index_.clear();
+}
+
+std::string SegmentedLog::segmentName(Identifier first_id) {
+  std::ostringstream os;
+  os << std::setw(kDigitCapacity) << std::setfill('0') << first_id
+     << kSegmentExtension;
+  return os.str();
+}
+
+std::string SegmentedLog::segmentPath(Identifier first_id) const {
+  return (boost::filesystem::path{dump_dir_} / segmentName(first_id)).string();
+}
+
+std::shared_ptr<const MappedFile> SegmentedLog::mapSegment(
+    uint32_t segment, uint64_t end) const {
+  std::lock_guard<std::mutex> lock(mapping_mutex_);
+
+  auto &mapping = segments_[segment].mapping;
+  if (mapping and mapping->size() >= end) {
+    return mapping;
+  }
+  // views of the previous mapping keep it alive until they are released
+  auto length = segments_[segment].size;
+  if (segment + 1 == segments_.size()) {
+    length = std::max<uint64_t>(length, options_.segment_size);
+  }
+  auto new_mapping =
+      MappedFile::map(segments_[segment].fd, std::max(length, end));
+  if (not new_mapping) {
+    return nullptr;
+  }
+  mapping = std::move(*new_mapping);
+  return mapping;
+}
@@ -0,0 +1,221 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SEGMENTED_LOG_HPP
+#define IROHA_SEGMENTED_LOG_HPP
+
+#include "ametsuchi/key_value_storage.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "ametsuchi/impl/mapped_file.hpp"
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Solid storage which packs consecutive entries into large append-only
+     * segment files. Each segment is named after the first key it contains
+     * and holds records of the form
+     *
+     *   | payload size (4) | key (4) | crc32 of payload (4) | payload |
+     *
+     * An in-memory index with the location of every record is built on
+     * creation by walking the record headers. A torn or corrupted record at
+     * the tail, left by a crash during append, is cut off together with
+     * everything after it.
+     */
+    class SegmentedLog : public KeyValueStorage {
+      /**
+       * Private tag used to construct unique and shared pointers
+       * without new operator
+       */
+      struct private_tag {};
+
+     public:
+      // ----------| public API |----------
+
+      /**
+       * Moments when appended data is flushed to the disk
+       */
+      enum class FsyncPolicy {
+        kNever,           ///< rely on the operating system
+        kOnSegmentClose,  ///< sync a segment when the next one is started
+        kOnEveryAdd       ///< sync after each appended entry
+      };
+
+      struct Options {
+        /// size after which a new segment is started
+        uint64_t segment_size = 64 * 1024 * 1024;
+        FsyncPolicy fsync_policy = FsyncPolicy::kOnSegmentClose;
+      };
+
+      /// Size of the header preceding every record payload
+      static constexpr size_t kRecordHeaderSize = 12;
+
+      /// Extension of segment files
+      static const std::string kSegmentExtension;
+
+      /**
+       * Create storage in paths
+       * @param path - target path for creating
+       * @param options - segment size and fsync policy
+       * @return created storage
+       */
+      static boost::optional<std::unique_ptr<SegmentedLog>> create(
+          const std::string &path, Options options);
+
+      /**
+       * Create storage in paths with default options
+       * @param path - target path for creating
+       * @return created storage
+       */
+      static boost::optional<std::unique_ptr<SegmentedLog>> create(
+          const std::string &path);
+
+      bool add(Identifier id, const Bytes &blob) override;
+
+      boost::optional<Bytes> get(Identifier id) const override;
+
+      /**
+       * Serve the entry from a memory mapping of its segment. A segment is
+       * mapped once on the first access, so consecutive entries of a range
+       * read share the same mapping
+       */
+      boost::optional<BytesView> getView(Identifier id) const override;
+
+      std::string directory() const override;
+
+      Identifier last_id() const override;
+
+      void dropAll() override;
+
+      /**
+       * @return number of segment files in the storage
+       */
+      size_t segmentsCount() const;
+
+      // ----------| modify operations |----------
+
+      SegmentedLog(const SegmentedLog &rhs) = delete;
+
+      SegmentedLog(SegmentedLog &&rhs) = delete;
+
+      SegmentedLog &operator=(const SegmentedLog &rhs) = delete;
+
+      SegmentedLog &operator=(SegmentedLog &&rhs) = delete;
+
+      // ----------| private API |----------
+
+      /**
+       * Create storage in path. Storage is empty until recover() is called
+       * @param path - folder of storage
+       * @param options - segment size and fsync policy
+       * @param log to print progress
+       */
+      SegmentedLog(const std::string &path,
+                   Options options,
+                   SegmentedLog::private_tag,
+                   logger::Logger log = logger::log("SegmentedLog"));
+
+      ~SegmentedLog() override;
+
+     private:
+      /**
+       * Opened segment file
+       */
+      struct Segment {
+        Identifier first_id;
+        int fd;
+        uint64_t size;
+        /// lazily created mapping, guarded by mapping_mutex_
+        mutable std::shared_ptr<const MappedFile> mapping;
+      };
+
+      /**
+       * Position of a record payload
+       */
+      struct Location {
+        uint32_t segment;
+        uint32_t size;
+        uint64_t offset;
+      };
+
+      /**
+       * Open existing segments, build the index and cut off the invalid tail
+       * @return false if the storage folder cannot be read or contains blocks
+       * of a flat file block store
+       */
+      bool recover();
+
+      /**
+       * Start a new segment with the given first key
+       * @return false if segment file cannot be created
+       */
+      bool startSegment(Identifier first_id);
+
+      /**
+       * Close all segment files and clear the index
+       */
+      void closeSegments();
+
+      /**
+       * @return name of the segment file starting with given key
+       */
+      static std::string segmentName(Identifier first_id);
+
+      std::string segmentPath(Identifier first_id) const;
+
+      /**
+       * Get a mapping of the segment which covers at least end bytes. The
+       * last segment is mapped with room for growth up to the segment size
+       * and is remapped if a record goes beyond the mapped part
+       * @return mapping or nullptr if the segment cannot be mapped
+       */
+      std::shared_ptr<const MappedFile> mapSegment(uint32_t segment,
+                                                   uint64_t end) const;
+
+      // ----------| private fields |----------
+
+      /**
+       * Last written key
+       */
+      std::atomic<Identifier> current_id_;
+
+      std::vector<Segment> segments_;
+
+      /**
+       * Record locations, entry with key id is stored at index id - 1
+       */
+      std::vector<Location> index_;
+
+      /**
+       * Guards segments_ and index_: add() appends under the exclusive lock,
+       * readers take the shared one
+       */
+      mutable std::shared_timed_mutex mutex_;
+
+      /**
+       * Guards mappings of segments, which are created under the shared lock
+       */
+      mutable std::mutex mapping_mutex_;
+
+      /**
+       * Folder of storage
+       */
+      const std::string dump_dir_;
+
+      const Options options_;
+
+      logger::Logger log_;
+    };
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_SEGMENTED_LOG_HPP
@@ -0,0 +1,136 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/signatory_cache.hpp"
+
+#include <algorithm>
+
+#include <soci/boost-tuple.h>
+#include <boost/range/size.hpp>
+#include "common/visitor.hpp"
+#include "cryptography/public_key.hpp"
+#include "interfaces/commands/add_signatory.hpp"
+#include "interfaces/commands/command_variant.hpp"
+#include "interfaces/commands/create_account.hpp"
+#include "interfaces/commands/remove_signatory.hpp"
+#include "interfaces/commands/set_quorum.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using shared_model::interface::types::AccountIdType;
+
+    bool SignatoryCache::AccountSignatories::hasSignatories(
+        const shared_model::interface::types::SignatureRangeType &signatures)
+        const {
+      return std::all_of(
+          signatures.begin(), signatures.end(), [this](const auto &signature) {
+            return public_keys.count(signature.publicKey().hex()) != 0;
+          });
+    }
+
+    bool SignatoryCache::AccountSignatories::isSignedBy(
+        const shared_model::interface::types::SignatureRangeType &signatures)
+        const {
+      return boost::size(signatures) >= quorum and hasSignatories(signatures);
+    }
+
+    SignatoryCache::SignatoryCache() : generation_(0) {}
+
+    boost::optional<SignatoryCache::AccountSignatories> SignatoryCache::load(
+        soci::session &sql, const AccountIdType &account_id) {
+      soci::rowset<boost::tuple<int, boost::optional<std::string>>> rows =
+          (sql.prepare << R"(
+          SELECT a.quorum, s.public_key
+          FROM account AS a
+          LEFT JOIN account_has_signatory AS s
+              ON s.account_id = a.account_id
+          WHERE a.account_id = :account_id)",
+           soci::use(account_id, "account_id"));
+
+      boost::optional<AccountSignatories> result;
+      for (const auto &row : rows) {
+        if (not result) {
+          result = AccountSignatories{
+              static_cast<shared_model::interface::types::QuorumType>(
+                  row.get<0>()),
+              {}};
+        }
+        if (row.get<1>()) {
+          result->public_keys.insert(*row.get<1>());
+        }
+      }
+      return result;
+    }
+
+    boost::optional<AccountIdType> SignatoryCache::changedAccount(
+        const shared_model::interface::Command &command) {
+      using ResultType = boost::optional<AccountIdType>;
+      return visit_in_place(
+          command.get(),
+          [](const shared_model::interface::AddSignatory &add) -> ResultType {
+            return add.accountId();
+          },
+          [](const shared_model::interface::RemoveSignatory &remove)
+              -> ResultType { return remove.accountId(); },
+          [](const shared_model::interface::SetQuorum &set) -> ResultType {
+            return set.accountId();
+          },
+          [](const shared_model::interface::CreateAccount &create)
+              -> ResultType {
+            return create.accountName() + "@" + create.domainId();
+          },
+          [](const auto &) -> ResultType { return boost::none; });
+    }
+
+    boost::optional<std::shared_ptr<const SignatoryCache::AccountSignatories>>
+    SignatoryCache::get(const AccountIdType &account_id, soci::session &sql) {
+      uint64_t generation;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cached = accounts_.find(account_id);
+        if (cached != accounts_.end()) {
+          return cached->second;
+        }
+        generation = generation_;
+      }
+
+      auto loaded = load(sql, account_id);
+      if (not loaded) {
+        return boost::none;
+      }
+      auto result =
+          std::make_shared<const AccountSignatories>(std::move(*loaded));
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (generation == generation_) {
+        accounts_.emplace(account_id, result);
+      }
+      return std::shared_ptr<const AccountSignatories>(std::move(result));
+    }
+
+    void SignatoryCache::invalidate(
+        const shared_model::interface::Block &block) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto &transaction : block.transactions()) {
+        for (const auto &command : transaction.commands()) {
+          if (auto account_id = changedAccount(command)) {
+            accounts_.erase(*account_id);
+          }
+        }
+      }
+      ++generation_;
+    }
+
+    void SignatoryCache::clear() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      accounts_.clear();
+      ++generation_;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
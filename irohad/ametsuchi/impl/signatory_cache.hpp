@@ -0,0 +1,114 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SIGNATORY_CACHE_HPP
+#define IROHA_SIGNATORY_CACHE_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <soci/soci.h>
+#include <boost/optional.hpp>
+#include "interfaces/common_objects/range_types.hpp"
+#include "interfaces/common_objects/types.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Block;
+    class Command;
+  }  // namespace interface
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Quorums and signatories of accounts in the committed world state,
+     * shared by temporary wsvs and wsv queries of the storage, so that
+     * signatures are checked in memory. Values are read from the database on
+     * first access and dropped when a block which changes them is committed.
+     * Accounts which do not exist are not cached. Thread-safe
+     */
+    class SignatoryCache {
+     public:
+      struct AccountSignatories {
+        shared_model::interface::types::QuorumType quorum;
+        /// hex representations of public keys of the signatories
+        std::unordered_set<std::string> public_keys;
+
+        /**
+         * @return true if every signature is made by a signatory
+         */
+        bool hasSignatories(
+            const shared_model::interface::types::SignatureRangeType
+                &signatures) const;
+
+        /**
+         * @return true if signatures are made by signatories and their
+         * number is not less than the quorum
+         */
+        bool isSignedBy(
+            const shared_model::interface::types::SignatureRangeType
+                &signatures) const;
+      };
+
+      SignatoryCache();
+
+      /**
+       * Read quorum and signatories of the account with a single statement
+       * @param sql - session to read from
+       * @param account_id - id of the account
+       * @return none if the account does not exist
+       * @throws exceptions of the session on database errors
+       */
+      static boost::optional<AccountSignatories> load(
+          soci::session &sql,
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      /**
+       * @return id of the account whose quorum or signatories are changed by
+       * the command, none if the command does not change them
+       */
+      static boost::optional<shared_model::interface::types::AccountIdType>
+      changedAccount(const shared_model::interface::Command &command);
+
+      /**
+       * @param account_id - id of the account
+       * @param sql - session which sees the committed state of the account,
+       * used if it is not cached
+       * @return quorum and signatories, none if the account does not exist
+       * @throws exceptions of the session on database errors
+       */
+      boost::optional<std::shared_ptr<const AccountSignatories>> get(
+          const shared_model::interface::types::AccountIdType &account_id,
+          soci::session &sql);
+
+      /**
+       * Drop the accounts changed by commands of the committed block
+       */
+      void invalidate(const shared_model::interface::Block &block);
+
+      /**
+       * Drop all accounts, when the world state is changed otherwise
+       */
+      void clear();
+
+     private:
+      std::mutex mutex_;
+      std::unordered_map<shared_model::interface::types::AccountIdType,
+                         std::shared_ptr<const AccountSignatories>>
+          accounts_;
+      /// incremented on every invalidation, so that values read before it
+      /// are not cached after it
+      uint64_t generation_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_SIGNATORY_CACHE_HPP
@@ -155,6 +155,29 @@ namespace iroha {
       };
     }
 
+    /**
+     * Format values as a postgres array literal, so that a whole column of
+     * rows is bound to a statement as a single parameter
+     */
+    inline std::string makeArray(const std::vector<std::string> &values) {
+      std::string result = "{";
+      for (const auto &value : values) {
+        if (result.size() > 1) {
+          result += ',';
+        }
+        result += '"';
+        for (auto c : value) {
+          if (c == '"' or c == '\\') {
+            result += '\\';
+          }
+          result += c;
+        }
+        result += '"';
+      }
+      result += '}';
+      return result;
+    }
+
   }  // namespace ametsuchi
 }  // namespace iroha
 
@@ -5,6 +5,9 @@
 
 #include "ametsuchi/impl/storage_impl.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 #include <soci/postgresql/soci-postgresql.h>
 #include <boost/format.hpp>
 #include "ametsuchi/impl/flat_file/flat_file.hpp"
@@ -14,6 +17,7 @@
 #include "ametsuchi/impl/postgres_block_query.hpp"
 #include "ametsuchi/impl/postgres_command_executor.hpp"
 #include "ametsuchi/impl/postgres_query_executor.hpp"
+#include "ametsuchi/impl/postgres_schema_migration.hpp"
 #include "ametsuchi/impl/postgres_wsv_query.hpp"
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
 #include "backend/protobuf/permissions.hpp"
@@ -43,6 +47,53 @@ namespace {
     }
   }
 
+  /**
+   * Tables which make up WSV, in the order they can be filled without
+   * breaking references between them
+   */
+  const char *const kWsvTables[] = {"role",
+                                    "domain",
+                                    "signatory",
+                                    "account",
+                                    "account_has_signatory",
+                                    "peer",
+                                    "asset",
+                                    "account_has_asset",
+                                    "role_has_permissions",
+                                    "account_has_roles",
+                                    "account_has_grantable_permissions"};
+
+  /**
+   * Block index tables, which only grow with the chain, so they are not
+   * copied to the snapshot. Rows of the blocks after the snapshot are
+   * deleted when it is restored. Statuses indexed before the height column
+   * was added have no height, they belong to the blocks of the snapshot
+   */
+  const char *const kBlockIndexTables[] = {"position_by_hash",
+                                           "tx_status_by_hash",
+                                           "height_by_account_set",
+                                           "index_by_creator_height",
+                                           "position_by_account_asset",
+                                           "height_by_block_hash"};
+
+  /**
+   * Snapshot of WSV is kept in a separate schema in tables with the same
+   * names and columns as the original ones
+   */
+  std::string createSnapshotTables() {
+    std::string sql = "CREATE SCHEMA IF NOT EXISTS wsv_snapshot;\n";
+    for (const auto table : kWsvTables) {
+      sql += "CREATE TABLE IF NOT EXISTS wsv_snapshot." + std::string(table)
+          + " (LIKE " + table + ");\n";
+    }
+    sql += R"(CREATE TABLE IF NOT EXISTS wsv_snapshot.top_block (
+    height bigint NOT NULL,
+    hash bytea NOT NULL
+);
+)";
+    return sql;
+  }
+
 }  // namespace
 
 namespace iroha {
@@ -51,6 +102,10 @@ namespace iroha {
     const char *kPsqlBroken = "Connection to PostgreSQL broken: %s";
     const char *kTmpWsv = "TemporaryWsv";
 
+    constexpr size_t StorageImpl::kDefaultPoolSize;
+    constexpr size_t StorageImpl::kDefaultWsvSnapshotPeriod;
+    constexpr uint32_t StorageImpl::kBlocksPerApply;
+
     ConnectionContext::ConnectionContext(
         std::unique_ptr<KeyValueStorage> block_store)
         : block_store(std::move(block_store)) {}
@@ -65,6 +120,7 @@ namespace iroha {
         std::shared_ptr<shared_model::interface::PermissionToString>
             perm_converter,
         size_t pool_size,
+        size_t wsv_snapshot_period,
         bool enable_prepared_blocks,
         logger::Logger log)
         : block_store_dir_(std::move(block_store_dir)),
@@ -74,8 +130,10 @@ namespace iroha {
           factory_(std::move(factory)),
           converter_(std::move(converter)),
           perm_converter_(std::move(perm_converter)),
+          signatory_cache_(std::make_shared<SignatoryCache>()),
           log_(std::move(log)),
           pool_size_(pool_size),
+          wsv_snapshot_period_(wsv_snapshot_period),
           prepared_blocks_enabled_(enable_prepared_blocks),
           block_is_prepared(false) {
       prepared_block_name_ =
@@ -87,8 +145,17 @@ namespace iroha {
         rollbackPrepared(sql);
       }
       try {
-        sql << init_;
-        prepareStatements(*connection_, pool_size_);
+        // existing database is upgraded before init_ creates indexes, which
+        // refer to columns of the current schema
+        migrateSchema(sql).match(
+            [&](expected::Value<void> &) {
+              sql << init_;
+              indexBlockHashes(sql);
+              prepareStatements(*connection_, pool_size_);
+            },
+            [&](expected::Error<std::string> &e) {
+              log_->error("Storage was not initialized. Reason: {}", e.error);
+            });
       } catch (std::exception &e) {
         log_->error("Storage was not initialized. Reason: {}", e.what());
       }
@@ -96,6 +163,7 @@ namespace iroha {
 
     expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
     StorageImpl::createTemporaryWsv() {
+      waitPreparation();
       std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
       if (connection_ == nullptr) {
         return expected::makeError("Connection was closed");
@@ -104,13 +172,14 @@ namespace iroha {
 
       return expected::makeValue<std::unique_ptr<TemporaryWsv>>(
           std::make_unique<TemporaryWsvImpl>(
-              std::move(sql), factory_, perm_converter_));
+              std::move(sql), factory_, perm_converter_, signatory_cache_));
     }
 
     expected::Result<std::unique_ptr<MutableStorage>, std::string>
     StorageImpl::createMutableStorage() {
       boost::optional<shared_model::interface::types::HashType> top_hash;
 
+      waitPreparation();
       std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
       if (connection_ == nullptr) {
         return expected::makeError("Connection was closed");
@@ -233,8 +302,159 @@ namespace iroha {
       return inserted;
     }
 
+    bool StorageImpl::applyStoredBlocks(
+        shared_model::interface::types::HeightType first_height) {
+      auto block_query = getBlockQuery();
+      if (not block_query) {
+        return false;
+      }
+
+      const auto top_height = block_store_->last_id();
+      log_->info("Applying blocks from {} to {}", first_height, top_height);
+      // every chunk is committed separately, so only a chunk of blocks is
+      // kept in memory by the mutable storage
+      for (auto height = first_height; height <= top_height;
+           height += kBlocksPerApply) {
+        auto blocks = block_query->getBlocks(height, kBlocksPerApply);
+        if (blocks.empty()) {
+          log_->error("Failed to retrieve block with id {}", height);
+          return false;
+        }
+        auto storage_result = createMutableStorage();
+        auto applied = storage_result.match(
+            [&](expected::Value<std::unique_ptr<MutableStorage>> &storage) {
+              auto &mutable_storage =
+                  static_cast<MutableStorageImpl &>(*storage.value);
+              return std::all_of(blocks.begin(),
+                                 blocks.end(),
+                                 [&mutable_storage](const auto &block) {
+                                   return mutable_storage.apply(*block);
+                                 })
+                  and commitWsv(mutable_storage);
+            },
+            [&](expected::Error<std::string> &error) {
+              log_->error(error.error);
+              return false;
+            });
+        for (const auto &block : blocks) {
+          signatory_cache_->invalidate(*block);
+        }
+        if (not applied) {
+          log_->error("Failed to apply blocks starting from {}", height);
+          return false;
+        }
+      }
+      return true;
+    }
+
+    boost::optional<shared_model::interface::types::HeightType>
+    StorageImpl::restoreWsvSnapshot() {
+      std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
+      if (not connection_) {
+        log_->info("connection to database is not initialised");
+        return boost::none;
+      }
+
+      try {
+        soci::session sql(*connection_);
+        // rollback possible prepared transaction
+        if (block_is_prepared) {
+          rollbackPrepared(sql);
+        }
+        soci::transaction tr(sql);
+
+        long long height = 0;
+        std::string hash;
+        sql << "SELECT height, encode(hash, 'hex') FROM wsv_snapshot.top_block",
+            soci::into(height), soci::into(hash);
+        if (height == 0) {
+          log_->info("There is no WSV snapshot");
+          return boost::none;
+        }
+
+        // snapshot is useless if the blocks it was taken for are replaced
+        auto blocks = PostgresBlockQuery(sql, *block_store_, converter_)
+                          .getBlocks(height, 1);
+        if (blocks.empty() or blocks.front()->hash().hex() != hash) {
+          log_->warn("WSV snapshot at height {} does not match stored blocks",
+                     height);
+          return boost::none;
+        }
+
+        sql << reset_wsv_;
+        for (const auto table : kWsvTables) {
+          sql << "INSERT INTO " + std::string(table)
+                  + " SELECT * FROM wsv_snapshot." + table;
+        }
+        for (const auto table : kBlockIndexTables) {
+          sql << "DELETE FROM " + std::string(table)
+                  + " WHERE height > :height",
+              soci::use(height, "height");
+        }
+        tr.commit();
+        signatory_cache_->clear();
+
+        log_->info("WSV is restored from the snapshot at height {}", height);
+        return static_cast<shared_model::interface::types::HeightType>(height);
+      } catch (const std::exception &e) {
+        log_->warn("Failed to restore WSV snapshot. Reason: {}", e.what());
+        return boost::none;
+      }
+    }
+
+    bool StorageImpl::createWsvSnapshot() {
+      // the snapshot is not needed if the storage is being dropped
+      std::shared_lock<std::shared_timed_mutex> lock(drop_mutex,
+                                                     std::try_to_lock);
+      if (not lock.owns_lock() or not connection_) {
+        log_->info("connection to database is not initialised");
+        return false;
+      }
+
+      try {
+        soci::session sql(*connection_);
+        soci::transaction tr(sql);
+        // all tables and the top block are read from the same state of the
+        // database, even if blocks are committed meanwhile
+        sql << "SET TRANSACTION ISOLATION LEVEL REPEATABLE READ";
+
+        long long height = 0;
+        std::string hash;
+        {
+          // the state is fixed by the first query of the transaction, which
+          // must not see a prepared block without its index
+          std::lock_guard<std::mutex> commit_lock(prepared_commit_mutex_);
+          sql << "SELECT height, encode(hash, 'hex') "
+                 "FROM height_by_block_hash ORDER BY height DESC LIMIT 1",
+              soci::into(height), soci::into(hash);
+        }
+        if (height == 0) {
+          log_->info("There are no blocks to take WSV snapshot for");
+          return false;
+        }
+
+        for (const auto table : kWsvTables) {
+          sql << "DELETE FROM wsv_snapshot." + std::string(table);
+          sql << "INSERT INTO wsv_snapshot." + std::string(table)
+                  + " SELECT * FROM " + table;
+        }
+        sql << reset_snapshot_;
+        sql << "INSERT INTO wsv_snapshot.top_block(height, hash) "
+               "VALUES (:height, decode(:hash, 'hex'))",
+            soci::use(height, "height"), soci::use(hash, "hash");
+        tr.commit();
+
+        log_->info("WSV snapshot is taken at height {}", height);
+        return true;
+      } catch (const std::exception &e) {
+        log_->warn("Failed to take WSV snapshot. Reason: {}", e.what());
+        return false;
+      }
+    }
+
     void StorageImpl::reset() {
       log_->info("drop wsv records from db tables");
+      waitSnapshot();
       try {
         soci::session sql(*connection_);
         // rollback possible prepared transaction
@@ -242,6 +462,9 @@ namespace iroha {
           rollbackPrepared(sql);
         }
         sql << reset_;
+        signatory_cache_->clear();
+        // snapshot refers to the blocks, which are dropped
+        sql << reset_snapshot_;
         log_->info("drop blocks from disk");
         block_store_->dropAll();
       } catch (std::exception &e) {
@@ -249,6 +472,21 @@ namespace iroha {
       }
     }
 
+    void StorageImpl::resetWsv() {
+      log_->info("drop wsv records from db tables");
+      try {
+        soci::session sql(*connection_);
+        // rollback possible prepared transaction
+        if (block_is_prepared) {
+          rollbackPrepared(sql);
+        }
+        sql << reset_;
+        signatory_cache_->clear();
+      } catch (std::exception &e) {
+        log_->warn("Drop wsv was failed. Reason: {}", e.what());
+      }
+    }
+
     void StorageImpl::dropStorage() {
       log_->info("drop storage");
       if (connection_ == nullptr) {
@@ -273,12 +511,16 @@ namespace iroha {
         soci::session(*connection_) << drop_;
       }
 
+      signatory_cache_->clear();
+
       // erase blocks
       log_->info("drop block store");
       block_store_->dropAll();
     }
 
     void StorageImpl::freeConnections() {
+      waitPreparation();
+      waitSnapshot();
       if (connection_ == nullptr) {
         log_->warn("Tried to free connections without active connection");
         return;
@@ -326,11 +568,21 @@ namespace iroha {
     }
 
     expected::Result<ConnectionContext, std::string>
-    StorageImpl::initConnections(std::string block_store_dir) {
+    StorageImpl::initConnections(std::string block_store_dir,
+                                 const BlockStoreOptions &options) {
       auto log_ = logger::log("StorageImpl:initConnection");
       log_->info("Start storage creation");
 
-      auto block_store = FlatFile::create(block_store_dir);
+      boost::optional<std::unique_ptr<KeyValueStorage>> block_store;
+      switch (options.type) {
+        case BlockStoreOptions::Type::kSegmentedLog:
+          block_store =
+              SegmentedLog::create(block_store_dir, options.segmented_log);
+          break;
+        case BlockStoreOptions::Type::kFlatFile:
+          block_store = FlatFile::create(block_store_dir);
+          break;
+      }
       if (not block_store) {
         return expected::makeError(
             (boost::format("Cannot create block store in %s") % block_store_dir)
@@ -365,7 +617,9 @@ namespace iroha {
         std::shared_ptr<shared_model::interface::BlockJsonConverter> converter,
         std::shared_ptr<shared_model::interface::PermissionToString>
             perm_converter,
-        size_t pool_size) {
+        size_t pool_size,
+        const BlockStoreOptions &block_store_options,
+        size_t wsv_snapshot_period) {
       boost::optional<std::string> string_res = boost::none;
 
       PostgresOptions options(postgres_options);
@@ -383,7 +637,7 @@ namespace iroha {
         return expected::makeError(string_res.value());
       }
 
-      auto ctx_result = initConnections(block_store_dir);
+      auto ctx_result = initConnections(block_store_dir, block_store_options);
       auto db_result = initPostgresConnection(postgres_options, pool_size);
       expected::Result<std::shared_ptr<StorageImpl>, std::string> storage;
       ctx_result.match(
@@ -403,6 +657,7 @@ namespace iroha {
                                       converter,
                                       perm_converter,
                                       pool_size,
+                                      wsv_snapshot_period,
                                       enable_prepared_transactions)));
                 },
                 [&](expected::Error<std::string> &error) { storage = error; });
@@ -414,16 +669,109 @@ namespace iroha {
     void StorageImpl::commit(std::unique_ptr<MutableStorage> mutableStorage) {
       auto storage_ptr = std::move(mutableStorage);  // get ownership of storage
       auto storage = static_cast<MutableStorageImpl *>(storage_ptr.get());
+      std::vector<std::shared_ptr<shared_model::interface::Block>> stored;
+      for (const auto &block : storage->block_store_) {
+        pre_commit_notifier_.get_subscriber().on_next(block.second);
+        if (storeBlock(*block.second)) {
+          stored.push_back(block.second);
+        }
+      }
+      auto committed = commitWsv(*storage);
       for (const auto &block : storage->block_store_) {
-        storeBlock(*block.second);
+        signatory_cache_->invalidate(*block.second);
+      }
+      // subscribers are notified when transactions of the blocks are visible
+      for (const auto &block : stored) {
+        notifier_.get_subscriber().on_next(clone(*block));
       }
+      if (committed and not storage->block_store_.empty()) {
+        snapshotIfDue(storage->block_store_.begin()->first,
+                      storage->block_store_.rbegin()->first);
+      }
+    }
+
+    bool StorageImpl::commitWsv(MutableStorageImpl &storage) {
       try {
-        *(storage->sql_) << "COMMIT";
-        storage->committed = true;
+        *(storage.sql_) << "COMMIT";
+        storage.committed = true;
       } catch (std::exception &e) {
-        storage->committed = false;
+        storage.committed = false;
         log_->warn("Mutable storage is not committed. Reason: {}", e.what());
       }
+      return storage.committed;
+    }
+
+    void StorageImpl::snapshotIfDue(
+        shared_model::interface::types::HeightType first_height,
+        shared_model::interface::types::HeightType last_height) {
+      if (wsv_snapshot_period_ == 0
+          or last_height / wsv_snapshot_period_
+              == (first_height - 1) / wsv_snapshot_period_) {
+        return;
+      }
+
+      // the copy takes time proportional to WSV, it is not made on the
+      // commit path, and a due snapshot is skipped if the previous one is
+      // still being taken
+      std::lock_guard<std::mutex> lock(snapshot_mutex_);
+      if (snapshot_.valid()
+          and snapshot_.wait_for(std::chrono::seconds(0))
+              != std::future_status::ready) {
+        log_->info("WSV snapshot is still being taken, skipped at height {}",
+                   last_height);
+        return;
+      }
+      snapshot_ = std::async(std::launch::async, [this] {
+                    createWsvSnapshot();
+                  }).share();
+    }
+
+    void StorageImpl::waitSnapshot() const {
+      std::shared_future<void> snapshot;
+      {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        snapshot = snapshot_;
+      }
+      if (snapshot.valid()) {
+        snapshot.wait();
+      }
+    }
+
+    void StorageImpl::indexBlockHashes(soci::session &sql) {
+      long long indexed = 0;
+      sql << "SELECT count(*) FROM height_by_block_hash", soci::into(indexed);
+      const auto last_id = block_store_->last_id();
+      if (indexed >= last_id) {
+        return;
+      }
+
+      // blocks are read one at a time, so the chain is never loaded whole
+      log_->info("Indexing hashes of {} blocks", last_id - indexed);
+      for (long long height = 1; height <= last_id; ++height) {
+        auto serialized_block = block_store_->getView(height);
+        if (not serialized_block) {
+          log_->warn("Failed to retrieve block with id {}", height);
+          continue;
+        }
+        converter_
+            ->deserializeFromArray(
+                reinterpret_cast<const char *>(serialized_block->data),
+                serialized_block->size)
+            .match(
+                [&](expected::Value<
+                    std::unique_ptr<shared_model::interface::Block>> &block) {
+                  const auto &hash = block.value->hash().hex();
+                  sql << "INSERT INTO height_by_block_hash(hash, height) "
+                         "VALUES (decode(:hash, 'hex'), :height) "
+                         "ON CONFLICT DO NOTHING",
+                      soci::use(hash, "hash"), soci::use(height, "height");
+                },
+                [&](expected::Error<std::string> &e) {
+                  log_->warn("Failed to index block with id {}: {}",
+                             height,
+                             e.error);
+                });
+      }
     }
 
     bool StorageImpl::commitPrepared(
@@ -433,12 +781,14 @@ namespace iroha {
         return false;
       }
 
+      waitPreparation();
       if (not block_is_prepared) {
         log_->info("there are no prepared blocks");
         return false;
       }
       log_->info("applying prepared block");
 
+      pre_commit_notifier_.get_subscriber().on_next(clone(block));
       try {
         std::shared_lock<std::shared_timed_mutex> lock(drop_mutex);
         if (not connection_) {
@@ -446,9 +796,13 @@ namespace iroha {
           return false;
         }
         soci::session sql(*connection_);
-        sql << "COMMIT PREPARED '" + prepared_block_name_ + "';";
-        PostgresBlockIndex block_index(sql);
-        block_index.index(block);
+        {
+          std::lock_guard<std::mutex> commit_lock(prepared_commit_mutex_);
+          sql << "COMMIT PREPARED '" + prepared_block_name_ + "';";
+          PostgresBlockIndex block_index(sql);
+          block_index.index(block);
+        }
+        signatory_cache_->invalidate(block);
         block_is_prepared = false;
       } catch (const std::exception &e) {
         log_->warn("failed to apply prepared block {}: {}",
@@ -457,7 +811,12 @@ namespace iroha {
         return false;
       }
 
-      return storeBlock(block);
+      auto stored = storeBlock(block);
+      if (stored) {
+        notifier_.get_subscriber().on_next(clone(block));
+      }
+      snapshotIfDue(block.height(), block.height());
+      return stored;
     }
 
     std::shared_ptr<WsvQuery> StorageImpl::getWsvQuery() const {
@@ -467,7 +826,9 @@ namespace iroha {
         return nullptr;
       }
       return std::make_shared<PostgresWsvQuery>(
-          std::make_unique<soci::session>(*connection_), factory_);
+          std::make_unique<soci::session>(*connection_),
+          factory_,
+          signatory_cache_);
     }
 
     std::shared_ptr<BlockQuery> StorageImpl::getBlockQuery() const {
@@ -487,6 +848,11 @@ namespace iroha {
       return notifier_.get_observable();
     }
 
+    rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
+    StorageImpl::on_pre_commit() {
+      return pre_commit_notifier_.get_observable();
+    }
+
     void StorageImpl::prepareBlock(std::unique_ptr<TemporaryWsv> wsv) {
       auto &wsv_impl = static_cast<TemporaryWsvImpl &>(*wsv);
       if (not prepared_blocks_enabled_) {
@@ -496,6 +862,8 @@ namespace iroha {
       if (not block_is_prepared) {
         soci::session &sql = *wsv_impl.sql_;
         try {
+          // balances changed in memory have to be prepared as well
+          wsv_impl.cache_->flush();
           sql << "PREPARE TRANSACTION '" + prepared_block_name_ + "';";
           block_is_prepared = true;
         } catch (const std::exception &e) {
@@ -506,6 +874,45 @@ namespace iroha {
       }
     }
 
+    void StorageImpl::prepareBlockAsync(std::unique_ptr<TemporaryWsv> wsv,
+                                        PreparationWork work) {
+      if (not prepared_blocks_enabled_) {
+        log_->warn("prepared block are not enabled");
+        return;
+      }
+      auto cancelled = std::make_shared<std::atomic<bool>>(false);
+      auto prepare = [this,
+                      wsv = std::move(wsv),
+                      work = std::move(work),
+                      cancelled]() mutable {
+        try {
+          if (work(*wsv, *cancelled)) {
+            prepareBlock(std::move(wsv));
+          }
+        } catch (const std::exception &e) {
+          log_->warn("failed to prepare state: {}", e.what());
+        }
+      };
+
+      std::lock_guard<std::mutex> lock(preparation_mutex_);
+      preparation_cancelled_ = std::move(cancelled);
+      preparation_ = std::async(std::launch::async, std::move(prepare)).share();
+    }
+
+    void StorageImpl::waitPreparation() const {
+      std::shared_future<void> preparation;
+      std::shared_ptr<std::atomic<bool>> cancelled;
+      {
+        std::lock_guard<std::mutex> lock(preparation_mutex_);
+        preparation = preparation_;
+        cancelled = preparation_cancelled_;
+      }
+      if (preparation.valid()) {
+        *cancelled = true;
+        preparation.wait();
+      }
+    }
+
     StorageImpl::~StorageImpl() {
       freeConnections();
     }
@@ -524,7 +931,6 @@ namespace iroha {
       return json_result.match(
           [this, &block](const expected::Value<std::string> &v) {
             block_store_->add(block.height(), stringToBytes(v.value));
-            notifier_.get_subscriber().on_next(clone(block));
             return true;
           },
           [this](const expected::Error<std::string> &e) {
@@ -545,14 +951,17 @@ DROP TABLE IF EXISTS domain;
 DROP TABLE IF EXISTS signatory;
 DROP TABLE IF EXISTS peer;
 DROP TABLE IF EXISTS role;
-DROP TABLE IF EXISTS height_by_hash;
+DROP TABLE IF EXISTS position_by_hash;
 DROP TABLE IF EXISTS tx_status_by_hash;
 DROP TABLE IF EXISTS height_by_account_set;
 DROP TABLE IF EXISTS index_by_creator_height;
 DROP TABLE IF EXISTS position_by_account_asset;
+DROP TABLE IF EXISTS height_by_block_hash;
+DROP TABLE IF EXISTS schema_version;
+DROP SCHEMA IF EXISTS wsv_snapshot CASCADE;
 )";
 
-    const std::string &StorageImpl::reset_ = R"(
+    const std::string &StorageImpl::reset_wsv_ = R"(
 DELETE FROM account_has_signatory;
 DELETE FROM account_has_asset;
 DELETE FROM role_has_permissions CASCADE;
@@ -564,11 +973,19 @@ DELETE FROM domain;
 DELETE FROM signatory;
 DELETE FROM peer;
 DELETE FROM role;
+)";
+
+    const std::string &StorageImpl::reset_ = reset_wsv_ + R"(
 DELETE FROM position_by_hash;
 DELETE FROM tx_status_by_hash;
 DELETE FROM height_by_account_set;
 DELETE FROM index_by_creator_height;
 DELETE FROM position_by_account_asset;
+DELETE FROM height_by_block_hash;
+)";
+
+    const std::string &StorageImpl::reset_snapshot_ = R"(
+DELETE FROM wsv_snapshot.top_block;
 )";
 
     const std::string &StorageImpl::init_ =
@@ -638,32 +1055,57 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
     PRIMARY KEY (permittee_account_id, account_id)
 );
 CREATE TABLE IF NOT EXISTS position_by_hash (
-    hash varchar,
-    height text,
-    index text
+    hash bytea NOT NULL,
+    height bigint NOT NULL,
+    index bigint NOT NULL,
+    PRIMARY KEY (height, index)
 );
+CREATE INDEX IF NOT EXISTS position_by_hash_hash_index
+    ON position_by_hash (hash);
 
 CREATE TABLE IF NOT EXISTS tx_status_by_hash (
-    hash varchar,
-    status boolean
+    hash bytea NOT NULL,
+    status boolean NOT NULL,
+    height bigint
 );
+CREATE INDEX IF NOT EXISTS tx_status_by_hash_hash_index
+    ON tx_status_by_hash (hash);
 
 CREATE TABLE IF NOT EXISTS height_by_account_set (
-    account_id text,
-    height text
+    account_id text NOT NULL,
+    height bigint NOT NULL
 );
+CREATE INDEX IF NOT EXISTS height_by_account_set_account_id_index
+    ON height_by_account_set (account_id, height);
 CREATE TABLE IF NOT EXISTS index_by_creator_height (
     id serial,
-    creator_id text,
-    height text,
-    index text
+    creator_id text NOT NULL,
+    height bigint NOT NULL,
+    index bigint NOT NULL,
+    PRIMARY KEY (id)
 );
+CREATE INDEX IF NOT EXISTS index_by_creator_height_creator_id_index
+    ON index_by_creator_height (creator_id, height, index);
 CREATE TABLE IF NOT EXISTS position_by_account_asset (
-    account_id text,
-    asset_id text,
-    height text,
-    index text
+    account_id text NOT NULL,
+    asset_id text NOT NULL,
+    height bigint NOT NULL,
+    index bigint NOT NULL
 );
-)";
+CREATE INDEX IF NOT EXISTS position_by_account_asset_account_id_index
+    ON position_by_account_asset (account_id, asset_id, height, index);
+CREATE TABLE IF NOT EXISTS height_by_block_hash (
+    hash bytea NOT NULL,
+    height bigint NOT NULL,
+    PRIMARY KEY (hash)
+);
+CREATE TABLE IF NOT EXISTS schema_version (
+    version integer NOT NULL
+);
+INSERT INTO schema_version(version)
+    SELECT )"
+        + std::to_string(kSchemaVersion) + R"(
+    WHERE NOT EXISTS (SELECT * FROM schema_version);
+)" + createSnapshotTables();
   }  // namespace ametsuchi
 }  // namespace iroha
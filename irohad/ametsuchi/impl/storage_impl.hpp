@@ -10,12 +10,16 @@
 
 #include <atomic>
 #include <cmath>
+#include <future>
+#include <mutex>
 #include <shared_mutex>
 
 #include <soci/soci.h>
 #include <boost/optional.hpp>
 
+#include "ametsuchi/impl/block_store_options.hpp"
 #include "ametsuchi/impl/postgres_options.hpp"
+#include "ametsuchi/impl/signatory_cache.hpp"
 #include "ametsuchi/key_value_storage.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
 #include "interfaces/iroha_internal/block_json_converter.hpp"
@@ -26,6 +30,7 @@ namespace iroha {
   namespace ametsuchi {
 
     class FlatFile;
+    class MutableStorageImpl;
 
     struct ConnectionContext {
       explicit ConnectionContext(std::unique_ptr<KeyValueStorage> block_store);
@@ -40,13 +45,20 @@ namespace iroha {
           const std::string &options_str_without_dbname);
 
       static expected::Result<ConnectionContext, std::string> initConnections(
-          std::string block_store_dir);
+          std::string block_store_dir, const BlockStoreOptions &options);
 
       static expected::Result<std::shared_ptr<soci::connection_pool>,
                               std::string>
       initPostgresConnection(std::string &options_str, size_t pool_size);
 
      public:
+      /// Number of connections to the database opened by default
+      static constexpr size_t kDefaultPoolSize = 10;
+      /// Number of blocks between snapshots of WSV taken by default
+      static constexpr size_t kDefaultWsvSnapshotPeriod = 10000;
+      /// Number of blocks applied in one transaction when WSV is restored
+      static constexpr uint32_t kBlocksPerApply = 100;
+
       static expected::Result<std::shared_ptr<StorageImpl>, std::string> create(
           std::string block_store_dir,
           std::string postgres_connection,
@@ -56,7 +68,9 @@ namespace iroha {
               converter,
           std::shared_ptr<shared_model::interface::PermissionToString>
               perm_converter,
-          size_t pool_size = 10);
+          size_t pool_size = kDefaultPoolSize,
+          const BlockStoreOptions &block_store_options = BlockStoreOptions{},
+          size_t wsv_snapshot_period = kDefaultWsvSnapshotPeriod);
 
       expected::Result<std::unique_ptr<TemporaryWsv>, std::string>
       createTemporaryWsv() override;
@@ -94,8 +108,24 @@ namespace iroha {
           const std::vector<std::shared_ptr<shared_model::interface::Block>>
               &blocks) override;
 
+      bool applyStoredBlocks(
+          shared_model::interface::types::HeightType first_height) override;
+
+      boost::optional<shared_model::interface::types::HeightType>
+      restoreWsvSnapshot() override;
+
+      /**
+       * Copy WSV to the snapshot tables, replacing the previous snapshot. The
+       * snapshot is tagged with the height and the hash of the top block
+       * committed to WSV. Block index tables are not copied
+       * @return true if the snapshot is taken
+       */
+      bool createWsvSnapshot();
+
       void reset() override;
 
+      void resetWsv() override;
+
       void dropStorage() override;
 
       void freeConnections() override;
@@ -111,8 +141,14 @@ namespace iroha {
       rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
       on_commit() override;
 
+      rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
+      on_pre_commit() override;
+
       void prepareBlock(std::unique_ptr<TemporaryWsv> wsv) override;
 
+      void prepareBlockAsync(std::unique_ptr<TemporaryWsv> wsv,
+                             PreparationWork work) override;
+
       ~StorageImpl() override;
 
      protected:
@@ -127,6 +163,7 @@ namespace iroha {
                   std::shared_ptr<shared_model::interface::PermissionToString>
                       perm_converter,
                   size_t pool_size,
+                  size_t wsv_snapshot_period,
                   bool enable_prepared_blocks,
                   logger::Logger log = logger::log("StorageImpl"));
 
@@ -145,10 +182,43 @@ namespace iroha {
       void rollbackPrepared(soci::session &sql);
 
       /**
-       * add block to block storage
+       * Add blocks which are missing from the index of block hashes, e.g.
+       * the ones stored before the index was introduced
+       */
+      void indexBlockHashes(soci::session &sql);
+
+      /**
+       * Commit WSV changes of the mutable storage
+       * @return true if committed
+       */
+      bool commitWsv(MutableStorageImpl &storage);
+
+      /**
+       * Start taking a snapshot of WSV in background if a multiple of the
+       * snapshot period is among the committed heights
+       * @param first_height - height of the first committed block
+       * @param last_height - height of the last committed block
+       */
+      void snapshotIfDue(shared_model::interface::types::HeightType first_height,
+                         shared_model::interface::types::HeightType last_height);
+
+      /**
+       * Wait until the snapshot started by snapshotIfDue is taken
+       */
+      void waitSnapshot() const;
+
+      /**
+       * add block to block storage, subscribers of on_commit are not notified
        */
       bool storeBlock(const shared_model::interface::Block &block);
 
+      /**
+       * Wait until the state passed to prepareBlockAsync is prepared, since
+       * its transaction holds locks on the modified rows. The optional part
+       * of the work on the state is cancelled
+       */
+      void waitPreparation() const;
+
       std::unique_ptr<KeyValueStorage> block_store_;
 
       std::shared_ptr<soci::connection_pool> connection_;
@@ -158,26 +228,49 @@ namespace iroha {
       rxcpp::subjects::subject<std::shared_ptr<shared_model::interface::Block>>
           notifier_;
 
+      rxcpp::subjects::subject<std::shared_ptr<shared_model::interface::Block>>
+          pre_commit_notifier_;
+
       std::shared_ptr<shared_model::interface::BlockJsonConverter> converter_;
 
       std::shared_ptr<shared_model::interface::PermissionToString>
           perm_converter_;
 
+      /// signatories of the committed state, dropped when they are changed
+      std::shared_ptr<SignatoryCache> signatory_cache_;
+
       logger::Logger log_;
 
       mutable std::shared_timed_mutex drop_mutex;
 
       size_t pool_size_;
 
+      const size_t wsv_snapshot_period_;
+
       bool prepared_blocks_enabled_;
 
       std::atomic<bool> block_is_prepared;
 
       std::string prepared_block_name_;
 
+      /// state being prepared in background
+      std::shared_future<void> preparation_;
+      /// set when the state being prepared is needed
+      std::shared_ptr<std::atomic<bool>> preparation_cancelled_;
+      mutable std::mutex preparation_mutex_;
+
+      /// snapshot of WSV being taken in background
+      std::shared_future<void> snapshot_;
+      mutable std::mutex snapshot_mutex_;
+      /// a committed prepared block and its index become visible to the
+      /// snapshot together, since they are written by separate transactions
+      std::mutex prepared_commit_mutex_;
+
      protected:
       static const std::string &drop_;
       static const std::string &reset_;
+      static const std::string &reset_wsv_;
+      static const std::string &reset_snapshot_;
       static const std::string &init_;
     };
   }  // namespace ametsuchi
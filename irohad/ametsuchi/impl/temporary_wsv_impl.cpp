@@ -5,7 +5,11 @@
 
 #include "ametsuchi/impl/temporary_wsv_impl.hpp"
 
-#include <boost/format.hpp>
+#include <algorithm>
+
+#include <boost/algorithm/cxx11/all_of.hpp>
+#include "ametsuchi/impl/cached_command_executor.hpp"
+#include "ametsuchi/impl/in_memory_temporary_wsv.hpp"
 #include "ametsuchi/impl/postgres_command_executor.hpp"
 #include "cryptography/public_key.hpp"
 #include "interfaces/commands/command.hpp"
@@ -19,10 +23,15 @@ namespace iroha {
         std::shared_ptr<shared_model::interface::CommonObjectsFactory> factory,
         std::shared_ptr<shared_model::interface::PermissionToString>
             perm_converter,
+        std::shared_ptr<SignatoryCache> signatory_cache,
         logger::Logger log)
         : sql_(std::move(sql)),
-          command_executor_(std::make_unique<PostgresCommandExecutor>(
-              *sql_, std::move(perm_converter))),
+          cache_(std::make_unique<WsvCache>(*sql_)),
+          command_executor_(std::make_unique<CachedCommandExecutor>(
+              *cache_,
+              std::make_unique<PostgresCommandExecutor>(
+                  *sql_, std::move(perm_converter)))),
+          signatory_cache_(std::move(signatory_cache)),
           log_(std::move(log)) {
       *sql_ << "BEGIN";
     }
@@ -30,34 +39,17 @@ namespace iroha {
     expected::Result<void, validation::CommandError>
     TemporaryWsvImpl::validateSignatures(
         const shared_model::interface::Transaction &transaction) {
-      auto keys_range = transaction.signatures()
-          | boost::adaptors::transformed(
-                            [](const auto &s) { return s.publicKey().hex(); });
-      auto keys = std::accumulate(
-          std::next(std::begin(keys_range)),
-          std::end(keys_range),
-          keys_range.front(),
-          [](auto acc, const auto &val) { return acc + "'), ('" + val; });
-      // not using bool since it is not supported by SOCI
-      boost::optional<uint8_t> signatories_valid;
-
-      boost::format query(R"(SELECT sum(count) = :signatures_count
-                          AND sum(quorum) <= :signatures_count
-                  FROM
-                      (SELECT count(public_key)
-                      FROM ( VALUES ('%s') ) AS CTE1(public_key)
-                      WHERE public_key IN
-                          (SELECT public_key
-                          FROM account_has_signatory
-                          WHERE account_id = :account_id ) ) AS CTE2(count),
-                          (SELECT quorum
-                          FROM account
-                          WHERE account_id = :account_id) AS CTE3(quorum))");
-
+      const auto &account_id = transaction.creatorAccountId();
+      boost::optional<std::shared_ptr<const SignatoryCache::AccountSignatories>>
+          signatories;
       try {
-        *sql_ << (query % keys).str(), soci::into(signatories_valid),
-            soci::use(boost::size(keys_range), "signatures_count"),
-            soci::use(transaction.creatorAccountId(), "account_id");
+        if (changed_signatories_.count(account_id) == 0) {
+          signatories = signatory_cache_->get(account_id, *sql_);
+        } else if (auto loaded = SignatoryCache::load(*sql_, account_id)) {
+          signatories =
+              std::make_shared<const SignatoryCache::AccountSignatories>(
+                  std::move(*loaded));
+        }
       } catch (const std::exception &e) {
         auto error_str = "Transaction " + transaction.toString()
             + " failed signatures validation with db error: " + e.what();
@@ -67,7 +59,8 @@ namespace iroha {
             "signatures validation", 1, error_str, false});
       }
 
-      if (signatories_valid and *signatories_valid) {
+      if (signatories
+          and (*signatories)->isSignedBy(transaction.signatures())) {
         return {};
       } else {
         auto error_str = "Transaction " + transaction.toString()
@@ -84,49 +77,162 @@ namespace iroha {
       const auto &tx_creator = transaction.creatorAccountId();
       command_executor_->setCreatorAccountId(tx_creator);
       command_executor_->doValidation(true);
-      auto execute_command =
-          [this](auto &command) -> expected::Result<void, CommandError> {
-        // Validate and execute command
-        return boost::apply_visitor(*command_executor_, command.get());
-      };
-
-      auto savepoint_wrapper = createSavepoint("savepoint_temp_wsv");
-
-      return validateSignatures(transaction) |
-                 [savepoint = std::move(savepoint_wrapper),
-                  &execute_command,
-                  &transaction]()
-                 -> expected::Result<void, validation::CommandError> {
+      auto execute_commands =
+          [this,
+           &transaction]() -> expected::Result<void, validation::CommandError> {
         // check transaction's commands validity
         const auto &commands = transaction.commands();
-        validation::CommandError cmd_error;
         for (size_t i = 0; i < commands.size(); ++i) {
-          // in case of failed command, rollback and return
-          auto cmd_is_valid =
-              execute_command(commands[i])
-                  .match([](expected::Value<void> &) { return true; },
-                         [i, &cmd_error](expected::Error<CommandError> &error) {
-                           cmd_error = {error.error.command_name,
-                                        error.error.error_code,
-                                        error.error.error_extra,
-                                        true,
-                                        i};
-                           return false;
-                         });
-          if (not cmd_is_valid) {
-            return expected::makeError(cmd_error);
+          // Validate and execute command
+          auto result =
+              boost::apply_visitor(*command_executor_, commands[i].get());
+          if (auto error = boost::get<expected::Error<CommandError>>(&result)) {
+            return expected::makeError(
+                validation::CommandError{error->error.command_name,
+                                         error->error.error_code,
+                                         error->error.error_extra,
+                                         true,
+                                         i});
           }
         }
-        // success
-        savepoint->release();
         return {};
       };
+
+      // commands executed in memory only change the cache, which undoes them
+      // by itself, so the transaction does not need a savepoint
+      if (CachedCommandExecutor::isExecutedInMemory(transaction)) {
+        return validateSignatures(transaction) |
+                   [this, &execute_commands]()
+                   -> expected::Result<void, validation::CommandError> {
+          const auto checkpoint = cache_->checkpoint();
+          auto result = execute_commands();
+          if (boost::get<expected::Error<validation::CommandError>>(&result)) {
+            cache_->rollback(checkpoint);
+          }
+          return result;
+        };
+      }
+
+      // signatories are changed in the database, so the committed ones are
+      // not valid for this wsv anymore
+      for (const auto &command : transaction.commands()) {
+        if (auto account_id = SignatoryCache::changedAccount(command)) {
+          changed_signatories_.insert(*account_id);
+        }
+      }
+
+      // commands executed by the database have to see the cached changes,
+      // which are flushed before the savepoint, so that a rollback to it does
+      // not discard changes of previous transactions
+      auto flushed = flushCache();
+      if (auto error = boost::get<expected::Error<validation::CommandError>>(
+              &flushed)) {
+        return *error;
+      }
+      auto savepoint_wrapper = std::make_unique<SavepointWrapperImpl>(
+          *this, "savepoint_temp_wsv");
+      auto issued = issueSavepoints();
+      if (auto error =
+              boost::get<expected::Error<validation::CommandError>>(&issued)) {
+        return *error;
+      }
+
+      return validateSignatures(transaction) |
+                 [savepoint = std::move(savepoint_wrapper), &execute_commands]()
+                 -> expected::Result<void, validation::CommandError> {
+        auto result = execute_commands();
+        if (boost::get<expected::Value<void>>(&result)) {
+          savepoint->release();
+        }
+        return result;
+      };
     }
 
     std::unique_ptr<TemporaryWsv::SavepointWrapper>
     TemporaryWsvImpl::createSavepoint(const std::string &name) {
-      return std::make_unique<TemporaryWsvImpl::SavepointWrapperImpl>(
-          SavepointWrapperImpl(*this, name));
+      // the savepoint may be issued later, when the database has to be in
+      // the state of the savepoint creation, so previous changes are flushed
+      flushCache().match([](expected::Value<void> &) {},
+                         [this](expected::Error<validation::CommandError> &e) {
+                           log_->error(e.error.error_extra);
+                         });
+      return std::make_unique<TemporaryWsvImpl::SavepointWrapperImpl>(*this,
+                                                                      name);
+    }
+
+    std::unique_ptr<TemporaryWsv> TemporaryWsvImpl::fork(
+        const std::vector<
+            shared_model::interface::types::TransactionsCollectionType>
+            &batches) {
+      auto in_memory = [](const auto &batch) {
+        return boost::algorithm::all_of(batch, [](const auto &transaction) {
+          return CachedCommandExecutor::isExecutedInMemory(transaction);
+        });
+      };
+      if (not boost::algorithm::all_of(batches, in_memory)) {
+        return nullptr;
+      }
+
+      WsvCache::Keys keys;
+      InMemoryTemporaryWsv::SignaturesResults signatures;
+      for (const auto &batch : batches) {
+        for (const auto &transaction : batch) {
+          CachedCommandExecutor::collectKeys(transaction, keys);
+          signatures.emplace(transaction.hash(),
+                             validateSignatures(transaction));
+        }
+      }
+
+      try {
+        return std::make_unique<InMemoryTemporaryWsv>(cache_->fork(keys),
+                                                      std::move(signatures));
+      } catch (const std::exception &e) {
+        log_->error("Failed to fork temporary wsv: {}", e.what());
+        return nullptr;
+      }
+    }
+
+    void TemporaryWsvImpl::join(TemporaryWsv &fork) {
+      cache_->join(*static_cast<InMemoryTemporaryWsv &>(fork).cache_);
+    }
+
+    expected::Result<void, validation::CommandError>
+    TemporaryWsvImpl::flushCache() {
+      if (cache_->changes() == 0) {
+        return {};
+      }
+      auto issued = issueSavepoints();
+      if (boost::get<expected::Error<validation::CommandError>>(&issued)) {
+        return issued;
+      }
+      try {
+        cache_->flush();
+        return {};
+      } catch (const std::exception &e) {
+        cache_->clear();
+        return expected::makeError(validation::CommandError{
+            "cache flush",
+            1,
+            std::string("Failed to write cached changes: ") + e.what(),
+            false});
+      }
+    }
+
+    expected::Result<void, validation::CommandError>
+    TemporaryWsvImpl::issueSavepoints() {
+      try {
+        for (auto savepoint : unissued_savepoints_) {
+          savepoint->issue();
+        }
+        unissued_savepoints_.clear();
+        return {};
+      } catch (const std::exception &e) {
+        return expected::makeError(validation::CommandError{
+            "savepoint",
+            1,
+            std::string("Failed to create savepoint: ") + e.what(),
+            false});
+      }
     }
 
     TemporaryWsvImpl::~TemporaryWsvImpl() {
@@ -138,13 +244,19 @@ namespace iroha {
     }
 
     TemporaryWsvImpl::SavepointWrapperImpl::SavepointWrapperImpl(
-        const iroha::ametsuchi::TemporaryWsvImpl &wsv,
-        std::string savepoint_name)
-        : sql_{*wsv.sql_},
+        TemporaryWsvImpl &wsv, std::string savepoint_name)
+        : wsv_{wsv},
+          checkpoint_{wsv_.cache_->checkpoint()},
           savepoint_name_{std::move(savepoint_name)},
           is_released_{false},
+          is_issued_{false},
           log_(logger::log("Temporary wsv's savepoint wrapper")) {
-      sql_ << "SAVEPOINT " + savepoint_name_ + ";";
+      wsv_.unissued_savepoints_.push_back(this);
+    }
+
+    void TemporaryWsvImpl::SavepointWrapperImpl::issue() {
+      *wsv_.sql_ << "SAVEPOINT " + savepoint_name_ + ";";
+      is_issued_ = true;
     }
 
     void TemporaryWsvImpl::SavepointWrapperImpl::release() {
@@ -152,11 +264,17 @@ namespace iroha {
     }
 
     TemporaryWsvImpl::SavepointWrapperImpl::~SavepointWrapperImpl() {
+      auto &unissued = wsv_.unissued_savepoints_;
+      unissued.erase(std::remove(unissued.begin(), unissued.end(), this),
+                     unissued.end());
       try {
         if (not is_released_) {
-          sql_ << "ROLLBACK TO SAVEPOINT " + savepoint_name_ + ";";
-        } else {
-          sql_ << "RELEASE SAVEPOINT " + savepoint_name_ + ";";
+          wsv_.cache_->rollback(checkpoint_);
+          if (is_issued_) {
+            *wsv_.sql_ << "ROLLBACK TO SAVEPOINT " + savepoint_name_ + ";";
+          }
+        } else if (is_issued_) {
+          *wsv_.sql_ << "RELEASE SAVEPOINT " + savepoint_name_ + ";";
         }
       } catch (std::exception &e) {
         log_->error("SQL error. Reason: {}", e.what());
@@ -8,8 +8,12 @@
 
 #include "ametsuchi/temporary_wsv.hpp"
 
+#include <unordered_set>
+
 #include <soci/soci.h>
 #include "ametsuchi/command_executor.hpp"
+#include "ametsuchi/impl/signatory_cache.hpp"
+#include "ametsuchi/impl/wsv_cache.hpp"
 #include "interfaces/common_objects/common_objects_factory.hpp"
 #include "logger/logger.hpp"
 
@@ -26,8 +30,14 @@ namespace iroha {
       friend class StorageImpl;
 
      public:
+      /**
+       * Savepoint of the cache, which is issued to the database only when the
+       * database is about to be changed before the savepoint is released or
+       * rolled back. Until then the database is in the state of the
+       * savepoint, and the cache restores its state from the undo log
+       */
       struct SavepointWrapperImpl : public TemporaryWsv::SavepointWrapper {
-        SavepointWrapperImpl(const TemporaryWsvImpl &wsv,
+        SavepointWrapperImpl(TemporaryWsvImpl &wsv,
                              std::string savepoint_name);
 
         void release() override;
@@ -35,9 +45,18 @@ namespace iroha {
         ~SavepointWrapperImpl() override;
 
        private:
-        soci::session &sql_;
+        friend class TemporaryWsvImpl;
+
+        /**
+         * Create the savepoint in the database
+         */
+        void issue();
+
+        TemporaryWsvImpl &wsv_;
+        WsvCache::Checkpoint checkpoint_;
         std::string savepoint_name_;
         bool is_released_;
+        bool is_issued_;
         logger::Logger log_;
       };
 
@@ -47,6 +66,7 @@ namespace iroha {
               factory,
           std::shared_ptr<shared_model::interface::PermissionToString>
               perm_converter,
+          std::shared_ptr<SignatoryCache> signatory_cache,
           logger::Logger log = logger::log("TemporaryWSV"));
 
       expected::Result<void, validation::CommandError> apply(
@@ -55,18 +75,52 @@ namespace iroha {
       std::unique_ptr<TemporaryWsv::SavepointWrapper> createSavepoint(
           const std::string &name) override;
 
+      /**
+       * Signatures are validated on the session during the fork, and values
+       * used by the transactions are copied from the cache
+       * @return InMemoryTemporaryWsv, nullptr if any of the transactions has
+       * a command which is not executed in memory
+       */
+      std::unique_ptr<TemporaryWsv> fork(
+          const std::vector<
+              shared_model::interface::types::TransactionsCollectionType>
+              &batches) override;
+
+      void join(TemporaryWsv &fork) override;
+
       ~TemporaryWsvImpl() override;
 
      private:
       /**
        * Verifies whether transaction has at least quorum signatures and they
-       * are a subset of creator account signatories
+       * are a subset of creator account signatories. Signatories are taken
+       * from the cache of the committed state, unless they may have been
+       * changed by this wsv
        */
       expected::Result<void, validation::CommandError> validateSignatures(
           const shared_model::interface::Transaction &transaction);
 
+      /**
+       * Write changes kept by the cache to the database, so that statements
+       * which bypass the cache see them
+       */
+      expected::Result<void, validation::CommandError> flushCache();
+
+      /**
+       * Issue the savepoints which are not in the database yet, has to be
+       * called before the database is changed
+       */
+      expected::Result<void, validation::CommandError> issueSavepoints();
+
       std::unique_ptr<soci::session> sql_;
+      std::unique_ptr<WsvCache> cache_;
       std::unique_ptr<CommandExecutor> command_executor_;
+      std::shared_ptr<SignatoryCache> signatory_cache_;
+      /// accounts whose signatories or quorum may differ from the cached ones
+      std::unordered_set<shared_model::interface::types::AccountIdType>
+          changed_signatories_;
+      /// savepoints which are not issued yet, in order of creation
+      std::vector<SavepointWrapperImpl *> unissued_savepoints_;
 
       logger::Logger log_;
     };
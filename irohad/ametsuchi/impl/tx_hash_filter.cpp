@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/tx_hash_filter.hpp"
+
+#include <algorithm>
+
+namespace {
+  /// Odd multipliers which select a bit in each word of a block
+  const uint32_t kSalt[] = {0x47b6137bU,
+                            0x44974d91U,
+                            0x8824ad5bU,
+                            0xa2b7289dU,
+                            0x705495c7U,
+                            0x2df1424bU,
+                            0x9efc4947U,
+                            0x5c6bfb31U};
+
+  /**
+   * Mix bytes of the hash into a 64-bit key. Transaction hashes are uniform
+   * already, but the key must be well distributed for any input
+   */
+  uint64_t keyOf(const shared_model::crypto::Hash &hash) {
+    // FNV-1a followed by the splitmix64 finalizer
+    uint64_t key = 0xcbf29ce484222325ULL;
+    for (auto byte : hash.blob()) {
+      key = (key ^ byte) * 0x100000001b3ULL;
+    }
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+  }
+
+  uint32_t maskOf(uint64_t key, size_t word) {
+    return 1U << ((static_cast<uint32_t>(key) * kSalt[word]) >> 27);
+  }
+}  // namespace
+
+namespace iroha {
+  namespace ametsuchi {
+
+    constexpr size_t TxHashFilter::kBitsPerItem;
+    constexpr size_t TxHashFilter::kWordsPerBlock;
+
+    TxHashFilter::TxHashFilter(size_t capacity)
+        : capacity_(capacity),
+          blocks_(std::max<size_t>(
+              1, capacity * kBitsPerItem / (kWordsPerBlock * 32))),
+          words_(new std::atomic<uint32_t>[blocks_ * kWordsPerBlock]),
+          size_(0) {
+      std::fill(words_.get(), words_.get() + blocks_ * kWordsPerBlock, 0);
+    }
+
+    void TxHashFilter::add(const shared_model::crypto::Hash &hash) {
+      auto key = keyOf(hash);
+      auto block = blockOf(key);
+      for (size_t i = 0; i < kWordsPerBlock; ++i) {
+        words_[block + i].fetch_or(maskOf(key, i), std::memory_order_relaxed);
+      }
+      ++size_;
+    }
+
+    bool TxHashFilter::mayContain(
+        const shared_model::crypto::Hash &hash) const {
+      auto key = keyOf(hash);
+      auto block = blockOf(key);
+      for (size_t i = 0; i < kWordsPerBlock; ++i) {
+        auto mask = maskOf(key, i);
+        if ((words_[block + i].load(std::memory_order_relaxed) & mask)
+            != mask) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    size_t TxHashFilter::size() const {
+      return size_;
+    }
+
+    size_t TxHashFilter::capacity() const {
+      return capacity_;
+    }
+
+    size_t TxHashFilter::blockOf(uint64_t key) const {
+      // upper half of the key selects the block, lower half selects the bits
+      return static_cast<size_t>(((key >> 32) * blocks_) >> 32)
+          * kWordsPerBlock;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
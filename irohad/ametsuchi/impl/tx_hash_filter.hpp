@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_TX_HASH_FILTER_HPP
+#define IROHA_TX_HASH_FILTER_HPP
+
+#include <atomic>
+#include <memory>
+
+#include "cryptography/hash.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Approximate set of transaction hashes, split block Bloom filter. Every
+     * hash sets one bit in each word of a single 256-bit block, so a lookup
+     * touches one cache line. The filter may report presence of a hash which
+     * was never added, but never misses an added one. Hashes can be added
+     * concurrently with lookups.
+     */
+    class TxHashFilter {
+     public:
+      /// Filter size per expected item, gives about 0.5% of false positives
+      static constexpr size_t kBitsPerItem = 16;
+
+      /**
+       * @param capacity - number of items the filter is sized for. More items
+       * can be added at the cost of more false positives
+       */
+      explicit TxHashFilter(size_t capacity);
+
+      /**
+       * Add the hash to the set
+       */
+      void add(const shared_model::crypto::Hash &hash);
+
+      /**
+       * @return false if the hash was definitely not added, true if it
+       * probably was
+       */
+      bool mayContain(const shared_model::crypto::Hash &hash) const;
+
+      /**
+       * @return number of added hashes
+       */
+      size_t size() const;
+
+      /**
+       * @return number of items the filter is sized for
+       */
+      size_t capacity() const;
+
+     private:
+      static constexpr size_t kWordsPerBlock = 8;
+
+      /**
+       * @return index of the first word of the block the key falls into
+       */
+      size_t blockOf(uint64_t key) const;
+
+      const size_t capacity_;
+      const size_t blocks_;
+      std::unique_ptr<std::atomic<uint32_t>[]> words_;
+      std::atomic<size_t> size_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_TX_HASH_FILTER_HPP
@@ -7,19 +7,60 @@
 
 #include "common/bind.hpp"
 #include "common/visitor.hpp"
+#include "interfaces/iroha_internal/block.hpp"
 #include "interfaces/iroha_internal/transaction_batch.hpp"
 #include "interfaces/transaction.hpp"
 
 namespace iroha {
   namespace ametsuchi {
-    TxPresenceCacheImpl::TxPresenceCacheImpl(std::shared_ptr<Storage> storage)
-        : storage_(std::move(storage)) {}
+    constexpr size_t TxPresenceCacheImpl::kInitialFilterCapacity;
+
+    TxPresenceCacheImpl::TxPresenceCacheImpl(std::shared_ptr<Storage> storage,
+                                             bool use_filter,
+                                             size_t filter_capacity,
+                                             logger::Logger log)
+        : storage_(std::move(storage)), log_(std::move(log)) {
+      if (not use_filter) {
+        return;
+      }
+      // subscribe before loading, so that no commit is missed. Hashes are
+      // added before the commit, otherwise they would be reported as missing
+      // while they are already in the storage
+      storage_->on_pre_commit().subscribe(
+          pre_commit_subscription_,
+          [this](const auto &block) { this->updateFilter(*block); });
+      storage_->on_commit().subscribe(
+          commit_subscription_,
+          [this](const auto &block) { this->confirmCommit(*block); });
+
+      std::lock_guard<std::mutex> lock(filter_update_mutex_);
+      auto filter = loadFilter(filter_capacity);
+      if (filter) {
+        log_->info("Loaded {} transaction hashes into the filter",
+                   filter->size());
+      } else {
+        log_->warn("Failed to load transaction hashes into the filter");
+      }
+      std::atomic_store(&filter_, filter);
+    }
+
+    TxPresenceCacheImpl::~TxPresenceCacheImpl() {
+      pre_commit_subscription_.unsubscribe();
+      commit_subscription_.unsubscribe();
+      std::shared_future<void> rebuild;
+      {
+        std::lock_guard<std::mutex> lock(filter_update_mutex_);
+        rebuild = rebuild_;
+      }
+      if (rebuild.valid()) {
+        rebuild.wait();
+      }
+    }
 
     boost::optional<TxCacheStatusType> TxPresenceCacheImpl::check(
         const shared_model::crypto::Hash &hash) const {
-      auto res = memory_cache_.findItem(hash);
-      if (res) {
-        return *res;
+      if (auto status = checkInMemory(hash)) {
+        return status;
       }
       return checkInStorage(hash);
     }
@@ -27,15 +68,80 @@ namespace iroha {
     boost::optional<TxPresenceCache::BatchStatusCollectionType>
     TxPresenceCacheImpl::check(
         const shared_model::interface::TransactionBatch &batch) const {
-      TxPresenceCache::BatchStatusCollectionType batch_statuses;
+      std::vector<shared_model::crypto::Hash> hashes;
+      hashes.reserve(batch.transactions().size());
       for (const auto &tx : batch.transactions()) {
-        if (auto status = check(tx->hash())) {
-          batch_statuses.emplace_back(*status);
-        } else {
+        hashes.push_back(tx->hash());
+      }
+      return check(hashes);
+    }
+
+    boost::optional<TxPresenceCache::BatchStatusCollectionType>
+    TxPresenceCacheImpl::check(
+        const std::vector<shared_model::crypto::Hash> &hashes) const {
+      std::vector<boost::optional<TxCacheStatusType>> known;
+      known.reserve(hashes.size());
+      std::vector<shared_model::crypto::Hash> unknown_hashes;
+      for (const auto &hash : hashes) {
+        known.push_back(checkInMemory(hash));
+        if (not known.back()) {
+          unknown_hashes.push_back(hash);
+        }
+      }
+
+      boost::optional<BatchStatusCollectionType> stored =
+          BatchStatusCollectionType{};
+      if (not unknown_hashes.empty()) {
+        auto block_query = storage_->getBlockQuery();
+        if (not block_query) {
+          return boost::none;
+        }
+        stored = block_query->checkTxsPresence(unknown_hashes);
+        if (not stored or stored->size() != unknown_hashes.size()) {
           return boost::none;
         }
       }
-      return batch_statuses;
+
+      // statuses from the storage follow the order of unknown hashes
+      BatchStatusCollectionType statuses;
+      statuses.reserve(hashes.size());
+      auto stored_status = stored->begin();
+      for (size_t i = 0; i < hashes.size(); ++i) {
+        if (auto &status = known[i]) {
+          statuses.push_back(std::move(*status));
+        } else {
+          remember(hashes[i], *stored_status);
+          statuses.push_back(std::move(*stored_status++));
+        }
+      }
+      return statuses;
+    }
+
+    boost::optional<TxCacheStatusType> TxPresenceCacheImpl::checkInMemory(
+        const shared_model::crypto::Hash &hash) const {
+      auto res = memory_cache_.findItem(hash);
+      if (res) {
+        return *res;
+      }
+      auto filter = std::atomic_load(&filter_);
+      if (filter and not filter->mayContain(hash)) {
+        return boost::make_optional<TxCacheStatusType>(
+            tx_cache_status_responses::Missing{hash});
+      }
+      return boost::none;
+    }
+
+    void TxPresenceCacheImpl::remember(
+        const shared_model::crypto::Hash &hash,
+        const TxCacheStatusType &status) const {
+      visit_in_place(status,
+                     [](const tx_cache_status_responses::Missing &) {
+                       // don't put this hash into cache since "Missing"
+                       // can become "Committed" or "Rejected" later
+                     },
+                     [this, &hash](const auto &status) {
+                       memory_cache_.addItem(hash, status);
+                     });
     }
 
     boost::optional<TxCacheStatusType> TxPresenceCacheImpl::checkInStorage(
@@ -46,16 +152,96 @@ namespace iroha {
       }
       return block_query->checkTxPresence(hash) |
           [this, &hash](const auto &status) {
-            visit_in_place(status,
-                           [](const tx_cache_status_responses::Missing &) {
-                             // don't put this hash into cache since "Missing"
-                             // can become "Committed" or "Rejected" later
-                           },
-                           [this, &hash](const auto &status) {
-                             memory_cache_.addItem(hash, status);
-                           });
-            return status;
-          };
+        this->remember(hash, status);
+        return status;
+      };
+    }
+
+    std::shared_ptr<TxHashFilter> TxPresenceCacheImpl::loadFilter(
+        size_t capacity) const {
+      auto block_query = storage_->getBlockQuery();
+      if (not block_query) {
+        return nullptr;
+      }
+      auto filter = std::make_shared<TxHashFilter>(capacity);
+      auto count = block_query->forEachTxHash(
+          [&filter](const auto &hash) { filter->add(hash); });
+      if (not count) {
+        return nullptr;
+      }
+      if (*count > capacity) {
+        return loadFilter(2 * *count);
+      }
+      return filter;
+    }
+
+    void TxPresenceCacheImpl::updateFilter(
+        const shared_model::interface::Block &block) {
+      std::vector<shared_model::crypto::Hash> hashes;
+      for (const auto &tx : block.transactions()) {
+        hashes.push_back(tx.hash());
+      }
+      for (const auto &hash : block.rejected_transactions_hashes()) {
+        hashes.push_back(hash);
+      }
+
+      std::lock_guard<std::mutex> lock(filter_update_mutex_);
+      uncommitted_[block.height()] = hashes;
+      // a full filter still has no false negatives, it is used until the
+      // rebuilt one is published
+      auto filter = std::atomic_load(&filter_);
+      if (filter) {
+        for (const auto &hash : hashes) {
+          filter->add(hash);
+        }
+      }
+      if (rebuilding_) {
+        rebuild_pending_.insert(
+            rebuild_pending_.end(), hashes.begin(), hashes.end());
+      } else if (not filter or filter->size() >= filter->capacity()) {
+        rebuildFilter(filter ? 2 * filter->size() : kInitialFilterCapacity);
+      }
+    }
+
+    void TxPresenceCacheImpl::confirmCommit(
+        const shared_model::interface::Block &block) {
+      std::lock_guard<std::mutex> lock(filter_update_mutex_);
+      uncommitted_.erase(uncommitted_.begin(),
+                         uncommitted_.upper_bound(block.height()));
+    }
+
+    void TxPresenceCacheImpl::rebuildFilter(size_t capacity) {
+      // the storage may not have hashes of the blocks which are being
+      // committed while the filter is loaded
+      rebuilding_ = true;
+      rebuild_pending_.clear();
+      for (const auto &block : uncommitted_) {
+        rebuild_pending_.insert(
+            rebuild_pending_.end(), block.second.begin(), block.second.end());
+      }
+
+      // loading takes time proportional to the number of stored hashes, so it
+      // is not done on the commit path
+      rebuild_ = std::async(std::launch::async, [this, capacity] {
+                   auto filter = loadFilter(capacity);
+                   std::lock_guard<std::mutex> lock(filter_update_mutex_);
+                   if (filter) {
+                     for (const auto &hash : rebuild_pending_) {
+                       filter->add(hash);
+                     }
+                     // a new filter is published only when it has all the
+                     // hashes
+                     std::atomic_store(&filter_, filter);
+                     log_->info(
+                         "Reloaded {} transaction hashes into the filter",
+                         filter->size());
+                   } else {
+                     log_->warn(
+                         "Failed to reload transaction hashes into the filter");
+                   }
+                   rebuild_pending_.clear();
+                   rebuilding_ = false;
+                 }).share();
     }
   }  // namespace ametsuchi
 }  // namespace iroha
@@ -6,16 +6,41 @@
 #ifndef IROHA_TX_PRESENCE_CACHE_IMPL_HPP
 #define IROHA_TX_PRESENCE_CACHE_IMPL_HPP
 
+#include <future>
+#include <map>
+#include <mutex>
+
+#include "ametsuchi/impl/tx_hash_filter.hpp"
 #include "ametsuchi/storage.hpp"
 #include "ametsuchi/tx_presence_cache.hpp"
 #include "cache/cache.hpp"
+#include "logger/logger.hpp"
 
 namespace iroha {
   namespace ametsuchi {
 
     class TxPresenceCacheImpl : public TxPresenceCache {
      public:
-      explicit TxPresenceCacheImpl(std::shared_ptr<Storage> storage);
+      /// Initial number of hashes the filter is sized for
+      static constexpr size_t kInitialFilterCapacity = 1 << 20;
+
+      /**
+       * @param storage - storage to check transactions in
+       * @param use_filter - whether to keep a filter of all committed and
+       * rejected hashes. It is loaded from the storage and updated before
+       * every commit, hashes which are definitely not in it are reported as
+       * missing without a storage query
+       * @param filter_capacity - number of hashes the filter is initially
+       * sized for
+       * @param log to print progress
+       */
+      explicit TxPresenceCacheImpl(
+          std::shared_ptr<Storage> storage,
+          bool use_filter = false,
+          size_t filter_capacity = kInitialFilterCapacity,
+          logger::Logger log = logger::log("TxPresenceCache"));
+
+      ~TxPresenceCacheImpl();
 
       boost::optional<TxCacheStatusType> check(
           const shared_model::crypto::Hash &hash) const override;
@@ -24,7 +49,25 @@ namespace iroha {
           const shared_model::interface::TransactionBatch &batch)
           const override;
 
+      boost::optional<BatchStatusCollectionType> check(
+          const std::vector<shared_model::crypto::Hash> &hashes)
+          const override;
+
      private:
+      /**
+       * Find status of the hash without a storage query
+       * @return status if it is cached or the hash is definitely missing,
+       * boost::none otherwise
+       */
+      boost::optional<TxCacheStatusType> checkInMemory(
+          const shared_model::crypto::Hash &hash) const;
+
+      /**
+       * Put committed and rejected statuses into the memory cache
+       */
+      void remember(const shared_model::crypto::Hash &hash,
+                    const TxCacheStatusType &status) const;
+
       /**
        * Performs an actual storage request about hash status
        * @param hash to check
@@ -34,7 +77,49 @@ namespace iroha {
       boost::optional<TxCacheStatusType> checkInStorage(
           const shared_model::crypto::Hash &hash) const;
 
+      /**
+       * Create a filter of all hashes in the storage
+       * @param capacity - number of hashes to size the filter for. If the
+       * storage has more, the filter is loaded again for twice as many
+       * @return filter or nullptr if the storage query failed
+       */
+      std::shared_ptr<TxHashFilter> loadFilter(size_t capacity) const;
+
+      /**
+       * Add hashes of the block being committed to the filter, and start
+       * rebuilding the filter in background when it is full
+       */
+      void updateFilter(const shared_model::interface::Block &block);
+
+      /**
+       * Forget hashes of the committed block and the blocks below it, which
+       * are visible in the storage now
+       */
+      void confirmCommit(const shared_model::interface::Block &block);
+
+      /**
+       * Load a new filter in background and publish it when it has all the
+       * hashes, filter update mutex must be held
+       * @param capacity - number of hashes to size the filter for
+       */
+      void rebuildFilter(size_t capacity);
+
       std::shared_ptr<Storage> storage_;
+      /// accessed atomically, nullptr when the filter is not used
+      std::shared_ptr<TxHashFilter> filter_;
+      /// guards the members below
+      std::mutex filter_update_mutex_;
+      /// hashes of blocks which may be not visible in the storage yet
+      std::map<shared_model::interface::types::HeightType,
+               std::vector<shared_model::crypto::Hash>>
+          uncommitted_;
+      /// hashes to add to the filter being rebuilt, which it may not load
+      std::vector<shared_model::crypto::Hash> rebuild_pending_;
+      bool rebuilding_ = false;
+      std::shared_future<void> rebuild_;
+      rxcpp::composite_subscription pre_commit_subscription_;
+      rxcpp::composite_subscription commit_subscription_;
+      logger::Logger log_;
       mutable cache::Cache<shared_model::crypto::Hash,
                            TxCacheStatusType,
                            shared_model::crypto::Hash::Hasher>
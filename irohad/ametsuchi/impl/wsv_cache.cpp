@@ -0,0 +1,350 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/wsv_cache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+
+#include <soci/boost-tuple.h>
+#include <boost/format.hpp>
+#include "ametsuchi/impl/soci_utils.hpp"
+#include "interfaces/common_objects/amount.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using shared_model::interface::types::AccountIdType;
+    using shared_model::interface::types::AssetIdType;
+    using shared_model::interface::types::PrecisionType;
+
+    Decimal::Decimal(ValueType value, PrecisionType scale)
+        : value_(std::move(value)), scale_(scale) {}
+
+    Decimal::Decimal(const shared_model::interface::Amount &amount)
+        : value_(amount.intValue()), scale_(amount.precision()) {}
+
+    Decimal Decimal::fromString(const std::string &str) {
+      auto begin = str.begin();
+      const bool negative = begin != str.end() and *begin == '-';
+      if (negative) {
+        ++begin;
+      }
+      auto point = std::find(begin, str.end(), '.');
+      std::string digits(begin, point);
+      if (point != str.end()) {
+        digits.append(std::next(point), str.end());
+      }
+      if (digits.empty()
+          or not std::all_of(digits.begin(), digits.end(), ::isdigit)) {
+        throw std::invalid_argument("not a decimal number: " + str);
+      }
+      auto scale = point == str.end() ? 0 : str.end() - std::next(point);
+      // leading zeros would make the number parsed as an octal one
+      digits.erase(
+          0, std::min(digits.find_first_not_of('0'), digits.size() - 1));
+      ValueType value(digits.c_str());
+      return Decimal(negative ? -value : value,
+                     static_cast<PrecisionType>(scale));
+    }
+
+    std::string Decimal::toString() const {
+      auto digits = ValueType(boost::multiprecision::abs(value_)).str();
+      if (digits.size() <= scale_) {
+        digits.insert(0, scale_ + 1 - digits.size(), '0');
+      }
+      if (scale_ > 0) {
+        digits.insert(digits.size() - scale_, 1, '.');
+      }
+      return value_ < 0 ? "-" + digits : digits;
+    }
+
+    bool Decimal::isNegative() const {
+      return value_ < 0;
+    }
+
+    bool Decimal::lessThanPowerOfTwo(unsigned exponent) const {
+      return value_
+          < (ValueType(1) << exponent)
+          * boost::multiprecision::pow(ValueType(10), scale_);
+    }
+
+    Decimal Decimal::operator+(const Decimal &rhs) const {
+      auto scale = std::max(scale_, rhs.scale_);
+      return Decimal(rescaled(scale) + rhs.rescaled(scale), scale);
+    }
+
+    Decimal Decimal::operator-(const Decimal &rhs) const {
+      auto scale = std::max(scale_, rhs.scale_);
+      return Decimal(rescaled(scale) - rhs.rescaled(scale), scale);
+    }
+
+    Decimal::ValueType Decimal::rescaled(PrecisionType scale) const {
+      return value_
+          * boost::multiprecision::pow(ValueType(10),
+                                       static_cast<unsigned>(scale - scale_));
+    }
+
+    WsvCache::WsvCache(soci::session &sql) : sql_(&sql), generation_(0) {}
+
+    WsvCache::WsvCache() : sql_(nullptr), generation_(0) {}
+
+    bool WsvCache::accountExists(const AccountIdType &account_id) {
+      return account(account_id).exists;
+    }
+
+    const shared_model::interface::RolePermissionSet &
+    WsvCache::accountPermissions(const AccountIdType &account_id) {
+      return account(account_id).permissions;
+    }
+
+    const shared_model::interface::GrantablePermissionSet &
+    WsvCache::grantablePermissions(const AccountIdType &permittee_account_id,
+                                   const AccountIdType &account_id) {
+      KeyType key{permittee_account_id, account_id};
+      auto it = grantable_permissions_.find(key);
+      if (it != grantable_permissions_.end()) {
+        return it->second;
+      }
+
+      const auto query =
+          (boost::format(
+               "SELECT COALESCE(bit_or(permission), CAST('0' AS bit(%d))) "
+               "FROM account_has_grantable_permissions "
+               "WHERE permittee_account_id = :permittee_account_id "
+               "AND account_id = :account_id")
+           % shared_model::interface::GrantablePermissionSet::size())
+              .str();
+      std::string permissions;
+      session() << query, soci::into(permissions),
+          soci::use(permittee_account_id, "permittee_account_id"),
+          soci::use(account_id, "account_id");
+      return grantable_permissions_
+          .emplace(std::move(key),
+                   shared_model::interface::GrantablePermissionSet(permissions))
+          .first->second;
+    }
+
+    boost::optional<PrecisionType> WsvCache::assetPrecision(
+        const AssetIdType &asset_id) {
+      auto it = assets_.find(asset_id);
+      if (it != assets_.end()) {
+        return it->second;
+      }
+
+      boost::optional<int> precision;
+      session() << "SELECT precision FROM asset WHERE asset_id = :asset_id",
+          soci::into(precision), soci::use(asset_id, "asset_id");
+      boost::optional<PrecisionType> result;
+      if (precision) {
+        result = static_cast<PrecisionType>(*precision);
+      }
+      return assets_.emplace(asset_id, result).first->second;
+    }
+
+    const boost::optional<Decimal> &WsvCache::balance(
+        const AccountIdType &account_id, const AssetIdType &asset_id) {
+      return balanceEntry({account_id, asset_id}).balance;
+    }
+
+    void WsvCache::setBalance(const AccountIdType &account_id,
+                              const AssetIdType &asset_id,
+                              Decimal balance) {
+      KeyType key{account_id, asset_id};
+      auto &entry = balanceEntry(key);
+      undo_.emplace_back(std::move(key), entry);
+      entry.balance = std::move(balance);
+      entry.changed = true;
+    }
+
+    WsvCache::Checkpoint WsvCache::checkpoint() const {
+      return Checkpoint{generation_, undo_.size()};
+    }
+
+    void WsvCache::rollback(const Checkpoint &checkpoint) {
+      if (checkpoint.generation != generation_) {
+        clear();
+        return;
+      }
+      while (undo_.size() > checkpoint.undo_size) {
+        balances_.at(undo_.back().first) = std::move(undo_.back().second);
+        undo_.pop_back();
+      }
+    }
+
+    void WsvCache::flush() {
+      std::vector<std::string> accounts, assets, amounts;
+      for (auto &balance : balances_) {
+        if (balance.second.changed) {
+          accounts.push_back(balance.first.first);
+          assets.push_back(balance.first.second);
+          amounts.push_back(balance.second.balance->toString());
+        }
+      }
+
+      if (not accounts.empty()) {
+        const auto accounts_array = makeArray(accounts);
+        const auto assets_array = makeArray(assets);
+        const auto amounts_array = makeArray(amounts);
+        session() << R"(
+          INSERT INTO account_has_asset(account_id, asset_id, amount)
+          SELECT * FROM unnest(CAST(:accounts AS text[]),
+                               CAST(:assets AS text[]),
+                               CAST(:amounts AS decimal[]))
+          ON CONFLICT (account_id, asset_id)
+          DO UPDATE SET amount = EXCLUDED.amount)",
+            soci::use(accounts_array, "accounts"),
+            soci::use(assets_array, "assets"),
+            soci::use(amounts_array, "amounts");
+      }
+
+      for (auto &balance : balances_) {
+        balance.second.changed = false;
+      }
+      undo_.clear();
+      ++generation_;
+    }
+
+    void WsvCache::clear() {
+      accounts_.clear();
+      grantable_permissions_.clear();
+      assets_.clear();
+      balances_.clear();
+      undo_.clear();
+      ++generation_;
+    }
+
+    size_t WsvCache::changes() const {
+      return std::count_if(
+          balances_.begin(), balances_.end(), [](const auto &balance) {
+            return balance.second.changed;
+          });
+    }
+
+    std::unique_ptr<WsvCache> WsvCache::fork(const Keys &keys) {
+      loadAccounts(keys.accounts);
+      loadBalances(keys.balances);
+
+      auto result = std::make_unique<WsvCache>();
+      for (const auto &account_id : keys.accounts) {
+        result->accounts_.emplace(account_id, account(account_id));
+      }
+      for (const auto &key : keys.grantable_permissions) {
+        result->grantable_permissions_.emplace(
+            key, grantablePermissions(key.first, key.second));
+      }
+      for (const auto &asset_id : keys.assets) {
+        result->assets_.emplace(asset_id, assetPrecision(asset_id));
+      }
+      for (const auto &key : keys.balances) {
+        auto entry = balanceEntry(key);
+        entry.changed = false;
+        result->balances_.emplace(key, std::move(entry));
+      }
+      return result;
+    }
+
+    void WsvCache::join(const WsvCache &fork) {
+      for (const auto &balance : fork.balances_) {
+        if (balance.second.changed) {
+          setBalance(balance.first.first,
+                     balance.first.second,
+                     *balance.second.balance);
+        }
+      }
+    }
+
+    WsvCache::AccountEntry &WsvCache::account(const AccountIdType &account_id) {
+      loadAccounts({account_id});
+      return accounts_.at(account_id);
+    }
+
+    WsvCache::BalanceEntry &WsvCache::balanceEntry(const KeyType &key) {
+      loadBalances({key});
+      return balances_.at(key);
+    }
+
+    void WsvCache::loadAccounts(const std::vector<AccountIdType> &account_ids) {
+      std::vector<std::string> missing;
+      std::copy_if(account_ids.begin(),
+                   account_ids.end(),
+                   std::back_inserter(missing),
+                   [this](const auto &account_id) {
+                     return accounts_.count(account_id) == 0;
+                   });
+      if (missing.empty()) {
+        return;
+      }
+
+      const auto accounts_array = makeArray(missing);
+      const auto query = (boost::format(R"(
+          SELECT ids.account_id,
+                 (SELECT count(*) FROM account
+                  WHERE account_id = ids.account_id),
+                 (SELECT COALESCE(bit_or(rp.permission), CAST('0' AS bit(%d)))
+                  FROM role_has_permissions AS rp
+                  JOIN account_has_roles AS ar ON ar.role_id = rp.role_id
+                  WHERE ar.account_id = ids.account_id)
+          FROM unnest(CAST(:accounts AS text[])) AS ids(account_id))")
+                          % shared_model::interface::RolePermissionSet::size())
+                             .str();
+      soci::rowset<boost::tuple<std::string, int, std::string>> rows =
+          (session().prepare << query, soci::use(accounts_array, "accounts"));
+      for (const auto &row : rows) {
+        accounts_.emplace(
+            row.get<0>(),
+            AccountEntry{
+                row.get<1>() != 0,
+                shared_model::interface::RolePermissionSet(row.get<2>())});
+      }
+    }
+
+    void WsvCache::loadBalances(const std::vector<KeyType> &keys) {
+      std::vector<std::string> accounts, assets;
+      for (const auto &key : keys) {
+        if (balances_.count(key) == 0) {
+          accounts.push_back(key.first);
+          assets.push_back(key.second);
+        }
+      }
+      if (accounts.empty()) {
+        return;
+      }
+
+      const auto accounts_array = makeArray(accounts);
+      const auto assets_array = makeArray(assets);
+      soci::rowset<boost::tuple<std::string,
+                                std::string,
+                                boost::optional<std::string>>>
+          rows = (session().prepare << R"(
+          SELECT ids.account_id, ids.asset_id, aha.amount
+          FROM unnest(CAST(:accounts AS text[]), CAST(:assets AS text[]))
+              AS ids(account_id, asset_id)
+          LEFT JOIN account_has_asset AS aha
+              ON aha.account_id = ids.account_id
+              AND aha.asset_id = ids.asset_id)",
+                  soci::use(accounts_array, "accounts"),
+                  soci::use(assets_array, "assets"));
+      for (const auto &row : rows) {
+        BalanceEntry entry{boost::none, false};
+        if (row.get<2>()) {
+          entry.balance = Decimal::fromString(*row.get<2>());
+        }
+        balances_.emplace(KeyType{row.get<0>(), row.get<1>()},
+                          std::move(entry));
+      }
+    }
+
+    soci::session &WsvCache::session() {
+      if (not sql_) {
+        throw std::logic_error("value is not cached");
+      }
+      return *sql_;
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
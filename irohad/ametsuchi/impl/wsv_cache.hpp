@@ -0,0 +1,243 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_WSV_CACHE_HPP
+#define IROHA_WSV_CACHE_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <soci/soci.h>
+#include <boost/functional/hash.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/optional.hpp>
+#include "interfaces/common_objects/types.hpp"
+#include "interfaces/permissions.hpp"
+
+namespace shared_model {
+  namespace interface {
+    class Amount;
+  }
+}  // namespace shared_model
+
+namespace iroha {
+  namespace ametsuchi {
+
+    /**
+     * Fixed point number with the scale rules of PostgreSQL numeric type: the
+     * scale of a sum or a difference is the largest scale of operands. This
+     * way results of arithmetic, including their textual form, are the same
+     * as the ones computed by the database
+     */
+    class Decimal {
+     public:
+      using ValueType = boost::multiprecision::cpp_int;
+
+      Decimal(ValueType value,
+              shared_model::interface::types::PrecisionType scale);
+
+      explicit Decimal(const shared_model::interface::Amount &amount);
+
+      /**
+       * Parse textual form of a numeric value returned by the database
+       * @throws std::invalid_argument if the string is not a decimal number
+       */
+      static Decimal fromString(const std::string &str);
+
+      std::string toString() const;
+
+      bool isNegative() const;
+
+      /**
+       * @return true if the number is less than 2 ^ exponent
+       */
+      bool lessThanPowerOfTwo(unsigned exponent) const;
+
+      Decimal operator+(const Decimal &rhs) const;
+      Decimal operator-(const Decimal &rhs) const;
+
+     private:
+      /**
+       * @return value of the number multiplied by 10 ^ scale
+       */
+      ValueType rescaled(
+          shared_model::interface::types::PrecisionType scale) const;
+
+      ValueType value_;
+      shared_model::interface::types::PrecisionType scale_;
+    };
+
+    /**
+     * Write-through cache of a part of the world state used by commands
+     * executed in memory: account existence and role permissions, grantable
+     * permissions, asset precisions and balances. Values are read from the
+     * session on first access, changed balances are kept in memory until
+     * flushed to the session with a single statement. Changes can be rolled
+     * back to a checkpoint without touching the database.
+     *
+     * The cache does not observe changes made to the session by other means,
+     * so it has to be cleared after such changes, and flushed before them.
+     * Methods throw exceptions of the session on database errors.
+     */
+    class WsvCache {
+     public:
+      /// account and asset of a balance, permittee and account of a grant
+      using KeyType = std::pair<std::string, std::string>;
+
+      /**
+       * Keys of the values used by a set of commands
+       */
+      struct Keys {
+        std::vector<shared_model::interface::types::AccountIdType> accounts;
+        std::vector<KeyType> grantable_permissions;
+        std::vector<shared_model::interface::types::AssetIdType> assets;
+        std::vector<KeyType> balances;
+      };
+
+      /**
+       * State of the cache which can be restored with rollback
+       */
+      struct Checkpoint {
+        uint64_t generation;
+        size_t undo_size;
+      };
+
+      explicit WsvCache(soci::session &sql);
+
+      /**
+       * Create a cache without a session, which only has the values copied
+       * to it by fork. Reading any other value throws std::logic_error
+       */
+      WsvCache();
+
+      bool accountExists(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      /**
+       * @return union of permissions of all roles of the account, empty if the
+       * account does not exist
+       */
+      const shared_model::interface::RolePermissionSet &accountPermissions(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      /**
+       * @return permissions granted to permittee by the account
+       */
+      const shared_model::interface::GrantablePermissionSet &
+      grantablePermissions(
+          const shared_model::interface::types::AccountIdType
+              &permittee_account_id,
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      /**
+       * @return precision of the asset, none if the asset does not exist
+       */
+      boost::optional<shared_model::interface::types::PrecisionType>
+      assetPrecision(
+          const shared_model::interface::types::AssetIdType &asset_id);
+
+      /**
+       * @return balance of the account, none if the account never had the asset
+       */
+      const boost::optional<Decimal> &balance(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AssetIdType &asset_id);
+
+      void setBalance(
+          const shared_model::interface::types::AccountIdType &account_id,
+          const shared_model::interface::types::AssetIdType &asset_id,
+          Decimal balance);
+
+      Checkpoint checkpoint() const;
+
+      /**
+       * Restore the state of the checkpoint. If the cache was flushed or
+       * cleared since then, the database is expected to be rolled back to the
+       * same point, so the cache is cleared
+       */
+      void rollback(const Checkpoint &checkpoint);
+
+      /**
+       * Write changed balances to the session. Cached values are kept
+       */
+      void flush();
+
+      /**
+       * Drop all cached values, changes which were not flushed are lost
+       */
+      void clear();
+
+      /**
+       * @return number of balances changed since the last flush
+       */
+      size_t changes() const;
+
+      /**
+       * Load the values of the keys which are not cached yet, with a single
+       * statement per kind of value, and copy them to a new cache without a
+       * session. The new cache can be used in another thread, as long as
+       * this one is not accessed until join
+       */
+      std::unique_ptr<WsvCache> fork(const Keys &keys);
+
+      /**
+       * Set balances changed by the fork since it was created
+       */
+      void join(const WsvCache &fork);
+
+     private:
+      struct AccountEntry {
+        bool exists;
+        shared_model::interface::RolePermissionSet permissions;
+      };
+
+      struct BalanceEntry {
+        boost::optional<Decimal> balance;
+        bool changed;
+      };
+
+      AccountEntry &account(
+          const shared_model::interface::types::AccountIdType &account_id);
+
+      BalanceEntry &balanceEntry(const KeyType &key);
+
+      void loadAccounts(
+          const std::vector<shared_model::interface::types::AccountIdType>
+              &account_ids);
+
+      void loadBalances(const std::vector<KeyType> &keys);
+
+      /**
+       * @throws std::logic_error if the cache has no session
+       */
+      soci::session &session();
+
+      soci::session *sql_;
+
+      std::unordered_map<shared_model::interface::types::AccountIdType,
+                         AccountEntry>
+          accounts_;
+      std::unordered_map<KeyType,
+                         shared_model::interface::GrantablePermissionSet,
+                         boost::hash<KeyType>>
+          grantable_permissions_;
+      std::unordered_map<
+          shared_model::interface::types::AssetIdType,
+          boost::optional<shared_model::interface::types::PrecisionType>>
+          assets_;
+      std::unordered_map<KeyType, BalanceEntry, boost::hash<KeyType>>
+          balances_;
+
+      /// previous states of changed balances, in order of changes
+      std::vector<std::pair<KeyType, BalanceEntry>> undo_;
+      /// incremented whenever the cache stops matching the undo log
+      uint64_t generation_;
+    };
+
+  }  // namespace ametsuchi
+}  // namespace iroha
+
+#endif  // IROHA_WSV_CACHE_HPP
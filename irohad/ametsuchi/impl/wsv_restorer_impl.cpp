@@ -5,24 +5,21 @@
 
 #include "wsv_restorer_impl.hpp"
 
-#include <vector>
-
-#include "ametsuchi/block_query.hpp"
 #include "ametsuchi/storage.hpp"
-#include "interfaces/iroha_internal/block.hpp"
 
 namespace iroha {
   namespace ametsuchi {
     expected::Result<void, std::string> WsvRestorerImpl::restoreWsv(
         Storage &storage) {
-      // get all blocks starting from the genesis
-      std::vector<std::shared_ptr<shared_model::interface::Block>> blocks=
-      storage.getBlockQuery()->getBlocksFrom(1);
-
-      storage.reset();
+      // only the blocks after the snapshot are applied, if there is one
+      auto snapshot_height = storage.restoreWsvSnapshot();
+      if (not snapshot_height) {
+        storage.resetWsv();
+      }
 
-      if (not storage.insertBlocks(blocks))
-        return expected::makeError("cannot insert blocks");
+      if (not storage.applyStoredBlocks(snapshot_height.value_or(0) + 1)) {
+        return expected::makeError("cannot apply blocks");
+      }
 
       return expected::Value<void>();
     }
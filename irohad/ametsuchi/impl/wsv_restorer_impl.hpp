@@ -21,7 +21,8 @@ namespace iroha {
       virtual ~WsvRestorerImpl() = default;
       /**
        * Recover WSV (World State View).
-       * Drop storage and apply blocks one by one.
+       * Restore the latest snapshot of WSV and apply the blocks after it, or
+       * drop WSV and apply all blocks if there is no snapshot.
        * @param storage of blocks in ledger
        * @return void on success, otherwise error string
        */
@@ -7,6 +7,7 @@
 #define IROHA_KV_STORAGE_HPP
 
 #include <boost/optional.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,17 @@ namespace iroha {
       using Identifier = uint32_t;
       using Bytes = std::vector<uint8_t>;
 
+      /**
+       * Read-only view of stored data. Memory pointed to by data stays valid
+       * as long as the view or a copy of its holder is alive, even if the
+       * storage is modified or destroyed
+       */
+      struct BytesView {
+        const uint8_t *data;
+        size_t size;
+        std::shared_ptr<const void> holder;
+      };
+
       /**
        * Add entity with binary data
        * @param id - reference key
@@ -39,6 +51,22 @@ namespace iroha {
        */
       virtual boost::optional<Bytes> get(Identifier id) const = 0;
 
+      /**
+       * Get data associated with id without copying it, if the storage is
+       * able to expose its memory directly. Default implementation wraps the
+       * result of get()
+       * @param id - reference key
+       * @return - view of the blob, if exists
+       */
+      virtual boost::optional<BytesView> getView(Identifier id) const {
+        auto blob = get(id);
+        if (not blob) {
+          return boost::none;
+        }
+        auto holder = std::make_shared<const Bytes>(std::move(*blob));
+        return BytesView{holder->data(), holder->size(), holder};
+      }
+
       /**
        * @return folder of storage
        */
@@ -6,6 +6,7 @@
 #ifndef IROHA_AMETSUCHI_H
 #define IROHA_AMETSUCHI_H
 
+#include <boost/optional.hpp>
 #include <rxcpp/rx.hpp>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include "ametsuchi/query_executor_factory.hpp"
 #include "ametsuchi/temporary_factory.hpp"
 #include "common/result.hpp"
+#include "interfaces/common_objects/types.hpp"
 
 namespace shared_model {
   namespace interface {
@@ -61,6 +63,25 @@ namespace iroha {
           const std::vector<std::shared_ptr<shared_model::interface::Block>>
               &blocks) = 0;
 
+      /**
+       * Apply blocks from the block storage to WSV without storing them
+       * again. Blocks are read and applied in chunks, so the chain is never
+       * loaded into memory whole
+       * @param first_height - height of the first block to apply
+       * @return true if all blocks up to the top were applied
+       */
+      virtual bool applyStoredBlocks(
+          shared_model::interface::types::HeightType first_height) = 0;
+
+      /**
+       * Replace WSV with the latest snapshot of it, if the snapshot matches
+       * the block storage
+       * @return height of the top block of the snapshot, none if there is no
+       * suitable snapshot
+       */
+      virtual boost::optional<shared_model::interface::types::HeightType>
+      restoreWsvSnapshot() = 0;
+
       /**
        * method called when block is written to the storage
        * @return observable with the Block committed
@@ -68,11 +89,25 @@ namespace iroha {
       virtual rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
       on_commit() = 0;
 
+      /**
+       * method called before block is committed, its transactions may not be
+       * visible in the storage yet. The block is emitted again if its commit
+       * fails and is retried
+       * @return observable with the Block being committed
+       */
+      virtual rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
+      on_pre_commit() = 0;
+
       /**
        * Remove all records from the tables and remove all the blocks
        */
       virtual void reset() = 0;
 
+      /**
+       * Remove all records from the tables, the blocks are kept
+       */
+      virtual void resetWsv() = 0;
+
       /**
        * Remove all information from ledger
        * Tables and the database will be removed too
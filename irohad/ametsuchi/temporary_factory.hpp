@@ -6,6 +6,8 @@
 #ifndef IROHA_TEMPORARY_FACTORY_HPP
 #define IROHA_TEMPORARY_FACTORY_HPP
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include "common/result.hpp"
 
@@ -34,6 +36,27 @@ namespace iroha {
        */
       virtual void prepareBlock(std::unique_ptr<TemporaryWsv> wsv) = 0;
 
+      /**
+       * Work done on top of the state before its preparation, returns false
+       * if the state must not be prepared. The flag is set when the state is
+       * needed by a commit, a new temporary WSV or a mutable storage, then
+       * the optional part of the work has to be skipped
+       */
+      using PreparationWork =
+          std::function<bool(TemporaryWsv &, const std::atomic<bool> &)>;
+
+      /**
+       * Do the work on top of the state accumulated in temporary WSV in
+       * background and prepare the resulting state. Until the state is
+       * prepared, new temporary WSVs, mutable storages and commits of
+       * prepared blocks wait for it.
+       *
+       * @param wsv - state which will be prepared
+       * @param work - called with the state before preparation
+       */
+      virtual void prepareBlockAsync(std::unique_ptr<TemporaryWsv> wsv,
+                                     PreparationWork work) = 0;
+
       virtual ~TemporaryFactory() = default;
     };
 
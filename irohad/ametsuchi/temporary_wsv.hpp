@@ -7,8 +7,11 @@
 #define IROHA_TEMPORARYWSV_HPP
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include "common/result.hpp"
+#include "interfaces/common_objects/range_types.hpp"
 #include "validation/stateful_validator_common.hpp"
 
 namespace shared_model {
@@ -55,6 +58,26 @@ namespace iroha {
       virtual std::unique_ptr<TemporaryWsv::SavepointWrapper> createSavepoint(
           const std::string &name) = 0;
 
+      /**
+       * Create a temporary wsv which applies transactions of the given
+       * batches in memory, on a copy of the part of the state they use.
+       * Forks of batches which do not touch the same state are independent
+       * and can be used concurrently, while this wsv is not used
+       * @param batches - transactions to be applied to the fork
+       * @return the fork, nullptr if the transactions can not be applied in
+       * memory
+       */
+      virtual std::unique_ptr<TemporaryWsv> fork(
+          const std::vector<
+              shared_model::interface::types::TransactionsCollectionType>
+              &batches) = 0;
+
+      /**
+       * Apply changes made to the fork created by this wsv
+       * @param fork to take changes from
+       */
+      virtual void join(TemporaryWsv &fork) = 0;
+
       virtual ~TemporaryWsv() = default;
     };
   }  // namespace ametsuchi
@@ -48,8 +48,14 @@ namespace iroha {
       virtual boost::optional<BatchStatusCollectionType> check(
           const shared_model::interface::TransactionBatch &batch) const = 0;
 
-      // TODO: 09/11/2018 @muratovv add method for processing collection of
-      // batches IR-1857
+      /**
+       * Check status of several transactions at once, hashes which are not
+       * known to the cache are resolved with a single storage query
+       * @return a collection with answers about each hash in the same order
+       * if storage query was successful, boost::none otherwise
+       */
+      virtual boost::optional<BatchStatusCollectionType> check(
+          const std::vector<shared_model::crypto::Hash> &hashes) const = 0;
 
       virtual ~TxPresenceCache() = default;
     };
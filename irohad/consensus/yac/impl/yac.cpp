@@ -192,9 +192,7 @@ namespace iroha {
       // ------|Propagation|------
 
       void Yac::propagateState(const std::vector<VoteMessage> &msg) {
-        for (const auto &peer : cluster_order_.getPeers()) {
-          propagateStateDirectly(*peer, msg);
-        }
+        network_->broadcastState(cluster_order_.getPeers(), msg);
       }
 
       void Yac::propagateStateDirectly(const shared_model::interface::Peer &to,
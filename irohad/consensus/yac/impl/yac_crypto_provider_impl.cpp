@@ -19,17 +19,20 @@ namespace iroha {
           : keypair_(keypair), factory_(std::move(factory)) {}
 
       bool CryptoProviderImpl::verify(const std::vector<VoteMessage> &msg) {
-        return std::all_of(
-            std::begin(msg), std::end(msg), [](const auto &vote) {
-              auto serialized =
-                  PbConverters::serializeVote(vote).hash().SerializeAsString();
-              auto blob = shared_model::crypto::Blob(serialized);
-
-              return shared_model::crypto::CryptoVerifier<>::verify(
-                  vote.signature->signedData(),
-                  blob,
-                  vote.signature->publicKey());
-            });
+        // signed payloads are kept alive until the batch is verified
+        std::vector<shared_model::crypto::Blob> payloads;
+        payloads.reserve(msg.size());
+        shared_model::crypto::VerificationBatch batch;
+        batch.reserve(msg.size());
+        for (const auto &vote : msg) {
+          payloads.emplace_back(
+              PbConverters::serializeVote(vote).hash().SerializeAsString());
+          batch.push_back(shared_model::crypto::VerificationItem{
+              vote.signature->signedData(),
+              payloads.back(),
+              vote.signature->publicKey()});
+        }
+        return shared_model::crypto::CryptoVerifier<>::batchVerify(batch);
       }
 
       VoteMessage CryptoProviderImpl::getVote(YacHash hash) {
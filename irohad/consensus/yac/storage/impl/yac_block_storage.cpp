@@ -5,6 +5,8 @@
 
 #include "consensus/yac/storage/yac_block_storage.hpp"
 
+#include "cryptography/public_key.hpp"
+
 using namespace logger;
 
 namespace iroha {
@@ -25,6 +27,7 @@ namespace iroha {
 
       boost::optional<Answer> YacBlockStorage::insert(VoteMessage msg) {
         if (validScheme(msg) and uniqueVote(msg)) {
+          vote_index_.emplace(msg.signature->publicKey().hex(), votes_.size());
           votes_.push_back(msg);
 
           log_->info(
@@ -65,20 +68,18 @@ namespace iroha {
       }
 
       bool YacBlockStorage::isContains(const VoteMessage &msg) const {
-        return std::count(votes_.begin(), votes_.end(), msg) != 0;
+        auto it = vote_index_.find(msg.signature->publicKey().hex());
+        return it != vote_index_.end() and votes_[it->second] == msg;
       }
 
-      YacHash YacBlockStorage::getStorageKey() const {
+      const YacHash &YacBlockStorage::getStorageKey() const {
         return storage_key_;
       }
 
       // --------| private api |--------
 
       bool YacBlockStorage::uniqueVote(VoteMessage &msg) {
-        // lookup take O(n) times
-        return std::all_of(votes_.begin(), votes_.end(), [&msg](auto vote) {
-          return vote != msg;
-        });
+        return vote_index_.count(msg.signature->publicKey().hex()) == 0;
       }
 
       bool YacBlockStorage::validScheme(VoteMessage &vote) {
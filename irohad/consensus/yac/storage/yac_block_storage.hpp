@@ -19,6 +19,8 @@
 #define IROHA_YAC_BLOCK_VOTE_STORAGE_HPP
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/optional.hpp>
@@ -39,10 +41,15 @@ namespace iroha {
         // --------| fields |--------
 
         /**
-         * All votes stored in block store
+         * All votes stored in block store in order of insertion
          */
         std::vector<VoteMessage> votes_;
 
+        /**
+         * Positions of votes in votes_ by hex of public keys of voted peers
+         */
+        std::unordered_map<std::string, size_t> vote_index_;
+
        public:
         YacBlockStorage(
             YacHash hash,
@@ -82,7 +89,7 @@ namespace iroha {
         boost::optional<Answer> getState();
 
         /**
-         * Verify that passed vote contains in storage
+         * Verify that passed vote contains in storage, takes O(1)
          * @param msg  - vote for finding
          * @return true, if contains
          */
@@ -91,15 +98,16 @@ namespace iroha {
         /**
          * Provide key attached to this storage
          */
-        YacHash getStorageKey() const;
+        const YacHash &getStorageKey() const;
 
        private:
         // --------| private api |--------
 
         /**
-         * Verify uniqueness of vote in storage
+         * Verify uniqueness of vote in storage, only one vote of a peer is
+         * stored
          * @param msg - vote for verification
-         * @return true if vote doesn't appear in storage
+         * @return true if storage has no vote of the same peer
          */
         bool uniqueVote(VoteMessage &vote);
 
@@ -33,20 +33,18 @@ namespace iroha {
 
       void NetworkImpl::sendState(const shared_model::interface::Peer &to,
                                   const std::vector<VoteMessage> &state) {
-        createPeerConnection(to);
+        sendRequest(to, serializeState(state));
+      }
 
-        proto::State request;
-        for (const auto &vote : state) {
-          auto pb_vote = request.add_votes();
-          *pb_vote = PbConverters::serializeVote(vote);
+      void NetworkImpl::broadcastState(
+          const std::vector<std::shared_ptr<shared_model::interface::Peer>>
+              &to,
+          const std::vector<VoteMessage> &state) {
+        // votes are converted once, instead of once per recipient
+        auto request = serializeState(state);
+        for (const auto &peer : to) {
+          sendRequest(*peer, request);
         }
-
-        async_call_->Call([&](auto context, auto cq) {
-          return peers_.at(to.address())->AsyncSendState(context, request, cq);
-        });
-
-        async_call_->log_->info(
-            "Send votes bundle[size={}] to {}", state.size(), to.address());
       }
 
       grpc::Status NetworkImpl::SendState(
@@ -72,6 +70,29 @@ namespace iroha {
         return grpc::Status::OK;
       }
 
+      proto::State NetworkImpl::serializeState(
+          const std::vector<VoteMessage> &state) {
+        proto::State request;
+        request.mutable_votes()->Reserve(state.size());
+        for (const auto &vote : state) {
+          *request.add_votes() = PbConverters::serializeVote(vote);
+        }
+        return request;
+      }
+
+      void NetworkImpl::sendRequest(const shared_model::interface::Peer &to,
+                                    const proto::State &request) {
+        createPeerConnection(to);
+
+        async_call_->Call([&](auto context, auto cq) {
+          return peers_.at(to.address())->AsyncSendState(context, request, cq);
+        });
+
+        async_call_->log_->info("Send votes bundle[size={}] to {}",
+                                request.votes_size(),
+                                to.address());
+      }
+
       void NetworkImpl::createPeerConnection(
           const shared_model::interface::Peer &peer) {
         if (peers_.count(peer.address()) == 0) {
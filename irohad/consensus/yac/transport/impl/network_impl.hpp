@@ -40,6 +40,11 @@ namespace iroha {
         void sendState(const shared_model::interface::Peer &to,
                        const std::vector<VoteMessage> &state) override;
 
+        void broadcastState(
+            const std::vector<std::shared_ptr<shared_model::interface::Peer>>
+                &to,
+            const std::vector<VoteMessage> &state) override;
+
         /**
          * Receive votes from another peer;
          * Naming is confusing, because this is rpc call that
@@ -51,6 +56,20 @@ namespace iroha {
             ::google::protobuf::Empty *response) override;
 
        private:
+        /**
+         * Convert votes to the request message
+         */
+        static proto::State serializeState(
+            const std::vector<VoteMessage> &state);
+
+        /**
+         * Send the serialized votes to the peer
+         * @param to - peer recipient
+         * @param request - serialized votes
+         */
+        void sendRequest(const shared_model::interface::Peer &to,
+                         const proto::State &request);
+
         /**
          * Create GRPC connection for given peer if it does not exist in
          * peers map
@@ -45,6 +45,21 @@ namespace iroha {
         virtual void sendState(const shared_model::interface::Peer &to,
                                const std::vector<VoteMessage> &state) = 0;
 
+        /**
+         * Share the same collection of votes with several peers. Transports
+         * which serialize messages should do it once for all recipients
+         * @param to - peer recipients
+         * @param state - message for sending
+         */
+        virtual void broadcastState(
+            const std::vector<std::shared_ptr<shared_model::interface::Peer>>
+                &to,
+            const std::vector<VoteMessage> &state) {
+          for (const auto &peer : to) {
+            sendState(*peer, state);
+          }
+        }
+
         /**
          * Virtual destructor required for inheritance
          */
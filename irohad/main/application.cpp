@@ -8,7 +8,6 @@
 #include "ametsuchi/impl/tx_presence_cache_impl.hpp"
 #include "ametsuchi/impl/wsv_restorer_impl.hpp"
 #include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
-#include "backend/protobuf/proto_block_json_converter.hpp"
 #include "backend/protobuf/proto_permission_to_string.hpp"
 #include "backend/protobuf/proto_proposal_factory.hpp"
 #include "backend/protobuf/proto_query_response_factory.hpp"
@@ -60,7 +59,13 @@ Irohad::Irohad(const std::string &block_store_dir,
                std::chrono::milliseconds vote_delay,
                const shared_model::crypto::Keypair &keypair,
                const boost::optional<GossipPropagationStrategyParams>
-                   &opt_mst_gossip_params)
+                   &opt_mst_gossip_params,
+               iroha::main::BlockStoreFormat block_store_format,
+               const iroha::ametsuchi::BlockStoreOptions &block_store_options,
+               size_t wsv_snapshot_period,
+               bool pipelined_validation,
+               std::chrono::milliseconds batch_flush_delay,
+               size_t batch_flush_size)
     : block_store_dir_(block_store_dir),
       pg_conn_(pg_conn),
       listen_ip_(listen_ip),
@@ -71,6 +76,12 @@ Irohad::Irohad(const std::string &block_store_dir,
       vote_delay_(vote_delay),
       is_mst_supported_(opt_mst_gossip_params),
       opt_mst_gossip_params_(opt_mst_gossip_params),
+      block_store_format_(block_store_format),
+      block_store_options_(block_store_options),
+      wsv_snapshot_period_(wsv_snapshot_period),
+      pipelined_validation_(pipelined_validation),
+      batch_flush_delay_(batch_flush_delay),
+      batch_flush_size_(batch_flush_size),
       keypair(keypair) {
   log_ = logger::log("IROHAD");
   log_->info("created");
@@ -126,12 +137,15 @@ void Irohad::initStorage() {
   auto perm_converter =
       std::make_shared<shared_model::proto::ProtoPermissionToString>();
   auto block_converter =
-      std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
+      iroha::main::makeBlockStoreConverter(block_store_format_);
   auto storageResult = StorageImpl::create(block_store_dir_,
                                            pg_conn_,
                                            common_objects_factory_,
                                            std::move(block_converter),
-                                           perm_converter);
+                                           perm_converter,
+                                           StorageImpl::kDefaultPoolSize,
+                                           block_store_options_,
+                                           wsv_snapshot_period_);
   storageResult.match(
       [&](expected::Value<std::shared_ptr<ametsuchi::StorageImpl>> &_storage) {
         storage = _storage.value;
@@ -250,7 +264,7 @@ void Irohad::initFactories() {
  * Initializing persistent cache
  */
 void Irohad::initPersistentCache() {
-  persistent_cache = std::make_shared<TxPresenceCacheImpl>(storage);
+  persistent_cache = std::make_shared<TxPresenceCacheImpl>(storage, true);
 
   log_->info("[Init] => persistent cache");
 }
@@ -321,7 +335,9 @@ void Irohad::initOrderingGate() {
                                                  proposal_factory,
                                                  persistent_cache,
                                                  {blocks.back()->height(), 1},
-                                                 delay);
+                                                 delay,
+                                                 batch_flush_delay_,
+                                                 batch_flush_size_);
   log_->info("[Init] => init ordering gate - [{}]",
              logger::logBool(ordering_gate));
 }
@@ -340,12 +356,21 @@ void Irohad::initSimulator() {
       std::make_unique<
           shared_model::validation::DefaultUnsignedBlockValidator>(),
       std::make_unique<shared_model::validation::ProtoBlockValidator>());
+  Simulator::SpeculativeProposalSource speculative_proposals;
+  if (pipelined_validation_) {
+    speculative_proposals = [connection_manager =
+                                 ordering_init.connection_manager](
+                                const consensus::Round &round) {
+      return connection_manager->prefetchedProposal(round);
+    };
+  }
   simulator = std::make_shared<Simulator>(ordering_gate,
                                           stateful_validator,
                                           storage,
                                           storage,
                                           crypto_signer_,
-                                          std::move(block_factory));
+                                          std::move(block_factory),
+                                          std::move(speculative_proposals));
 
   log_->info("[Init] => init simulator");
 }
@@ -16,9 +16,11 @@
 #include "interfaces/iroha_internal/transaction_batch_factory.hpp"
 #include "logger/logger.hpp"
 #include "main/impl/block_loader_init.hpp"
+#include "main/impl/block_store_format.hpp"
 #include "main/impl/consensus_init.hpp"
 #include "main/impl/on_demand_ordering_init.hpp"
 #include "main/server_runner.hpp"
+#include "ordering/impl/on_demand_batch_coalescer.hpp"
 #include "multi_sig_transactions/gossip_propagation_strategy_params.hpp"
 #include "multi_sig_transactions/mst_processor.hpp"
 #include "network/block_loader.hpp"
@@ -67,6 +69,16 @@ class Irohad {
    * @param keypair - public and private keys for crypto signer
    * @param opt_mst_gossip_params - parameters for Gossip MST propagation
    * (optional). If not provided, disables mst processing support
+   * @param block_store_format - encoding of blocks written to block store
+   * @param block_store_options - block storage implementation and parameters
+   * @param wsv_snapshot_period - number of blocks between snapshots of WSV,
+   * 0 disables snapshots
+   * @param pipelined_validation - validate the proposal of the next round
+   * while the block of the current round is voted for
+   * @param batch_flush_delay - time batches for the same peer are accumulated
+   * before being sent with a single request
+   * @param batch_flush_size - number of accumulated batches which are sent
+   * without waiting for the delay
    *
    * TODO mboldyrev 03.11.2018 IR-1844 Refactor the constructor.
    */
@@ -80,7 +92,18 @@ class Irohad {
          std::chrono::milliseconds vote_delay,
          const shared_model::crypto::Keypair &keypair,
          const boost::optional<iroha::GossipPropagationStrategyParams>
-             &opt_mst_gossip_params = boost::none);
+             &opt_mst_gossip_params = boost::none,
+         iroha::main::BlockStoreFormat block_store_format =
+             iroha::main::BlockStoreFormat::kJson,
+         const iroha::ametsuchi::BlockStoreOptions &block_store_options =
+             iroha::ametsuchi::BlockStoreOptions{},
+         size_t wsv_snapshot_period =
+             iroha::ametsuchi::StorageImpl::kDefaultWsvSnapshotPeriod,
+         bool pipelined_validation = false,
+         std::chrono::milliseconds batch_flush_delay =
+             iroha::ordering::OnDemandBatchCoalescerFactory::kDefaultFlushDelay,
+         size_t batch_flush_size = iroha::ordering::
+             OnDemandBatchCoalescerFactory::kDefaultMaxBatches);
 
   /**
    * Initialization of whole objects in system
@@ -164,6 +187,12 @@ class Irohad {
   bool is_mst_supported_;
   boost::optional<iroha::GossipPropagationStrategyParams>
       opt_mst_gossip_params_;
+  iroha::main::BlockStoreFormat block_store_format_;
+  iroha::ametsuchi::BlockStoreOptions block_store_options_;
+  size_t wsv_snapshot_period_;
+  bool pipelined_validation_;
+  std::chrono::milliseconds batch_flush_delay_;
+  size_t batch_flush_size_;
 
   // ------------------------| internal dependencies |-------------------------
 
@@ -0,0 +1,121 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Offline tool which converts an existing block store to another block store
+ * format in place. Each block is rewritten to a temporary file which then
+ * replaces the original one, so an interrupted migration leaves the store
+ * readable and can simply be restarted. Irohad must be stopped while the tool
+ * is running.
+ */
+
+#include <gflags/gflags.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+#include "backend/protobuf/proto_block_binary_converter.hpp"
+#include "common/byteutils.hpp"
+#include "interfaces/iroha_internal/block.hpp"
+#include "logger/logger.hpp"
+#include "main/impl/block_store_format.hpp"
+
+DEFINE_string(block_store_path, "", "Specify path to the block store");
+DEFINE_string(format, "protobuf", "Target format: json or protobuf");
+
+int main(int argc, char *argv[]) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  gflags::ShutDownCommandLineFlags();
+
+  auto log = logger::log("BlockStoreMigrate");
+
+  if (FLAGS_block_store_path.empty()) {
+    log->error("Block store path is not specified");
+    return EXIT_FAILURE;
+  }
+  auto format = iroha::main::parseBlockStoreFormat(FLAGS_format);
+  if (not format) {
+    log->error("Unknown block store format {}", FLAGS_format);
+    return EXIT_FAILURE;
+  }
+
+  // opening a segmented log as a flat file would remove all of its segments
+  for (boost::filesystem::directory_iterator it{FLAGS_block_store_path}, end;
+       it != end;
+       ++it) {
+    if (it->path().extension()
+        == iroha::ametsuchi::SegmentedLog::kSegmentExtension) {
+      log->error("Only flat file block stores can be migrated");
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto store = iroha::ametsuchi::FlatFile::create(FLAGS_block_store_path);
+  if (not store) {
+    log->error("Cannot open block store {}", FLAGS_block_store_path);
+    return EXIT_FAILURE;
+  }
+  auto &block_store = *store;
+
+  // reads both json and binary records
+  shared_model::proto::ProtoBlockBinaryConverter reader;
+  auto writer = iroha::main::makeBlockStoreConverter(*format);
+  const bool to_binary = *format == iroha::main::BlockStoreFormat::kProtobuf;
+
+  // temporary file must stay outside of the block store directory, otherwise
+  // it will be treated as a broken block on the next start, but on the same
+  // file system, so that it can be atomically renamed over the original block
+  const auto store_path =
+      boost::filesystem::canonical(block_store->directory());
+  const auto tmp_path = store_path.parent_path()
+      / (store_path.filename().string() + ".migrate.tmp");
+
+  size_t converted = 0;
+  const auto last_id = block_store->last_id();
+  for (iroha::ametsuchi::FlatFile::Identifier id = 1; id <= last_id; ++id) {
+    auto bytes = block_store->get(id);
+    if (not bytes) {
+      log->error("Failed to read block {}", id);
+      return EXIT_FAILURE;
+    }
+    auto record = iroha::bytesToString(*bytes);
+    if (shared_model::proto::ProtoBlockBinaryConverter::isBinary(record)
+        == to_binary) {
+      continue;
+    }
+
+    auto result = reader.deserialize(record)
+        | [&](auto &&block) { return writer->serialize(*block); };
+    if (auto error = boost::get<iroha::expected::Error<std::string>>(&result)) {
+      log->error("Failed to convert block {}: {}", id, error->error);
+      return EXIT_FAILURE;
+    }
+    const auto &converted_record =
+        boost::get<iroha::expected::Value<std::string>>(result).value;
+
+    {
+      boost::filesystem::ofstream file(tmp_path, std::ofstream::binary);
+      file.write(converted_record.data(), converted_record.size());
+      if (not file.good()) {
+        log->error("Failed to write {}", tmp_path.string());
+        return EXIT_FAILURE;
+      }
+    }
+    const auto path = store_path / iroha::ametsuchi::FlatFile::id_to_name(id);
+    boost::filesystem::rename(tmp_path, path);
+
+    if (++converted % 1000 == 0) {
+      log->info(
+          "Converted {} blocks, at height {} of {}", converted, id, last_id);
+    }
+  }
+
+  log->info("Migration finished, {} of {} blocks converted to {}",
+            converted,
+            last_id,
+            FLAGS_format);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "main/impl/block_store_format.hpp"
+
+#include "backend/protobuf/proto_block_binary_converter.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+
+namespace iroha {
+  namespace main {
+
+    boost::optional<BlockStoreFormat> parseBlockStoreFormat(
+        const std::string &name) {
+      if (name == "json") {
+        return BlockStoreFormat::kJson;
+      }
+      if (name == "protobuf") {
+        return BlockStoreFormat::kProtobuf;
+      }
+      return boost::none;
+    }
+
+    std::shared_ptr<shared_model::interface::BlockJsonConverter>
+    makeBlockStoreConverter(BlockStoreFormat format) {
+      switch (format) {
+        case BlockStoreFormat::kProtobuf:
+          return std::make_shared<
+              shared_model::proto::ProtoBlockBinaryConverter>();
+        case BlockStoreFormat::kJson:
+        default:
+          return std::make_shared<
+              shared_model::proto::ProtoBlockJsonConverter>();
+      }
+    }
+
+    boost::optional<ametsuchi::BlockStoreOptions::Type> parseBlockStoreType(
+        const std::string &name) {
+      if (name == "flat_file") {
+        return ametsuchi::BlockStoreOptions::Type::kFlatFile;
+      }
+      if (name == "segmented_log") {
+        return ametsuchi::BlockStoreOptions::Type::kSegmentedLog;
+      }
+      return boost::none;
+    }
+
+    boost::optional<ametsuchi::SegmentedLog::FsyncPolicy> parseFsyncPolicy(
+        const std::string &name) {
+      if (name == "never") {
+        return ametsuchi::SegmentedLog::FsyncPolicy::kNever;
+      }
+      if (name == "segment") {
+        return ametsuchi::SegmentedLog::FsyncPolicy::kOnSegmentClose;
+      }
+      if (name == "always") {
+        return ametsuchi::SegmentedLog::FsyncPolicy::kOnEveryAdd;
+      }
+      return boost::none;
+    }
+
+  }  // namespace main
+}  // namespace iroha
@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_BLOCK_STORE_FORMAT_HPP
+#define IROHA_BLOCK_STORE_FORMAT_HPP
+
+#include <memory>
+#include <string>
+
+#include <boost/optional.hpp>
+#include "ametsuchi/impl/block_store_options.hpp"
+#include "interfaces/iroha_internal/block_json_converter.hpp"
+
+namespace iroha {
+  namespace main {
+
+    /**
+     * Encoding of blocks written to the block store. Protobuf block store
+     * still reads blocks written in json, so switching json -> protobuf needs
+     * no migration; the opposite direction requires block_store_migrate.
+     */
+    enum class BlockStoreFormat {
+      kJson,     ///< protobuf json mapping, human readable
+      kProtobuf  ///< protobuf wire bytes with versioned header and checksum
+    };
+
+    /**
+     * Parse block store format from its configuration name
+     * @param name - "json" or "protobuf"
+     * @return parsed format or none if the name is unknown
+     */
+    boost::optional<BlockStoreFormat> parseBlockStoreFormat(
+        const std::string &name);
+
+    /**
+     * Create block converter which writes blocks in given format
+     * @param format - format of stored blocks
+     * @return block converter
+     */
+    std::shared_ptr<shared_model::interface::BlockJsonConverter>
+    makeBlockStoreConverter(BlockStoreFormat format);
+
+    /**
+     * Parse block storage implementation from its configuration name
+     * @param name - "flat_file" or "segmented_log"
+     * @return parsed type or none if the name is unknown
+     */
+    boost::optional<ametsuchi::BlockStoreOptions::Type> parseBlockStoreType(
+        const std::string &name);
+
+    /**
+     * Parse segmented log fsync policy from its configuration name
+     * @param name - "never", "segment" or "always"
+     * @return parsed policy or none if the name is unknown
+     */
+    boost::optional<ametsuchi::SegmentedLog::FsyncPolicy> parseFsyncPolicy(
+        const std::string &name);
+
+  }  // namespace main
+}  // namespace iroha
+
+#endif  // IROHA_BLOCK_STORE_FORMAT_HPP
@@ -11,6 +11,7 @@
 #include "datetime/time.hpp"
 #include "interfaces/common_objects/peer.hpp"
 #include "interfaces/common_objects/types.hpp"
+#include "ordering/impl/on_demand_batch_coalescer.hpp"
 #include "ordering/impl/on_demand_common.hpp"
 #include "ordering/impl/on_demand_connection_manager.hpp"
 #include "ordering/impl/on_demand_ordering_gate.hpp"
@@ -45,12 +46,19 @@ namespace iroha {
         std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
             async_call,
         std::shared_ptr<TransportFactoryType> proposal_transport_factory,
-        std::chrono::milliseconds delay) {
-      return std::make_shared<ordering::transport::OnDemandOsClientGrpcFactory>(
-          std::move(async_call),
-          std::move(proposal_transport_factory),
-          [] { return std::chrono::system_clock::now(); },
-          delay);
+        std::chrono::milliseconds delay,
+        std::chrono::milliseconds batch_flush_delay,
+        size_t batch_flush_size) {
+      // batches for the same peer are accumulated for a short time and sent
+      // with a single request
+      return std::make_shared<ordering::OnDemandBatchCoalescerFactory>(
+          std::make_shared<ordering::transport::OnDemandOsClientGrpcFactory>(
+              std::move(async_call),
+              std::move(proposal_transport_factory),
+              [] { return std::chrono::system_clock::now(); },
+              delay),
+          batch_flush_delay,
+          batch_flush_size);
     }
 
     auto OnDemandOrderingInit::createConnectionManager(
@@ -59,7 +67,9 @@ namespace iroha {
             async_call,
         std::shared_ptr<TransportFactoryType> proposal_transport_factory,
         std::chrono::milliseconds delay,
-        std::vector<shared_model::interface::types::HashType> initial_hashes) {
+        std::vector<shared_model::interface::types::HashType> initial_hashes,
+        std::chrono::milliseconds batch_flush_delay,
+        size_t batch_flush_size) {
       // since top block will be the first in notifier observable, hashes of
       // two previous blocks are prepended
       const size_t kBeforePreviousTop = 0, kPreviousTop = 1;
@@ -158,6 +168,8 @@ namespace iroha {
          * v, round 1 - kNextRoundRejectConsumer
          * v, round 2 - kNextRoundCommitConsumer
          * o, round 0 - kIssuer
+         * x, round 0 - kNextRejectRoundIssuer
+         * x, round 1 - kNextCommitRoundIssuer
          */
         peers.peers.at(OnDemandConnectionManager::kCurrentRoundRejectConsumer) =
             getOsPeer(kCurrentRound,
@@ -169,6 +181,13 @@ namespace iroha {
             getOsPeer(kRoundAfterNext, ordering::kNextCommitRoundConsumer);
         peers.peers.at(OnDemandConnectionManager::kIssuer) =
             getOsPeer(kCurrentRound, current_round.reject_round);
+        // issuer of the next commit round is valid unless the peers list is
+        // changed by the next block, prefetched proposal is discarded then
+        peers.peers.at(OnDemandConnectionManager::kNextRejectRoundIssuer) =
+            getOsPeer(kCurrentRound,
+                      ordering::nextRejectRound(current_round).reject_round);
+        peers.peers.at(OnDemandConnectionManager::kNextCommitRoundIssuer) =
+            getOsPeer(kNextRound, ordering::kFirstRejectRound);
         return peers;
       };
 
@@ -179,7 +198,9 @@ namespace iroha {
       return std::make_shared<ordering::OnDemandConnectionManager>(
           createNotificationFactory(std::move(async_call),
                                     std::move(proposal_transport_factory),
-                                    delay),
+                                    delay,
+                                    batch_flush_delay,
+                                    batch_flush_size),
           peers);
     }
 
@@ -242,9 +263,18 @@ namespace iroha {
         size_t max_size,
         std::shared_ptr<shared_model::interface::UnsafeProposalFactory>
             proposal_factory,
-        std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache) {
+        std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
+        std::shared_ptr<ordering::transport::OdOsNotification>
+            network_client) {
+      const size_t kNumberOfProposals = 3;
+      const consensus::Round kInitialRound{2, ordering::kFirstRejectRound};
       return std::make_shared<ordering::OnDemandOrderingServiceImpl>(
-          max_size, std::move(proposal_factory), std::move(tx_cache));
+          max_size,
+          std::move(proposal_factory),
+          std::move(tx_cache),
+          kNumberOfProposals,
+          kInitialRound,
+          std::move(network_client));
     }
 
     OnDemandOrderingInit::~OnDemandOrderingInit() {
@@ -272,9 +302,19 @@ namespace iroha {
         std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
         consensus::Round initial_round,
         std::function<std::chrono::seconds(
-            const synchronizer::SynchronizationEvent &)> delay_func) {
-      auto ordering_service =
-          createService(max_size, proposal_factory, tx_cache);
+            const synchronizer::SynchronizationEvent &)> delay_func,
+        std::chrono::milliseconds batch_flush_delay,
+        size_t batch_flush_size) {
+      connection_manager =
+          createConnectionManager(std::move(peer_query_factory),
+                                  std::move(async_call),
+                                  std::move(proposal_transport_factory),
+                                  delay,
+                                  std::move(initial_hashes),
+                                  batch_flush_delay,
+                                  batch_flush_size);
+      auto ordering_service = createService(
+          max_size, proposal_factory, tx_cache, connection_manager);
       service = std::make_shared<ordering::transport::OnDemandOsServerGrpc>(
           ordering_service,
           std::move(transaction_factory),
@@ -282,11 +322,7 @@ namespace iroha {
           std::move(transaction_batch_factory));
       return createGate(
           ordering_service,
-          createConnectionManager(std::move(peer_query_factory),
-                                  std::move(async_call),
-                                  std::move(proposal_transport_factory),
-                                  delay,
-                                  std::move(initial_hashes)),
+          connection_manager,
           std::make_shared<ordering::cache::OnDemandCache>(),
           std::move(proposal_factory),
           std::move(tx_cache),
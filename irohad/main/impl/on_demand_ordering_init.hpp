@@ -16,6 +16,7 @@
 #include "network/ordering_gate.hpp"
 #include "network/peer_communication_service.hpp"
 #include "ordering.grpc.pb.h"
+#include "ordering/impl/on_demand_connection_manager.hpp"
 #include "ordering/impl/on_demand_os_server_grpc.hpp"
 #include "ordering/impl/ordering_gate_cache/ordering_gate_cache.hpp"
 #include "ordering/on_demand_ordering_service.hpp"
@@ -43,7 +44,9 @@ namespace iroha {
           std::shared_ptr<network::AsyncGrpcClient<google::protobuf::Empty>>
               async_call,
           std::shared_ptr<TransportFactoryType> proposal_transport_factory,
-          std::chrono::milliseconds delay);
+          std::chrono::milliseconds delay,
+          std::chrono::milliseconds batch_flush_delay,
+          size_t batch_flush_size);
 
       /**
        * Creates connection manager which redirects requests to appropriate
@@ -56,7 +59,9 @@ namespace iroha {
               async_call,
           std::shared_ptr<TransportFactoryType> proposal_transport_factory,
           std::chrono::milliseconds delay,
-          std::vector<shared_model::interface::types::HashType> initial_hashes);
+          std::vector<shared_model::interface::types::HashType> initial_hashes,
+          std::chrono::milliseconds batch_flush_delay,
+          size_t batch_flush_size);
 
       /**
        * Creates on-demand ordering gate. \see initOrderingGate for parameters
@@ -76,12 +81,16 @@ namespace iroha {
       /**
        * Creates on-demand ordering service. \see initOrderingGate for
        * parameters
+       * @param network_client - receives batches which did not fit into
+       * proposals of the service, to send them to the next rounds
        */
       auto createService(
           size_t max_size,
           std::shared_ptr<shared_model::interface::UnsafeProposalFactory>
               proposal_factory,
-          std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache);
+          std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
+          std::shared_ptr<ordering::transport::OdOsNotification>
+              network_client);
 
      public:
       ~OnDemandOrderingInit();
@@ -107,6 +116,12 @@ namespace iroha {
        * proposals
        * @param initial_round initial value for current round used in
        * OnDemandOrderingGate
+       * @param delay_func function which returns the delay before the next
+       * round depending on the synchronization outcome
+       * @param batch_flush_delay time batches for the same peer are
+       * accumulated before being sent with a single request
+       * @param batch_flush_size number of accumulated batches which are sent
+       * without waiting for batch_flush_delay
        * @return initialized ordering gate
        */
       std::shared_ptr<network::OrderingGate> initOrderingGate(
@@ -129,11 +144,16 @@ namespace iroha {
           std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
           consensus::Round initial_round,
           std::function<std::chrono::seconds(
-              const synchronizer::SynchronizationEvent &)> delay_func);
+              const synchronizer::SynchronizationEvent &)> delay_func,
+          std::chrono::milliseconds batch_flush_delay,
+          size_t batch_flush_size);
 
       /// gRPC service for ordering service
       std::shared_ptr<ordering::proto::OnDemandOrdering::Service> service;
 
+      /// connections to ordering services of the current round
+      std::shared_ptr<ordering::OnDemandConnectionManager> connection_manager;
+
       /// commit notifier from peer communication service
       rxcpp::subjects::subject<decltype(
           std::declval<PeerCommunicationService>().on_commit())::value_type>
@@ -26,6 +26,14 @@ namespace config_members {
   const char *ProposalDelay = "proposal_delay";
   const char *VoteDelay = "vote_delay";
   const char *MstSupport = "mst_enable";
+  const char *BlockStoreFormat = "block_store_format";
+  const char *BlockStoreType = "block_store_type";
+  const char *BlockStoreFsync = "block_store_fsync";
+  const char *BlockStoreSegmentSize = "block_store_segment_size";
+  const char *WsvSnapshotPeriod = "wsv_snapshot_period";
+  const char *PipelinedValidation = "pipelined_validation";
+  const char *BatchFlushDelay = "batch_flush_delay";
+  const char *BatchFlushSize = "batch_flush_size";
 }  // namespace config_members
 
 static constexpr size_t kBadJsonPrintLength = 15;
@@ -103,6 +111,46 @@ inline rapidjson::Document parse_iroha_config(const std::string &conf_path) {
                    ac::no_member_error(mbr::MstSupport));
   ac::assert_fatal(doc[mbr::MstSupport].IsBool(),
                    ac::type_error(mbr::MstSupport, kBoolType));
+
+  if (doc.HasMember(mbr::BlockStoreFormat)) {
+    ac::assert_fatal(doc[mbr::BlockStoreFormat].IsString(),
+                     ac::type_error(mbr::BlockStoreFormat, kStrType));
+  }
+
+  if (doc.HasMember(mbr::BlockStoreType)) {
+    ac::assert_fatal(doc[mbr::BlockStoreType].IsString(),
+                     ac::type_error(mbr::BlockStoreType, kStrType));
+  }
+
+  if (doc.HasMember(mbr::BlockStoreFsync)) {
+    ac::assert_fatal(doc[mbr::BlockStoreFsync].IsString(),
+                     ac::type_error(mbr::BlockStoreFsync, kStrType));
+  }
+
+  if (doc.HasMember(mbr::BlockStoreSegmentSize)) {
+    ac::assert_fatal(doc[mbr::BlockStoreSegmentSize].IsUint64(),
+                     ac::type_error(mbr::BlockStoreSegmentSize, kUintType));
+  }
+
+  if (doc.HasMember(mbr::WsvSnapshotPeriod)) {
+    ac::assert_fatal(doc[mbr::WsvSnapshotPeriod].IsUint64(),
+                     ac::type_error(mbr::WsvSnapshotPeriod, kUintType));
+  }
+
+  if (doc.HasMember(mbr::PipelinedValidation)) {
+    ac::assert_fatal(doc[mbr::PipelinedValidation].IsBool(),
+                     ac::type_error(mbr::PipelinedValidation, kBoolType));
+  }
+
+  if (doc.HasMember(mbr::BatchFlushDelay)) {
+    ac::assert_fatal(doc[mbr::BatchFlushDelay].IsUint(),
+                     ac::type_error(mbr::BatchFlushDelay, kUintType));
+  }
+
+  if (doc.HasMember(mbr::BatchFlushSize)) {
+    ac::assert_fatal(doc[mbr::BatchFlushSize].IsUint(),
+                     ac::type_error(mbr::BatchFlushSize, kUintType));
+  }
   return doc;
 }
 
@@ -117,6 +117,62 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  auto block_store_format = iroha::main::BlockStoreFormat::kJson;
+  if (config.HasMember(mbr::BlockStoreFormat)) {
+    auto format = iroha::main::parseBlockStoreFormat(
+        config[mbr::BlockStoreFormat].GetString());
+    if (not format) {
+      log->error("Unknown block store format {}",
+                 config[mbr::BlockStoreFormat].GetString());
+      return EXIT_FAILURE;
+    }
+    block_store_format = *format;
+  }
+
+  iroha::ametsuchi::BlockStoreOptions block_store_options;
+  if (config.HasMember(mbr::BlockStoreType)) {
+    auto type = iroha::main::parseBlockStoreType(
+        config[mbr::BlockStoreType].GetString());
+    if (not type) {
+      log->error("Unknown block store type {}",
+                 config[mbr::BlockStoreType].GetString());
+      return EXIT_FAILURE;
+    }
+    block_store_options.type = *type;
+  }
+  if (config.HasMember(mbr::BlockStoreFsync)) {
+    auto policy =
+        iroha::main::parseFsyncPolicy(config[mbr::BlockStoreFsync].GetString());
+    if (not policy) {
+      log->error("Unknown block store fsync policy {}",
+                 config[mbr::BlockStoreFsync].GetString());
+      return EXIT_FAILURE;
+    }
+    block_store_options.segmented_log.fsync_policy = *policy;
+  }
+  if (config.HasMember(mbr::BlockStoreSegmentSize)) {
+    block_store_options.segmented_log.segment_size =
+        config[mbr::BlockStoreSegmentSize].GetUint64();
+  }
+  auto wsv_snapshot_period =
+      iroha::ametsuchi::StorageImpl::kDefaultWsvSnapshotPeriod;
+  if (config.HasMember(mbr::WsvSnapshotPeriod)) {
+    wsv_snapshot_period = config[mbr::WsvSnapshotPeriod].GetUint64();
+  }
+  auto pipelined_validation = config.HasMember(mbr::PipelinedValidation)
+      and config[mbr::PipelinedValidation].GetBool();
+  auto batch_flush_delay =
+      iroha::ordering::OnDemandBatchCoalescerFactory::kDefaultFlushDelay;
+  if (config.HasMember(mbr::BatchFlushDelay)) {
+    batch_flush_delay =
+        std::chrono::milliseconds(config[mbr::BatchFlushDelay].GetUint());
+  }
+  auto batch_flush_size =
+      iroha::ordering::OnDemandBatchCoalescerFactory::kDefaultMaxBatches;
+  if (config.HasMember(mbr::BatchFlushSize)) {
+    batch_flush_size = config[mbr::BatchFlushSize].GetUint();
+  }
+
   // Configuring iroha daemon
   Irohad irohad(config[mbr::BlockStorePath].GetString(),
                 config[mbr::PgOpt].GetString(),
@@ -129,7 +185,13 @@ int main(int argc, char *argv[]) {
                 std::chrono::milliseconds(config[mbr::VoteDelay].GetUint()),
                 *keypair,
                 boost::make_optional(config[mbr::MstSupport].GetBool(),
-                                     iroha::GossipPropagationStrategyParams{}));
+                                     iroha::GossipPropagationStrategyParams{}),
+                block_store_format,
+                block_store_options,
+                wsv_snapshot_period,
+                pipelined_validation,
+                batch_flush_delay,
+                batch_flush_size);
 
   // Check if iroha daemon storage was successfully initialized
   if (not irohad.storage) {
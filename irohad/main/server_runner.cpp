@@ -9,12 +9,29 @@
 
 const auto kPortBindError = "Cannot bind server to address %s";
 
+constexpr size_t ServerRunner::kQueueWorkers;
+
 ServerRunner::ServerRunner(const std::string &address,
                            bool reuse,
                            logger::Logger log)
     : log_(std::move(log)), serverAddress_(address), reuse_(reuse) {}
 
+ServerRunner::~ServerRunner() {
+  if (completionQueue_) {
+    // the queue can be shut down only after the server
+    if (serverInstance_) {
+      serverInstance_->Shutdown();
+    }
+    shutdownQueue();
+  }
+}
+
 ServerRunner &ServerRunner::append(std::shared_ptr<grpc::Service> service) {
+  if (auto async_service =
+          std::dynamic_pointer_cast<iroha::network::AsyncGrpcService>(
+              service)) {
+    asyncServices_.push_back(async_service);
+  }
   services_.push_back(service);
   return *this;
 }
@@ -38,6 +55,10 @@ iroha::expected::Result<int, std::string> ServerRunner::run() {
   builder.SetMaxReceiveMessageSize(INT_MAX);
   builder.SetMaxSendMessageSize(INT_MAX);
 
+  if (not asyncServices_.empty()) {
+    completionQueue_ = builder.AddCompletionQueue();
+  }
+
   serverInstance_ = builder.BuildAndStart();
   serverInstanceCV_.notify_one();
 
@@ -46,6 +67,15 @@ iroha::expected::Result<int, std::string> ServerRunner::run() {
         (boost::format(kPortBindError) % serverAddress_).str());
   }
 
+  if (completionQueue_) {
+    for (auto &service : asyncServices_) {
+      service->handleCalls(completionQueue_.get());
+    }
+    for (size_t i = 0; i < kQueueWorkers; ++i) {
+      queueWorkers_.emplace_back(&ServerRunner::handleQueue, this);
+    }
+  }
+
   return iroha::expected::makeValue(selected_port);
 }
 
@@ -59,6 +89,7 @@ void ServerRunner::waitForServersReady() {
 void ServerRunner::shutdown() {
   if (serverInstance_) {
     serverInstance_->Shutdown();
+    shutdownQueue();
   } else {
     log_->warn("Tried to shutdown without a server instance");
   }
@@ -68,7 +99,28 @@ void ServerRunner::shutdown(
     const std::chrono::system_clock::time_point &deadline) {
   if (serverInstance_) {
     serverInstance_->Shutdown(deadline);
+    shutdownQueue();
   } else {
     log_->warn("Tried to shutdown without a server instance");
   }
 }
+
+void ServerRunner::handleQueue() {
+  void *tag;
+  auto ok = false;
+  while (completionQueue_->Next(&tag, &ok)) {
+    static_cast<iroha::network::AsyncCallTag *>(tag)->complete(ok);
+  }
+}
+
+void ServerRunner::shutdownQueue() {
+  if (not completionQueue_) {
+    return;
+  }
+  completionQueue_->Shutdown();
+  for (auto &worker : queueWorkers_) {
+    worker.join();
+  }
+  queueWorkers_.clear();
+  completionQueue_.reset();
+}
@@ -6,16 +6,22 @@
 #ifndef MAIN_SERVER_RUNNER_HPP
 #define MAIN_SERVER_RUNNER_HPP
 
+#include <thread>
+
 #include <grpc++/grpc++.h>
 #include <grpc++/impl/codegen/service_type.h>
 #include "common/result.hpp"
 #include "logger/logger.hpp"
+#include "network/impl/async_grpc_service.hpp"
 
 /**
  * Class runs Torii server for handling queries and commands.
  */
 class ServerRunner {
  public:
+  /// Number of threads polling the completion queue of asynchronous services
+  static constexpr size_t kQueueWorkers = 4;
+
   /**
    * Constructor. Initialize a new instance of ServerRunner class.
    * @param address - the address the server will be bind to in URI form
@@ -26,8 +32,11 @@ class ServerRunner {
                         bool reuse = true,
                         logger::Logger log = logger::log("ServerRunner"));
 
+  ~ServerRunner();
+
   /**
-   * Adds a new grpc service to be run.
+   * Adds a new grpc service to be run. Services implementing
+   * AsyncGrpcService are served from a completion queue of the server.
    * @param service - service to append.
    * @return reference to this with service appended
    */
@@ -55,6 +64,17 @@ class ServerRunner {
   void shutdown(const std::chrono::system_clock::time_point &deadline);
 
  private:
+  /**
+   * Poll the completion queue until it is shut down and drained
+   */
+  void handleQueue();
+
+  /**
+   * Shutdown the completion queue and wait for its workers. Must be called
+   * after the server is shut down
+   */
+  void shutdownQueue();
+
   logger::Logger log_;
 
   std::unique_ptr<grpc::Server> serverInstance_;
@@ -64,6 +84,11 @@ class ServerRunner {
   std::string serverAddress_;
   bool reuse_;
   std::vector<std::shared_ptr<grpc::Service>> services_;
+  std::vector<std::shared_ptr<iroha::network::AsyncGrpcService>>
+      asyncServices_;
+
+  std::unique_ptr<grpc::ServerCompletionQueue> completionQueue_;
+  std::vector<std::thread> queueWorkers_;
 };
 
 #endif  // MAIN_SERVER_RUNNER_HPP
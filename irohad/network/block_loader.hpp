@@ -24,11 +24,15 @@ namespace iroha {
        * Retrieve block from given peer starting from current top
        * @param height - top block height in requester's peer storage
        * @param peer_pubkey - peer for requesting blocks
-       * @return
+       * @param count - maximal number of blocks to retrieve, all blocks up to
+       * the top of the peer if 0
+       * @return observable of blocks, which is completed on the end of the
+       * range or on the first failure
        */
       virtual rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
       retrieveBlocks(const shared_model::interface::types::HeightType height,
-                     const shared_model::crypto::PublicKey &peer_pubkey) = 0;
+                     const shared_model::crypto::PublicKey &peer_pubkey,
+                     uint32_t count) = 0;
 
       /**
        * Retrieve block by its block_hash from given peer
@@ -0,0 +1,78 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_ASYNC_GRPC_SERVICE_HPP
+#define IROHA_ASYNC_GRPC_SERVICE_HPP
+
+#include <grpc++/grpc++.h>
+
+namespace iroha {
+  namespace network {
+
+    /**
+     * Tag of an operation posted to a server completion queue. Queue workers
+     * pass the outcome of the operation to the tag
+     */
+    class AsyncCallTag {
+     public:
+      virtual ~AsyncCallTag() = default;
+
+      /**
+       * Handle completion of the operation
+       * @param ok - whether the operation has succeeded
+       */
+      virtual void complete(bool ok) = 0;
+
+      /**
+       * @return pointer to be posted to the queue, workers cast it back to
+       * AsyncCallTag
+       */
+      void *tag() {
+        return this;
+      }
+    };
+
+    /**
+     * Tag which forwards completion of the operation to a member function of
+     * the call it belongs to
+     * @tparam Call - type of the call
+     */
+    template <typename Call>
+    class AsyncCallOperation : public AsyncCallTag {
+     public:
+      using Handler = void (Call::*)(bool);
+
+      AsyncCallOperation(Call *call, Handler handler)
+          : call_(call), handler_(handler) {}
+
+      void complete(bool ok) override {
+        (call_->*handler_)(ok);
+      }
+
+     private:
+      Call *call_;
+      Handler handler_;
+    };
+
+    /**
+     * gRPC service with methods which are served from a completion queue of
+     * the server. Every tag the service posts to the queue is an AsyncCallTag
+     */
+    class AsyncGrpcService {
+     public:
+      virtual ~AsyncGrpcService() = default;
+
+      /**
+       * Start waiting for calls of asynchronous methods. Invoked once the
+       * server is started, before the queue is polled
+       * @param cq - completion queue of the server
+       */
+      virtual void handleCalls(grpc::ServerCompletionQueue *cq) = 0;
+    };
+
+  }  // namespace network
+}  // namespace iroha
+
+#endif  // IROHA_ASYNC_GRPC_SERVICE_HPP
@@ -34,9 +34,10 @@ BlockLoaderImpl::BlockLoaderImpl(
 
 rxcpp::observable<std::shared_ptr<Block>> BlockLoaderImpl::retrieveBlocks(
     const shared_model::interface::types::HeightType height,
-    const PublicKey &peer_pubkey) {
+    const PublicKey &peer_pubkey,
+    uint32_t count) {
   return rxcpp::observable<>::create<std::shared_ptr<Block>>(
-      [this, height, &peer_pubkey](auto subscriber) {
+      [this, height, peer_pubkey, count](auto subscriber) {
         auto peer = this->findPeer(peer_pubkey);
         if (not peer) {
           log_->error(kPeerNotFound);
@@ -50,15 +51,20 @@ rxcpp::observable<std::shared_ptr<Block>> BlockLoaderImpl::retrieveBlocks(
 
         // request next block to our top
         request.set_height(height + 1);
+        request.set_count(count);
 
         auto reader =
             this->getPeerStub(**peer).retrieveBlocks(&context, request);
+        uint32_t received = 0;
         while (reader->Read(&block)) {
           auto proto_block = block_factory_.createBlock(std::move(block));
           proto_block.match(
-              [&subscriber](
-                  iroha::expected::Value<std::unique_ptr<Block>> &result) {
+              [&](iroha::expected::Value<std::unique_ptr<Block>> &result) {
                 subscriber.on_next(std::move(result.value));
+                // peers which do not know the count send blocks up to the top
+                if (++received == count) {
+                  context.TryCancel();
+                }
               },
               [this,
                &context](const iroha::expected::Error<std::string> &error) {
@@ -128,6 +134,7 @@ BlockLoaderImpl::findPeer(const shared_model::crypto::PublicKey &pubkey) {
 
 proto::Loader::Stub &BlockLoaderImpl::getPeerStub(
     const shared_model::interface::Peer &peer) {
+  std::lock_guard<std::mutex> lock(peer_connections_mutex_);
   auto it = peer_connections_.find(peer.address());
   if (it == peer_connections_.end()) {
     it = peer_connections_
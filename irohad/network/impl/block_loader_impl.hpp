@@ -8,6 +8,7 @@
 
 #include "network/block_loader.hpp"
 
+#include <mutex>
 #include <unordered_map>
 
 #include "ametsuchi/peer_query_factory.hpp"
@@ -25,9 +26,9 @@ namespace iroha {
           logger::Logger log = logger::log("BlockLoaderImpl"));
 
       rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
-      retrieveBlocks(
-          const shared_model::interface::types::HeightType height,
-          const shared_model::crypto::PublicKey &peer_pubkey) override;
+      retrieveBlocks(const shared_model::interface::types::HeightType height,
+                     const shared_model::crypto::PublicKey &peer_pubkey,
+                     uint32_t count) override;
 
       boost::optional<std::shared_ptr<shared_model::interface::Block>>
       retrieveBlock(
@@ -54,6 +55,8 @@ namespace iroha {
       std::unordered_map<shared_model::interface::types::AddressType,
                          std::unique_ptr<proto::Loader::Stub>>
           peer_connections_;
+      /// blocks may be retrieved from several threads at once
+      std::mutex peer_connections_mutex_;
       std::shared_ptr<ametsuchi::PeerQueryFactory> peer_query_factory_;
       shared_model::proto::ProtoBlockFactory block_factory_;
 
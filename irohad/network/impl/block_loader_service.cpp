@@ -4,8 +4,10 @@
  */
 
 #include "network/impl/block_loader_service.hpp"
+
+#include <algorithm>
+
 #include "backend/protobuf/block.hpp"
-#include "common/bind.hpp"
 
 using namespace iroha;
 using namespace iroha::ametsuchi;
@@ -20,22 +22,53 @@ BlockLoaderService::BlockLoaderService(
       consensus_result_cache_(std::move(consensus_result_cache)),
       log_(std::move(log)) {}
 
+namespace {
+  protocol::Block toProto(const shared_model::interface::Block &block) {
+    protocol::Block proto_block;
+    *proto_block.mutable_block_v1() =
+        static_cast<const shared_model::proto::Block &>(block).getTransport();
+    return proto_block;
+  }
+}  // namespace
+
+constexpr uint32_t BlockLoaderService::kBlocksPerRead;
+
 grpc::Status BlockLoaderService::retrieveBlocks(
     ::grpc::ServerContext *context,
     const proto::BlocksRequest *request,
     ::grpc::ServerWriter<::iroha::protocol::Block> *writer) {
-  auto blocks = block_query_factory_->createBlockQuery() |
-      [height = request->height()](const auto &block_query) {
-        return block_query->getBlocksFrom(height);
-      };
-  std::for_each(blocks.begin(), blocks.end(), [&writer](const auto &block) {
-    protocol::Block proto_block;
-    *proto_block.mutable_block_v1() =
-        std::dynamic_pointer_cast<shared_model::proto::Block>(block)
-            ->getTransport();
+  auto block_query = block_query_factory_->createBlockQuery();
+  if (not block_query) {
+    log_->error("Could not create block query to retrieve blocks");
+    return grpc::Status(grpc::StatusCode::INTERNAL, "internal error happened");
+  }
 
-    writer->Write(proto_block);
-  });
+  // blocks are read in small chunks, and each of them is written before the
+  // next chunk is read. Write blocks until the transport accepts the
+  // message, so a slow peer holds back reading instead of piling up blocks
+  auto top_height = static_cast<shared_model::interface::types::HeightType>(
+      (*block_query)->getTopBlockHeight());
+  if (request->count() > 0) {
+    top_height = std::min(top_height, request->height() + request->count() - 1);
+  }
+  for (auto height = request->height(); height <= top_height;
+       height += kBlocksPerRead) {
+    if (context->IsCancelled()) {
+      log_->info("Retrieval of blocks is cancelled at height {}", height);
+      return grpc::Status::CANCELLED;
+    }
+    auto blocks = (*block_query)->getBlocks(
+        height,
+        static_cast<uint32_t>(
+            std::min<shared_model::interface::types::HeightType>(
+                kBlocksPerRead, top_height - height + 1)));
+    for (const auto &block : blocks) {
+      if (not writer->Write(toProto(*block))) {
+        log_->info("Stream of blocks is closed at height {}", block->height());
+        return grpc::Status::CANCELLED;
+      }
+    }
+  }
   return grpc::Status::OK;
 }
 
@@ -54,10 +87,7 @@ grpc::Status BlockLoaderService::retrieveBlock(
   auto block = consensus_result_cache_->get();
   if (block) {
     if (block->hash() == hash) {
-      auto block_v1 =
-          std::static_pointer_cast<shared_model::proto::Block>(block)
-              ->getTransport();
-      *response->mutable_block_v1() = block_v1;
+      *response = toProto(*block);
       return grpc::Status::OK;
     } else {
       log_->info(
@@ -74,30 +104,34 @@ grpc::Status BlockLoaderService::retrieveBlock(
   }
 
   // cache missed: notify and try to fetch the block from block storage itself
-  auto blocks = block_query_factory_->createBlockQuery() |
-      // TODO [IR-1757] Akvinikym 12.10.18: use block height to get one block
-      // instead of the whole chain
-      [](const auto &block_query) {
-        return boost::make_optional(block_query->getBlocksFrom(1));
-      };
-  if (not blocks) {
+  auto block_query = block_query_factory_->createBlockQuery();
+  if (not block_query) {
     log_->error("Could not create block query to retrieve block from storage");
     return grpc::Status(grpc::StatusCode::INTERNAL, "internal error happened");
   }
 
-  auto found_block = std::find_if(
-      std::begin(*blocks), std::end(*blocks), [&hash](const auto &block) {
-        return block->hash() == hash;
-      });
-  if (found_block == std::end(*blocks)) {
+  auto found_block = findBlock(**block_query, hash);
+  if (not found_block) {
     log_->error("Could not retrieve a block from block storage: requested {}",
                 hash.hex());
     return grpc::Status(grpc::StatusCode::NOT_FOUND, "Block not found");
   }
 
-  auto block_v1 =
-      std::static_pointer_cast<shared_model::proto::Block>(*found_block)
-          ->getTransport();
-  *response->mutable_block_v1() = block_v1;
+  *response = toProto(*found_block);
   return grpc::Status::OK;
 }
+
+std::shared_ptr<shared_model::interface::Block> BlockLoaderService::findBlock(
+    BlockQuery &block_query, const shared_model::crypto::Hash &hash) const {
+  auto height = block_query.getBlockHeight(hash);
+  if (not height) {
+    return nullptr;
+  }
+  auto blocks = block_query.getBlocks(*height, 1);
+  if (blocks.empty() or blocks.front()->hash() != hash) {
+    log_->error("Index of block hashes points to another block at height {}",
+                *height);
+    return nullptr;
+  }
+  return blocks.front();
+}
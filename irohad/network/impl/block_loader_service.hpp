@@ -13,8 +13,16 @@
 
 namespace iroha {
   namespace network {
+    /**
+     * Serves blocks of the ledger to other peers. Blocks are read from
+     * storage a few at a time, so memory use does not depend on the length
+     * of the chain
+     */
     class BlockLoaderService : public proto::Loader::Service {
      public:
+      /// Number of blocks read from storage at once
+      static constexpr uint32_t kBlocksPerRead = 16;
+
       BlockLoaderService(
           std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory,
           std::shared_ptr<iroha::consensus::ConsensusResultCache>
@@ -31,6 +39,16 @@ namespace iroha {
                                  protocol::Block *response) override;
 
      private:
+      /**
+       * Find a block in storage by the index of block hashes
+       * @param block_query - storage to look in
+       * @param hash - hash of the block
+       * @return the block or nullptr if it is not found
+       */
+      std::shared_ptr<shared_model::interface::Block> findBlock(
+          ametsuchi::BlockQuery &block_query,
+          const shared_model::crypto::Hash &hash) const;
+
       std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory_;
       std::shared_ptr<iroha::consensus::ConsensusResultCache>
           consensus_result_cache_;
@@ -0,0 +1,180 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ordering/impl/on_demand_batch_coalescer.hpp"
+
+#include <algorithm>
+
+#include "interfaces/iroha_internal/proposal.hpp"
+
+using namespace iroha;
+using namespace iroha::ordering;
+
+constexpr uint64_t BatchCoalescerMetrics::kReportPeriod;
+constexpr std::chrono::milliseconds
+    OnDemandBatchCoalescerFactory::kDefaultFlushDelay;
+constexpr size_t OnDemandBatchCoalescerFactory::kDefaultMaxBatches;
+
+BatchCoalescerMetrics::BatchCoalescerMetrics(logger::Logger log)
+    : requests_(0),
+      batches_(0),
+      total_delay_us_(0),
+      max_delay_us_(0),
+      log_(std::move(log)) {}
+
+void BatchCoalescerMetrics::record(uint64_t batches,
+                                   std::chrono::microseconds total_delay,
+                                   std::chrono::microseconds max_delay) {
+  batches_ += batches;
+  total_delay_us_ += total_delay.count();
+  auto max_delay_us = static_cast<uint64_t>(max_delay.count());
+  auto current_max = max_delay_us_.load();
+  while (current_max < max_delay_us
+         and not max_delay_us_.compare_exchange_weak(current_max,
+                                                     max_delay_us)) {
+  }
+
+  if (++requests_ % kReportPeriod == 0) {
+    auto m = metrics();
+    log_->info(
+        "Sent {} requests with {} batches, {:.2f} batches per request, "
+        "{} us average and {} us maximal delay of a batch",
+        m.requests,
+        m.batches,
+        static_cast<double>(m.batches) / m.requests,
+        m.total_delay.count() / std::max<uint64_t>(1, m.batches),
+        m.max_delay.count());
+  }
+}
+
+BatchCoalescerMetrics::Metrics BatchCoalescerMetrics::metrics() const {
+  return Metrics{requests_.load(),
+                 batches_.load(),
+                 std::chrono::microseconds(total_delay_us_.load()),
+                 std::chrono::microseconds(max_delay_us_.load())};
+}
+
+OnDemandBatchCoalescer::OnDemandBatchCoalescer(
+    std::unique_ptr<transport::OdOsNotification> connection,
+    std::function<rxcpp::observable<DelayType>()> flush_delay,
+    size_t max_batches,
+    std::shared_ptr<BatchCoalescerMetrics> metrics)
+    : queue_(std::make_shared<Queue>()),
+      flush_delay_(std::move(flush_delay)),
+      max_batches_(max_batches) {
+  queue_->connection = std::move(connection);
+  queue_->metrics = std::move(metrics);
+}
+
+OnDemandBatchCoalescer::~OnDemandBatchCoalescer() {
+  std::lock_guard<std::mutex> lock(queue_->mutex);
+  queue_->timer.unsubscribe();
+  flush(*queue_);
+}
+
+void OnDemandBatchCoalescer::onBatches(consensus::Round round,
+                                       CollectionType batches) {
+  rxcpp::composite_subscription timer;
+  uint64_t generation;
+  {
+    std::lock_guard<std::mutex> lock(queue_->mutex);
+    // a request carries batches for a single round
+    if (not queue_->batches.empty() and queue_->round != round) {
+      flush(*queue_);
+    }
+
+    const bool start_timer = queue_->batches.empty();
+    auto now = ClockType::now();
+    queue_->round = round;
+    for (auto &batch : batches) {
+      queue_->batches.push_back(std::move(batch));
+      queue_->arrivals.push_back(now);
+    }
+
+    if (queue_->batches.size() >= max_batches_) {
+      flush(*queue_);
+      return;
+    }
+    if (not start_timer or queue_->batches.empty()) {
+      return;
+    }
+    queue_->timer = timer;
+    generation = queue_->generation;
+  }
+
+  // timer is started outside of the lock, since the delay may emit at once
+  std::weak_ptr<Queue> weak_queue = queue_;
+  flush_delay_().subscribe(timer, [weak_queue, generation](auto) {
+    if (auto queue = weak_queue.lock()) {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      if (queue->generation == generation) {
+        flush(*queue);
+      }
+    }
+  });
+}
+
+boost::optional<OnDemandBatchCoalescer::ProposalType>
+OnDemandBatchCoalescer::onRequestProposal(consensus::Round round) {
+  return queue_->connection->onRequestProposal(round);
+}
+
+void OnDemandBatchCoalescer::flush(Queue &queue) {
+  if (queue.batches.empty()) {
+    return;
+  }
+
+  auto now = ClockType::now();
+  std::chrono::microseconds total_delay{0}, max_delay{0};
+  for (const auto &arrival : queue.arrivals) {
+    auto delay =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - arrival);
+    total_delay += delay;
+    max_delay = std::max(max_delay, delay);
+  }
+  queue.metrics->record(queue.batches.size(), total_delay, max_delay);
+
+  CollectionType batches;
+  batches.swap(queue.batches);
+  queue.arrivals.clear();
+  ++queue.generation;
+  queue.connection->onBatches(queue.round, std::move(batches));
+}
+
+OnDemandBatchCoalescerFactory::OnDemandBatchCoalescerFactory(
+    std::shared_ptr<transport::OdOsNotificationFactory> factory,
+    std::chrono::milliseconds flush_delay,
+    size_t max_batches)
+    : OnDemandBatchCoalescerFactory(
+          std::move(factory),
+          [flush_delay] {
+            // static allows to reuse the same thread for all timers
+            static rxcpp::observe_on_one_worker coordination(
+                rxcpp::observe_on_new_thread()
+                    .create_coordinator()
+                    .get_scheduler());
+            return rxcpp::observable<>::timer(flush_delay, coordination);
+          },
+          max_batches) {}
+
+OnDemandBatchCoalescerFactory::OnDemandBatchCoalescerFactory(
+    std::shared_ptr<transport::OdOsNotificationFactory> factory,
+    std::function<rxcpp::observable<OnDemandBatchCoalescer::DelayType>()>
+        flush_delay,
+    size_t max_batches)
+    : factory_(std::move(factory)),
+      flush_delay_(std::move(flush_delay)),
+      max_batches_(max_batches),
+      metrics_(std::make_shared<BatchCoalescerMetrics>()) {}
+
+std::unique_ptr<transport::OdOsNotification>
+OnDemandBatchCoalescerFactory::create(const shared_model::interface::Peer &to) {
+  return std::make_unique<OnDemandBatchCoalescer>(
+      factory_->create(to), flush_delay_, max_batches_, metrics_);
+}
+
+BatchCoalescerMetrics::Metrics OnDemandBatchCoalescerFactory::metrics() const {
+  return metrics_->metrics();
+}
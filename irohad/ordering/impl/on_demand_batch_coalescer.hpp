@@ -0,0 +1,186 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_ON_DEMAND_BATCH_COALESCER_HPP
+#define IROHA_ON_DEMAND_BATCH_COALESCER_HPP
+
+#include "ordering/on_demand_os_transport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include <rxcpp/rx.hpp>
+#include "logger/logger.hpp"
+
+namespace iroha {
+  namespace ordering {
+
+    /**
+     * Counters of batches sent by coalescing connections to all peers
+     */
+    class BatchCoalescerMetrics {
+     public:
+      /// Number of sent requests between reports to the log
+      static constexpr uint64_t kReportPeriod = 1000;
+
+      struct Metrics {
+        /// number of sent requests
+        uint64_t requests;
+        /// number of batches in sent requests
+        uint64_t batches;
+        /// sum of times batches waited in the queue before being sent
+        std::chrono::microseconds total_delay;
+        /// maximal time a batch waited in the queue before being sent
+        std::chrono::microseconds max_delay;
+      };
+
+      explicit BatchCoalescerMetrics(
+          logger::Logger log = logger::log("BatchCoalescerMetrics"));
+
+      /**
+       * Account a sent request
+       * @param batches - number of batches in the request
+       * @param total_delay - sum of times the batches waited in the queue
+       * @param max_delay - maximal time a batch waited in the queue
+       */
+      void record(uint64_t batches,
+                  std::chrono::microseconds total_delay,
+                  std::chrono::microseconds max_delay);
+
+      /**
+       * @return current counters
+       */
+      Metrics metrics() const;
+
+     private:
+      std::atomic<uint64_t> requests_;
+      std::atomic<uint64_t> batches_;
+      std::atomic<uint64_t> total_delay_us_;
+      std::atomic<uint64_t> max_delay_us_;
+
+      logger::Logger log_;
+    };
+
+    /**
+     * Connection to a peer which accumulates batches for the same round and
+     * sends them in a single request, either when enough batches are queued
+     * or when the first queued batch has waited for the flush delay
+     */
+    class OnDemandBatchCoalescer : public transport::OdOsNotification {
+     public:
+      /// Delay observable type
+      using DelayType = long;
+
+      /**
+       * @param connection - connection to the peer
+       * @param flush_delay - cold observable which emits when the queue has
+       * to be sent after the first batch is added
+       * @param max_batches - number of queued batches which are sent
+       * immediately
+       * @param metrics - counters of sent requests
+       */
+      OnDemandBatchCoalescer(
+          std::unique_ptr<transport::OdOsNotification> connection,
+          std::function<rxcpp::observable<DelayType>()> flush_delay,
+          size_t max_batches,
+          std::shared_ptr<BatchCoalescerMetrics> metrics);
+
+      /**
+       * Queued batches are sent on destruction
+       */
+      ~OnDemandBatchCoalescer() override;
+
+      void onBatches(consensus::Round round, CollectionType batches) override;
+
+      boost::optional<ProposalType> onRequestProposal(
+          consensus::Round round) override;
+
+     private:
+      using ClockType = std::chrono::steady_clock;
+
+      /**
+       * Batches waiting to be sent, shared with the flush timer, which may
+       * fire after the coalescer is destroyed
+       */
+      struct Queue {
+        std::unique_ptr<transport::OdOsNotification> connection;
+        std::shared_ptr<BatchCoalescerMetrics> metrics;
+
+        std::mutex mutex;
+        consensus::Round round;
+        CollectionType batches;
+        std::vector<ClockType::time_point> arrivals;
+        /// incremented on every flush, so a timer of a sent queue is ignored
+        uint64_t generation = 0;
+        rxcpp::composite_subscription timer;
+      };
+
+      /**
+       * Send queued batches with a single request, queue mutex must be held
+       */
+      static void flush(Queue &queue);
+
+      std::shared_ptr<Queue> queue_;
+      std::function<rxcpp::observable<DelayType>()> flush_delay_;
+      const size_t max_batches_;
+    };
+
+    /**
+     * Factory which wraps connections to peers into coalescing ones
+     */
+    class OnDemandBatchCoalescerFactory
+        : public transport::OdOsNotificationFactory {
+     public:
+      /// Default time the first batch of a queue waits for more batches
+      static constexpr std::chrono::milliseconds kDefaultFlushDelay{5};
+      /// Default number of queued batches which are sent immediately
+      static constexpr size_t kDefaultMaxBatches = 64;
+
+      /**
+       * @param factory - factory of connections to peers
+       * @param flush_delay - time the first batch of a queue waits for more
+       * batches
+       * @param max_batches - number of queued batches which are sent
+       * immediately
+       */
+      OnDemandBatchCoalescerFactory(
+          std::shared_ptr<transport::OdOsNotificationFactory> factory,
+          std::chrono::milliseconds flush_delay = kDefaultFlushDelay,
+          size_t max_batches = kDefaultMaxBatches);
+
+      /**
+       * @param factory - factory of connections to peers
+       * @param flush_delay - cold observable which emits when a queue has to
+       * be sent after the first batch is added
+       * @param max_batches - number of queued batches which are sent
+       * immediately
+       */
+      OnDemandBatchCoalescerFactory(
+          std::shared_ptr<transport::OdOsNotificationFactory> factory,
+          std::function<rxcpp::observable<OnDemandBatchCoalescer::DelayType>()>
+              flush_delay,
+          size_t max_batches);
+
+      std::unique_ptr<transport::OdOsNotification> create(
+          const shared_model::interface::Peer &to) override;
+
+      /**
+       * @return counters of requests sent by all created connections
+       */
+      BatchCoalescerMetrics::Metrics metrics() const;
+
+     private:
+      std::shared_ptr<transport::OdOsNotificationFactory> factory_;
+      std::function<rxcpp::observable<OnDemandBatchCoalescer::DelayType>()>
+          flush_delay_;
+      const size_t max_batches_;
+      std::shared_ptr<BatchCoalescerMetrics> metrics_;
+    };
+
+  }  // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_ON_DEMAND_BATCH_COALESCER_HPP
@@ -5,6 +5,8 @@
 
 #include "ordering/impl/on_demand_connection_manager.hpp"
 
+#include <chrono>
+
 #include <boost/range/combine.hpp>
 #include "interfaces/iroha_internal/proposal.hpp"
 #include "ordering/impl/on_demand_common.hpp"
@@ -15,6 +17,7 @@ using namespace iroha::ordering;
 OnDemandConnectionManager::OnDemandConnectionManager(
     std::shared_ptr<transport::OdOsNotificationFactory> factory,
     rxcpp::observable<CurrentPeers> peers,
+    rxcpp::schedulers::scheduler prefetch_scheduler,
     logger::Logger log)
     : log_(std::move(log)),
       factory_(std::move(factory)),
@@ -23,20 +26,27 @@ OnDemandConnectionManager::OnDemandConnectionManager(
         std::lock_guard<std::shared_timed_mutex> lock(mutex_);
 
         this->initializeConnections(peers);
-      })) {}
+      })),
+      prefetch_worker_(prefetch_scheduler.create_worker()) {}
 
 OnDemandConnectionManager::OnDemandConnectionManager(
     std::shared_ptr<transport::OdOsNotificationFactory> factory,
     rxcpp::observable<CurrentPeers> peers,
     CurrentPeers initial_peers,
+    rxcpp::schedulers::scheduler prefetch_scheduler,
     logger::Logger log)
-    : OnDemandConnectionManager(std::move(factory), peers, std::move(log)) {
+    : OnDemandConnectionManager(std::move(factory),
+                                peers,
+                                std::move(prefetch_scheduler),
+                                std::move(log)) {
   // using start_with(initial_peers) results in deadlock
   initializeConnections(initial_peers);
 }
 
 OnDemandConnectionManager::~OnDemandConnectionManager() {
   subscription_.unsubscribe();
+  // requests which are already running keep their connections alive
+  prefetch_worker_.unsubscribe();
 }
 
 void OnDemandConnectionManager::onBatches(consensus::Round round,
@@ -77,7 +87,25 @@ OnDemandConnectionManager::onRequestProposal(consensus::Round round) {
 
   log_->debug("onRequestProposal, {}", round);
 
-  return connections_.peers[kIssuer]->onRequestProposal(round);
+  boost::optional<ProposalType> proposal;
+  if (auto prefetched = takePrefetched(round)) {
+    // the proposal may be shared with a speculative validation
+    if (auto prefetched_proposal = prefetched->get()) {
+      proposal = clone(**prefetched_proposal);
+    }
+    log_->debug("onRequestProposal, prefetched proposal is {}found",
+                proposal ? "" : "NOT ");
+  }
+  if (not proposal) {
+    proposal = connections_.peers[kIssuer]->onRequestProposal(round);
+  }
+
+  // next round proposals are packed by their issuers after the current round
+  // has started, so they are likely available by the time requests arrive
+  prefetch(kNextRejectRoundIssuer, nextRejectRound(round));
+  prefetch(kNextCommitRoundIssuer, nextCommitRound(round));
+
+  return proposal;
 }
 
 void OnDemandConnectionManager::initializeConnections(
@@ -89,4 +117,64 @@ void OnDemandConnectionManager::initializeConnections(
   for (auto &&pair : boost::combine(connections_.peers, peers.peers)) {
     create_assign(boost::get<0>(pair), boost::get<1>(pair));
   }
+  peers_ = peers;
+}
+
+boost::optional<std::shared_ptr<shared_model::interface::Proposal>>
+OnDemandConnectionManager::prefetchedProposal(const consensus::Round &round) {
+  PrefetchedProposal prefetched;
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    auto it = prefetched_.find(round);
+    if (it == prefetched_.end()) {
+      return boost::none;
+    }
+    prefetched = it->second.proposal;
+  }
+  if (prefetched.wait_for(std::chrono::seconds(0))
+      != std::future_status::ready) {
+    return boost::none;
+  }
+  return prefetched.get();
+}
+
+boost::optional<OnDemandConnectionManager::PrefetchedProposal>
+OnDemandConnectionManager::takePrefetched(const consensus::Round &round) {
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  boost::optional<PrefetchedProposal> result;
+  auto it = prefetched_.find(round);
+  // proposal from a peer which has not become the issuer is not used, since
+  // it may differ from the one other peers vote for
+  const auto &issuer = peers_.peers[kIssuer];
+  if (it != prefetched_.end()
+      and (it->second.issuer == issuer or *it->second.issuer == *issuer)) {
+    result = it->second.proposal;
+  }
+  prefetched_.clear();
+  return result;
+}
+
+void OnDemandConnectionManager::prefetch(PeerType issuer,
+                                         const consensus::Round &round) {
+  auto promise = std::make_shared<std::promise<
+      boost::optional<std::shared_ptr<shared_model::interface::Proposal>>>>();
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    prefetched_[round] =
+        Prefetch{peers_.peers[issuer], promise->get_future().share()};
+  }
+  // the request may outlive the manager, so it does not refer to its members
+  prefetch_worker_.schedule(
+      [log = log_, connection = connections_.peers[issuer], round, promise](
+          const rxcpp::schedulers::schedulable &) {
+        log->debug("prefetch, {}", round);
+        auto proposal = connection->onRequestProposal(round);
+        if (proposal) {
+          promise->set_value(
+              std::shared_ptr<shared_model::interface::Proposal>(
+                  std::move(*proposal)));
+        } else {
+          promise->set_value(boost::none);
+        }
+      });
 }
@@ -8,7 +8,10 @@
 
 #include "ordering/on_demand_os_transport.hpp"
 
+#include <future>
+#include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
 
 #include <rxcpp/rx.hpp>
 #include "logger/logger.hpp"
@@ -27,12 +30,16 @@ namespace iroha {
        * reject round for current block, reject round for next block, and
        * commit for subsequent next round
        * Proposal is requested from the current ordering service: issuer
+       * Proposals of the next reject round and of the next commit round are
+       * requested in advance from their expected issuers
        */
       enum PeerType {
         kCurrentRoundRejectConsumer = 0,
         kNextRoundRejectConsumer,
         kNextRoundCommitConsumer,
         kIssuer,
+        kNextRejectRoundIssuer,
+        kNextCommitRoundIssuer,
         kCount
       };
 
@@ -49,31 +56,72 @@ namespace iroha {
             peers;
       };
 
+      /**
+       * @param factory - factory of connections to peers
+       * @param peers - peers for each new round
+       * @param prefetch_scheduler - scheduler of requests for proposals of
+       * the next rounds
+       * @param log - logger
+       */
       OnDemandConnectionManager(
           std::shared_ptr<transport::OdOsNotificationFactory> factory,
           rxcpp::observable<CurrentPeers> peers,
+          rxcpp::schedulers::scheduler prefetch_scheduler =
+              rxcpp::schedulers::make_new_thread(),
           logger::Logger log = logger::log("OnDemandConnectionManager"));
 
       OnDemandConnectionManager(
           std::shared_ptr<transport::OdOsNotificationFactory> factory,
           rxcpp::observable<CurrentPeers> peers,
           CurrentPeers initial_peers,
+          rxcpp::schedulers::scheduler prefetch_scheduler =
+              rxcpp::schedulers::make_new_thread(),
           logger::Logger log = logger::log("OnDemandConnectionManager"));
 
       ~OnDemandConnectionManager() override;
 
       void onBatches(consensus::Round round, CollectionType batches) override;
 
+      /**
+       * Proposal is taken from the prefetched ones if it was requested from
+       * the current issuer, otherwise it is requested synchronously. Proposals
+       * of the next rounds are prefetched afterwards
+       */
       boost::optional<ProposalType> onRequestProposal(
           consensus::Round round) override;
 
+      /**
+       * Get the proposal prefetched for the round from its expected issuer,
+       * without waiting for the request to complete. The proposal is kept
+       * for onRequestProposal
+       * @param round - one of the next rounds of the last requested round
+       * @return prefetched proposal, none if it was not prefetched, has not
+       * arrived yet or the issuer had no proposal
+       */
+      boost::optional<std::shared_ptr<shared_model::interface::Proposal>>
+      prefetchedProposal(const consensus::Round &round);
+
      private:
       /**
        * Corresponding connections created by OdOsNotificationFactory
        * @see PeerType for individual descriptions
        */
       struct CurrentConnections {
-        PeerCollectionType<std::unique_ptr<transport::OdOsNotification>> peers;
+        PeerCollectionType<std::shared_ptr<transport::OdOsNotification>>
+            peers;
+      };
+
+      /// Result of a request made in advance
+      using PrefetchedProposal = std::shared_future<
+          boost::optional<std::shared_ptr<shared_model::interface::Proposal>>>;
+
+      /**
+       * Proposal requested in advance
+       */
+      struct Prefetch {
+        /// peer the proposal was requested from
+        std::shared_ptr<shared_model::interface::Peer> issuer;
+        PrefetchedProposal proposal;
       };
 
       /**
@@ -82,13 +130,33 @@ namespace iroha {
        */
       void initializeConnections(const CurrentPeers &peers);
 
+      /**
+       * Take the proposal prefetched for the round from the current issuer
+       * and discard the rest of prefetched proposals
+       * Note: mutex_ must be held
+       */
+      boost::optional<PrefetchedProposal> takePrefetched(
+          const consensus::Round &round);
+
+      /**
+       * Request the proposal for the round from the given peer in background
+       * Note: mutex_ must be held
+       */
+      void prefetch(PeerType issuer, const consensus::Round &round);
+
       logger::Logger log_;
       std::shared_ptr<transport::OdOsNotificationFactory> factory_;
       rxcpp::composite_subscription subscription_;
 
+      CurrentPeers peers_;
       CurrentConnections connections_;
 
       std::shared_timed_mutex mutex_;
+
+      rxcpp::schedulers::worker prefetch_worker_;
+      std::unordered_map<consensus::Round, Prefetch, consensus::RoundTypeHasher>
+          prefetched_;
+      std::mutex prefetch_mutex_;
     };
 
   }  // namespace ordering
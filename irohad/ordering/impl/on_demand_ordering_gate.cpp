@@ -9,6 +9,7 @@
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/empty.hpp>
+#include <boost/range/irange.hpp>
 #include "ametsuchi/tx_presence_cache.hpp"
 #include "common/visitor.hpp"
 #include "interfaces/iroha_internal/transaction_batch_parser_impl.hpp"
@@ -31,7 +32,7 @@ OnDemandOrderingGate::OnDemandOrderingGate(
       network_client_(std::move(network_client)),
       events_subscription_(events.subscribe([this](auto event) {
         // exclusive lock
-        std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+        std::unique_lock<std::shared_timed_mutex> lock(mutex_);
 
         visit_in_place(event,
                        [this](const BlockEvent &block_event) {
@@ -60,12 +61,18 @@ OnDemandOrderingGate::OnDemandOrderingGate(
         // notify our ordering service about new round
         ordering_service_->onCollaborationOutcome(current_round_);
 
-        // request proposal for the current round
+        // events are delivered sequentially, so the round is not changed
+        // while batches are propagated without the lock during the request
+        auto round = current_round_;
+        lock.unlock();
+
+        // request proposal for the current round, it is usually prefetched
+        // by the network client during the previous round
         auto proposal = this->processProposalRequest(
-            network_client_->onRequestProposal(current_round_));
+            network_client_->onRequestProposal(round));
         // vote for the object received from the network
         proposal_notifier_.get_subscriber().on_next(
-            network::OrderingEvent{proposal, current_round_});
+            network::OrderingEvent{proposal, round});
       })),
       cache_(std::move(cache)),
       proposal_factory_(std::move(factory)),
@@ -111,15 +118,19 @@ OnDemandOrderingGate::processProposalRequest(
 boost::optional<std::shared_ptr<shared_model::interface::Proposal>>
 OnDemandOrderingGate::removeReplays(
     shared_model::interface::Proposal &&proposal) const {
-  std::vector<bool> proposal_txs_validation_results;
-  auto tx_is_not_processed = [this](const auto &tx) {
-    auto tx_result = tx_cache_->check(tx.hash());
-    if (not tx_result) {
+  // statuses of all transactions of the proposal are fetched at once
+  std::vector<shared_model::crypto::Hash> hashes;
+  for (const auto &tx : proposal.transactions()) {
+    hashes.push_back(tx.hash());
+  }
+  auto tx_statuses = tx_cache_->check(hashes);
+  auto tx_is_not_processed = [&tx_statuses](size_t index) {
+    if (not tx_statuses or tx_statuses->size() <= index) {
       // TODO andrei 30.11.18 IR-51 Handle database error
       return false;
     }
     return iroha::visit_in_place(
-        *tx_result,
+        tx_statuses->at(index),
         [](const ametsuchi::tx_cache_status_responses::Missing &) {
           return true;
         },
@@ -132,10 +143,13 @@ OnDemandOrderingGate::removeReplays(
 
   shared_model::interface::TransactionBatchParserImpl batch_parser;
 
+  std::vector<bool> proposal_txs_validation_results;
   auto batches = batch_parser.parseBatches(proposal.transactions());
   for (auto &batch : batches) {
+    auto first = proposal_txs_validation_results.size();
+    auto indexes = boost::irange(first, first + batch.size());
     bool batch_validation_result =
-        std::all_of(batch.begin(), batch.end(), tx_is_not_processed);
+        std::all_of(indexes.begin(), indexes.end(), tx_is_not_processed);
     proposal_txs_validation_results.insert(
         proposal_txs_validation_results.end(),
         batch.size(),
@@ -5,8 +5,6 @@
 
 #include "ordering/impl/on_demand_ordering_service_impl.hpp"
 
-#include <unordered_set>
-
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/indirected.hpp>
 #include <boost/range/adaptor/transformed.hpp>
@@ -23,6 +21,8 @@
 using namespace iroha;
 using namespace iroha::ordering;
 
+constexpr size_t OnDemandOrderingServiceImpl::kDefaultMaxLeftoverBatches;
+
 OnDemandOrderingServiceImpl::OnDemandOrderingServiceImpl(
     size_t transaction_limit,
     std::shared_ptr<shared_model::interface::UnsafeProposalFactory>
@@ -30,9 +30,13 @@ OnDemandOrderingServiceImpl::OnDemandOrderingServiceImpl(
     std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
     size_t number_of_proposals,
     const consensus::Round &initial_round,
+    std::shared_ptr<transport::OdOsNotification> leftovers_consumer,
+    size_t max_leftover_batches,
     logger::Logger log)
     : transaction_limit_(transaction_limit),
       number_of_proposals_(number_of_proposals),
+      leftovers_consumer_(std::move(leftovers_consumer)),
+      max_leftover_batches_(max_leftover_batches),
       proposal_factory_(std::move(proposal_factory)),
       tx_cache_(std::move(tx_cache)),
       log_(std::move(log)) {
@@ -44,28 +48,29 @@ OnDemandOrderingServiceImpl::OnDemandOrderingServiceImpl(
 void OnDemandOrderingServiceImpl::onCollaborationOutcome(
     consensus::Round round) {
   log_->info("onCollaborationOutcome => {}", round);
-  // exclusive write lock
-  std::lock_guard<std::shared_timed_mutex> guard(lock_);
-  log_->debug("onCollaborationOutcome => write lock is acquired");
+  CollectionType leftovers;
+  {
+    // exclusive write lock
+    std::lock_guard<std::shared_timed_mutex> guard(lock_);
+    log_->debug("onCollaborationOutcome => write lock is acquired");
 
-  packNextProposals(round);
-  tryErase();
+    leftovers = packNextProposals(round);
+    tryErase();
+  }
+  forwardLeftovers(round, std::move(leftovers));
 }
 
 // ----------------------------| OdOsNotification |-----------------------------
 
 void OnDemandOrderingServiceImpl::onBatches(consensus::Round round,
                                             CollectionType batches) {
-  // read lock
-  std::shared_lock<std::shared_timed_mutex> guard(lock_);
   log_->info("onBatches => collection size = {}, {}", batches.size(), round);
+  // the cache is queried before taking the lock, so packing of proposals does
+  // not wait for the storage
+  auto processed_batches = batchesAlreadyProcessed(batches);
 
-  auto unprocessed_batches =
-      boost::adaptors::filter(batches, [this](const auto &batch) {
-        log_->info("check batch {} for already processed transactions",
-                   batch->reducedHash().hex());
-        return not this->batchAlreadyProcessed(*batch);
-      });
+  // read lock
+  std::shared_lock<std::shared_timed_mutex> guard(lock_);
   auto it = current_proposals_.find(round);
   if (it == current_proposals_.end()) {
     it =
@@ -81,10 +86,15 @@ void OnDemandOrderingServiceImpl::onBatches(consensus::Round round,
                      "No place to store the batches!");
     log_->debug("onBatches => collection will be inserted to {}", it->first);
   }
-  std::for_each(unprocessed_batches.begin(),
-                unprocessed_batches.end(),
-                [&it](auto &obj) { it->second.push(std::move(obj)); });
-  log_->debug("onBatches => collection is inserted");
+  size_t duplicates = 0;
+  for (size_t i = 0; i < batches.size(); ++i) {
+    if (not processed_batches.at(i)
+        and not it->second.insert(std::move(batches[i]))) {
+      ++duplicates;
+    }
+  }
+  log_->debug("onBatches => collection is inserted, {} duplicates skipped",
+              duplicates);
 }
 
 boost::optional<OnDemandOrderingServiceImpl::ProposalType>
@@ -106,19 +116,24 @@ OnDemandOrderingServiceImpl::onRequestProposal(consensus::Round round) {
 
 // ---------------------------------| Private |---------------------------------
 
-void OnDemandOrderingServiceImpl::packNextProposals(
-    const consensus::Round &round) {
-  auto close_round = [this](consensus::Round round) {
+OnDemandOrderingServiceImpl::CollectionType
+OnDemandOrderingServiceImpl::packNextProposals(const consensus::Round &round) {
+  CollectionType leftovers;
+  auto close_round = [this, &leftovers](consensus::Round round) {
     log_->debug("close {}", round);
 
     auto it = current_proposals_.find(round);
     if (it != current_proposals_.end()) {
       log_->debug("proposal found");
       if (not it->second.empty()) {
-        proposal_map_.emplace(round, emitProposal(round));
+        proposal_map_.emplace(round, emitProposal(round, it->second));
         log_->debug("packNextProposal: data has been fetched for {}", round);
         round_queue_.push(round);
       }
+      auto rest = it->second.release();
+      leftovers.insert(leftovers.end(),
+                       std::make_move_iterator(rest.begin()),
+                       std::make_move_iterator(rest.end()));
       current_proposals_.erase(it);
     }
   };
@@ -176,31 +191,44 @@ void OnDemandOrderingServiceImpl::packNextProposals(
   // new reject round
   open_round(
       {round.block_round, currentRejectRoundConsumer(round.reject_round)});
+
+  return leftovers;
+}
+
+void OnDemandOrderingServiceImpl::forwardLeftovers(
+    const consensus::Round &round, CollectionType leftovers) {
+  if (leftovers.empty()) {
+    return;
+  }
+  if (not leftovers_consumer_) {
+    log_->warn("forwardLeftovers: {} batches are dropped", leftovers.size());
+    return;
+  }
+  if (leftovers.size() > max_leftover_batches_) {
+    log_->warn("forwardLeftovers: {} batches over the limit are dropped",
+               leftovers.size() - max_leftover_batches_);
+    leftovers.resize(max_leftover_batches_);
+  }
+  log_->info(
+      "forwardLeftovers: {} batches are sent, {}", leftovers.size(), round);
+  leftovers_consumer_->onBatches(round, std::move(leftovers));
 }
 
 OnDemandOrderingServiceImpl::ProposalType
-OnDemandOrderingServiceImpl::emitProposal(const consensus::Round &round) {
+OnDemandOrderingServiceImpl::emitProposal(const consensus::Round &round,
+                                          PendingBatches &batches) {
   log_->debug("Mutable proposal generation, {}", round);
 
-  TransactionBatchType batch;
+  // batches were deduplicated on insertion, outer method should guarantee
+  // availability of at least one batch
   std::vector<std::shared_ptr<shared_model::interface::Transaction>> collection;
-  std::unordered_set<std::string> inserted;
-
-  // outer method should guarantee availability of at least one transaction in
-  // queue, also, code shouldn't fetch all transactions from queue. The rest
-  // will be lost.
-  auto &current_proposal = current_proposals_[round];
-  while (current_proposal.try_pop(batch)
-         and collection.size() < transaction_limit_
-         and inserted.insert(batch->reducedHash().hex()).second) {
-    collection.insert(
-        std::end(collection),
-        std::make_move_iterator(std::begin(batch->transactions())),
-        std::make_move_iterator(std::end(batch->transactions())));
+  collection.reserve(transaction_limit_);
+  for (const auto &batch : batches.take(transaction_limit_)) {
+    collection.insert(std::end(collection),
+                      std::begin(batch->transactions()),
+                      std::end(batch->transactions()));
   }
   log_->debug("Number of transactions in proposal = {}", collection.size());
-  log_->debug("Number of lost transactions = {}",
-              current_proposal.unsafe_size());
 
   auto txs = collection | boost::adaptors::indirected;
   return proposal_factory_->unsafeCreateProposal(
@@ -216,23 +244,42 @@ void OnDemandOrderingServiceImpl::tryErase() {
   }
 }
 
-bool OnDemandOrderingServiceImpl::batchAlreadyProcessed(
-    const shared_model::interface::TransactionBatch &batch) {
-  auto tx_statuses = tx_cache_->check(batch);
-  if (not tx_statuses) {
+std::vector<bool> OnDemandOrderingServiceImpl::batchesAlreadyProcessed(
+    const CollectionType &batches) {
+  // statuses of transactions of all batches are fetched at once
+  std::vector<shared_model::crypto::Hash> hashes;
+  for (const auto &batch : batches) {
+    log_->info("check batch {} for already processed transactions",
+               batch->reducedHash().hex());
+    for (const auto &tx : batch->transactions()) {
+      hashes.push_back(tx->hash());
+    }
+  }
+  auto tx_statuses = tx_cache_->check(hashes);
+  if (not tx_statuses or tx_statuses->size() != hashes.size()) {
     // TODO andrei 30.11.18 IR-51 Handle database error
-    log_->warn("Check tx presence database error. Batch: {}", batch);
-    return true;
+    log_->warn("Check tx presence database error. Batches: {}",
+               batches.size());
+    return std::vector<bool>(batches.size(), true);
+  }
+
+  std::vector<bool> result;
+  result.reserve(batches.size());
+  auto tx_status = tx_statuses->begin();
+  for (const auto &batch : batches) {
+    auto batch_end = tx_status + batch->transactions().size();
+    // if any transaction is commited or rejected, batch was already processed
+    // Note: any_of returns false for empty sequence
+    result.push_back(
+        std::any_of(tx_status, batch_end, [this](const auto &status) {
+          if (iroha::ametsuchi::isAlreadyProcessed(status)) {
+            log_->warn("Duplicate transaction: {}",
+                       iroha::ametsuchi::getHash(status).hex());
+            return true;
+          }
+          return false;
+        }));
+    tx_status = batch_end;
   }
-  // if any transaction is commited or rejected, batch was already processed
-  // Note: any_of returns false for empty sequence
-  return std::any_of(
-      tx_statuses->begin(), tx_statuses->end(), [this](const auto &tx_status) {
-        if (iroha::ametsuchi::isAlreadyProcessed(tx_status)) {
-          log_->warn("Duplicate transaction: {}",
-                     iroha::ametsuchi::getHash(tx_status).hex());
-          return true;
-        }
-        return false;
-      });
+  return result;
 }
@@ -12,10 +12,10 @@
 #include <shared_mutex>
 #include <unordered_map>
 
-#include <tbb/concurrent_queue.h>
 #include "interfaces/iroha_internal/unsafe_proposal_factory.hpp"
 #include "logger/logger.hpp"
 #include "ordering/impl/on_demand_common.hpp"
+#include "ordering/impl/on_demand_pending_batches.hpp"
 
 namespace iroha {
   namespace ametsuchi {
@@ -24,6 +24,9 @@ namespace iroha {
   namespace ordering {
     class OnDemandOrderingServiceImpl : public OnDemandOrderingService {
      public:
+      /// default maximal number of batches sent back to the network
+      static constexpr size_t kDefaultMaxLeftoverBatches = 1000;
+
       /**
        * Create on_demand ordering service with following options:
        * @param transaction_limit - number of maximum transactions in one
@@ -34,6 +37,11 @@ namespace iroha {
        * removed. Default value is 3
        * @param initial_round - first round of agreement.
        * Default value is {2, kFirstRejectRound} since genesis block height is 1
+       * @param leftovers_consumer - receives batches which did not fit into
+       * packed proposals, to pass them to the ordering services of the next
+       * rounds. The batches are dropped if it is not set
+       * @param max_leftover_batches - maximal number of batches passed to the
+       * consumer on a round, the rest of them are dropped
        * @param log to print progress
        */
       OnDemandOrderingServiceImpl(
@@ -43,6 +51,9 @@ namespace iroha {
           std::shared_ptr<ametsuchi::TxPresenceCache> tx_cache,
           size_t number_of_proposals = 3,
           const consensus::Round &initial_round = {2, kFirstRejectRound},
+          std::shared_ptr<transport::OdOsNotification> leftovers_consumer =
+              nullptr,
+          size_t max_leftover_batches = kDefaultMaxLeftoverBatches,
           logger::Logger log = logger::log("OnDemandOrderingServiceImpl"));
 
       // --------------------- | OnDemandOrderingService |_---------------------
@@ -60,8 +71,17 @@ namespace iroha {
       /**
        * Packs new proposals and creates new rounds
        * Note: method is not thread-safe
+       * @return batches which did not fit into packed proposals
+       */
+      CollectionType packNextProposals(const consensus::Round &round);
+
+      /**
+       * Pass batches which did not fit into proposals to the consumer. This
+       * peer is usually not the issuer of the rounds the batches can get
+       * into, so they are sent the same way as the batches from clients
        */
-      void packNextProposals(const consensus::Round &round);
+      void forwardLeftovers(const consensus::Round &round,
+                            CollectionType leftovers);
 
       /**
        * Removes last elements if it is required
@@ -71,16 +91,19 @@ namespace iroha {
       void tryErase();
 
       /**
-       * @return packed proposal from the given round queue
+       * @return packed proposal from the head of the given round queue
        * Note: method is not thread-safe
        */
-      ProposalType emitProposal(const consensus::Round &round);
+      ProposalType emitProposal(const consensus::Round &round,
+                                PendingBatches &batches);
 
       /**
-       * Check if batch was already processed by the peer
+       * Check which batches were already processed by the peer. Statuses of
+       * all transactions are fetched with a single cache request
+       * @return flag for each of the batches, true for processed ones or
+       * for all of them if the request has failed
        */
-      bool batchAlreadyProcessed(
-          const shared_model::interface::TransactionBatch &batch);
+      std::vector<bool> batchesAlreadyProcessed(const CollectionType &batches);
 
       /**
        * Max number of transaction in one proposal
@@ -109,10 +132,17 @@ namespace iroha {
        * Proposals for current rounds
        */
       std::unordered_map<consensus::Round,
-                         tbb::concurrent_queue<TransactionBatchType>,
+                         PendingBatches,
                          consensus::RoundTypeHasher>
           current_proposals_;
 
+      /**
+       * Receiver of batches which did not fit into proposals
+       */
+      std::shared_ptr<transport::OdOsNotification> leftovers_consumer_;
+
+      size_t max_leftover_batches_;
+
       /**
        * Read write mutex for public methods
        */
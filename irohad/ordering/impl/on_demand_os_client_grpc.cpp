@@ -5,6 +5,8 @@
 
 #include "ordering/impl/on_demand_os_client_grpc.hpp"
 
+#include <numeric>
+
 #include "backend/protobuf/proposal.hpp"
 #include "backend/protobuf/transaction.hpp"
 #include "interfaces/common_objects/peer.hpp"
@@ -35,6 +37,11 @@ void OnDemandOsClientGrpc::onBatches(consensus::Round round,
   proto::BatchesRequest request;
   request.mutable_round()->set_block_round(round.block_round);
   request.mutable_round()->set_reject_round(round.reject_round);
+  // coalesced requests carry many batches, transactions are placed at once
+  request.mutable_transactions()->Reserve(std::accumulate(
+      batches.begin(), batches.end(), 0, [](int count, const auto &batch) {
+        return count + static_cast<int>(batch->transactions().size());
+      }));
   for (auto &batch : batches) {
     for (auto &transaction : batch->transactions()) {
       *request.add_transactions() = std::move(
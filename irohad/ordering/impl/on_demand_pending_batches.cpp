@@ -0,0 +1,60 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ordering/impl/on_demand_pending_batches.hpp"
+
+#include "interfaces/iroha_internal/transaction_batch.hpp"
+
+using namespace iroha::ordering;
+
+bool PendingBatches::insert(BatchType batch) {
+  if (not hashes_.insert(batch->reducedHash()).second) {
+    return false;
+  }
+  batches_.push(std::move(batch));
+  return true;
+}
+
+PendingBatches::CollectionType PendingBatches::take(size_t transaction_limit) {
+  CollectionType result;
+  size_t transactions = 0;
+  while (auto batch = pop()) {
+    auto size = (*batch)->transactions().size();
+    if (not result.empty() and transactions + size > transaction_limit) {
+      head_ = std::move(batch);
+      break;
+    }
+    hashes_.unsafe_erase((*batch)->reducedHash());
+    transactions += size;
+    result.push_back(std::move(*batch));
+  }
+  return result;
+}
+
+PendingBatches::CollectionType PendingBatches::release() {
+  CollectionType result;
+  while (auto batch = pop()) {
+    result.push_back(std::move(*batch));
+  }
+  hashes_.clear();
+  return result;
+}
+
+bool PendingBatches::empty() const {
+  return not head_ and batches_.empty();
+}
+
+boost::optional<PendingBatches::BatchType> PendingBatches::pop() {
+  if (head_) {
+    auto batch = std::move(head_);
+    head_ = boost::none;
+    return batch;
+  }
+  BatchType batch;
+  if (batches_.try_pop(batch)) {
+    return batch;
+  }
+  return boost::none;
+}
@@ -0,0 +1,74 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_ON_DEMAND_PENDING_BATCHES_HPP
+#define IROHA_ON_DEMAND_PENDING_BATCHES_HPP
+
+#include <boost/optional.hpp>
+#include <tbb/concurrent_queue.h>
+#include <tbb/concurrent_unordered_set.h>
+#include "cryptography/hash.hpp"
+#include "ordering/on_demand_os_transport.hpp"
+
+namespace iroha {
+  namespace ordering {
+
+    /**
+     * Batches waiting to be packed into a proposal of a single round. Batches
+     * are deduplicated by their reduced hashes on insertion and are packed in
+     * insertion order. Insertions are lock-free and can be done concurrently,
+     * other methods must not be called concurrently with any method.
+     */
+    class PendingBatches {
+     public:
+      using BatchType = transport::OdOsNotification::TransactionBatchType;
+      using CollectionType = transport::OdOsNotification::CollectionType;
+
+      /**
+       * Queue the batch unless a batch with the same reduced hash is queued
+       * @return true if the batch was queued, false for a duplicate
+       */
+      bool insert(BatchType batch);
+
+      /**
+       * Take batches from the head of the queue while their transactions fit
+       * into the limit. The first batch which does not fit stays at the head,
+       * unless nothing was taken, so a batch larger than the limit is taken
+       * alone
+       * @param transaction_limit - maximal number of transactions in taken
+       * batches
+       * @return taken batches in insertion order
+       */
+      CollectionType take(size_t transaction_limit);
+
+      /**
+       * Take all queued batches
+       * @return taken batches in insertion order
+       */
+      CollectionType release();
+
+      /**
+       * @return true if no batches are queued
+       */
+      bool empty() const;
+
+     private:
+      /**
+       * @return batch from the head of the queue, if any
+       */
+      boost::optional<BatchType> pop();
+
+      /// batch which was taken from the queue but did not fit into a proposal
+      boost::optional<BatchType> head_;
+      tbb::concurrent_queue<BatchType> batches_;
+      tbb::concurrent_unordered_set<shared_model::crypto::Hash,
+                                    shared_model::crypto::Hash::Hasher>
+          hashes_;
+    };
+
+  }  // namespace ordering
+}  // namespace iroha
+
+#endif  // IROHA_ON_DEMAND_PENDING_BATCHES_HPP
@@ -6,9 +6,56 @@
 #include "simulator/impl/simulator.hpp"
 
 #include <boost/range/adaptor/transformed.hpp>
+#include "ametsuchi/temporary_wsv.hpp"
 #include "common/bind.hpp"
 #include "interfaces/iroha_internal/block.hpp"
 #include "interfaces/iroha_internal/proposal.hpp"
+#include "ordering/impl/on_demand_common.hpp"
+
+namespace {
+  /**
+   * Temporary wsv which stops applying transactions when the state is needed
+   * for a commit, so that the validation of a proposal is cut short
+   */
+  class CancellableTemporaryWsv : public iroha::ametsuchi::TemporaryWsv {
+   public:
+    CancellableTemporaryWsv(iroha::ametsuchi::TemporaryWsv &wsv,
+                            const std::atomic<bool> &cancelled)
+        : wsv_(wsv), cancelled_(cancelled) {}
+
+    iroha::expected::Result<void, iroha::validation::CommandError> apply(
+        const shared_model::interface::Transaction &transaction) override {
+      if (cancelled_) {
+        return iroha::expected::makeError(iroha::validation::CommandError{
+            "Speculation", 1, "speculative validation is cancelled", false});
+      }
+      return wsv_.apply(transaction);
+    }
+
+    std::unique_ptr<SavepointWrapper> createSavepoint(
+        const std::string &name) override {
+      return wsv_.createSavepoint(name);
+    }
+
+    std::unique_ptr<TemporaryWsv> fork(
+        const std::vector<
+            shared_model::interface::types::TransactionsCollectionType>
+            &batches) override {
+      if (cancelled_) {
+        return nullptr;
+      }
+      return wsv_.fork(batches);
+    }
+
+    void join(TemporaryWsv &fork) override {
+      wsv_.join(fork);
+    }
+
+   private:
+    iroha::ametsuchi::TemporaryWsv &wsv_;
+    const std::atomic<bool> &cancelled_;
+  };
+}  // namespace
 
 namespace iroha {
   namespace simulator {
@@ -22,12 +69,15 @@ namespace iroha {
             crypto_signer,
         std::unique_ptr<shared_model::interface::UnsafeBlockFactory>
             block_factory,
+        SpeculativeProposalSource speculative_proposals,
         logger::Logger log)
         : validator_(std::move(statefulValidator)),
           ametsuchi_factory_(std::move(factory)),
           block_query_factory_(block_query_factory),
           crypto_signer_(std::move(crypto_signer)),
           block_factory_(std::move(block_factory)),
+          speculative_proposals_(std::move(speculative_proposals)),
+          speculation_state_(std::make_shared<SpeculationState>()),
           log_(std::move(log)) {
       ordering_gate->onProposal().subscribe(
           proposal_subscription_, [this](const network::OrderingEvent &event) {
@@ -102,10 +152,62 @@ namespace iroha {
               &temporary_wsv_var)
               ->value);
 
-      std::shared_ptr<iroha::validation::VerifiedProposalAndErrors>
-          validated_proposal_and_errors =
-              validator_->validate(proposal, *storage);
-      ametsuchi_factory_->prepareBlock(std::move(storage));
+      if (not speculative_proposals_) {
+        std::shared_ptr<iroha::validation::VerifiedProposalAndErrors>
+            validated_proposal_and_errors =
+                validator_->validate(proposal, *storage);
+        ametsuchi_factory_->prepareBlock(std::move(storage));
+
+        notifier_.get_subscriber().on_next(
+            VerifiedProposalCreatorEvent{validated_proposal_and_errors, round});
+        return;
+      }
+
+      // state of the proposal is built in background while the block is
+      // voted for, when the proposal was validated speculatively
+      auto speculation = takeSpeculation(proposal, round);
+      auto validated_proposal_and_errors = speculation
+          ? *speculation
+          : std::shared_ptr<iroha::validation::VerifiedProposalAndErrors>(
+                validator_->validate(proposal, *storage));
+      log_->info("proposal of round {} is {}validated speculatively",
+                 round,
+                 speculation ? "" : "NOT ");
+
+      ametsuchi_factory_->prepareBlockAsync(
+          std::move(storage),
+          [state = speculation_state_,
+           validator = validator_,
+           speculative_proposals = speculative_proposals_,
+           log = log_,
+           round,
+           height = proposal.height(),
+           accepted = speculation
+               ? validated_proposal_and_errors->verified_proposal
+               : nullptr](ametsuchi::TemporaryWsv &wsv,
+                          const std::atomic<bool> &cancelled) {
+            if (accepted) {
+              for (const auto &tx : accepted->transactions()) {
+                auto result = wsv.apply(tx);
+                if (auto e = boost::get<
+                        expected::Error<validation::CommandError>>(&result)) {
+                  log->warn("could not apply speculatively validated {}: {}",
+                            tx.hash().hex(),
+                            e->error.name);
+                  return false;
+                }
+              }
+            }
+            speculate(state,
+                      *validator,
+                      speculative_proposals,
+                      log,
+                      round,
+                      height,
+                      wsv,
+                      cancelled);
+            return true;
+          });
 
       notifier_.get_subscriber().on_next(
           VerifiedProposalCreatorEvent{validated_proposal_and_errors, round});
@@ -138,6 +240,7 @@ namespace iroha {
                                             proposal->transactions(),
                                             rejected_hashes);
       crypto_signer_->sign(*block);
+      last_created_block_ = std::make_pair(round, block->hash());
       block_notifier_.get_subscriber().on_next(
           BlockCreatorEvent{RoundData{proposal, block}, round});
     }
@@ -146,5 +249,69 @@ namespace iroha {
       return block_notifier_.get_observable();
     }
 
+    void Simulator::speculate(
+        const std::shared_ptr<SpeculationState> &state,
+        validation::StatefulValidator &validator,
+        const SpeculativeProposalSource &speculative_proposals,
+        const logger::Logger &log,
+        const consensus::Round &round,
+        shared_model::interface::types::HeightType height,
+        ametsuchi::TemporaryWsv &wsv,
+        const std::atomic<bool> &cancelled) {
+      auto next_round = ordering::nextCommitRound(round);
+      auto next_proposal = speculative_proposals(next_round);
+      if (not next_proposal or not *next_proposal) {
+        log->debug("no proposal to validate speculatively for {}", next_round);
+        return;
+      }
+      const auto &next = **next_proposal;
+      if (next.height() != height + 1) {
+        log->warn("Speculative proposal height: {}, expected height: {}",
+                  next.height(),
+                  height + 1);
+        return;
+      }
+
+      if (cancelled) {
+        log->info("speculative validation for {} is skipped", next_round);
+        return;
+      }
+
+      // the state of the current block is prepared without the proposal
+      auto savepoint = wsv.createSavepoint("speculative_proposal");
+      CancellableTemporaryWsv cancellable_wsv(wsv, cancelled);
+      std::shared_ptr<validation::VerifiedProposalAndErrors> verified =
+          validator.validate(next, cancellable_wsv);
+      if (cancelled) {
+        log->info("speculative validation for {} is cancelled", next_round);
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->speculation =
+          Speculation{next_round, next.hash(), round, std::move(verified)};
+    }
+
+    boost::optional<std::shared_ptr<validation::VerifiedProposalAndErrors>>
+    Simulator::takeSpeculation(
+        const shared_model::interface::Proposal &proposal,
+        const consensus::Round &round) {
+      boost::optional<Speculation> speculation;
+      {
+        std::lock_guard<std::mutex> lock(speculation_state_->mutex);
+        speculation.swap(speculation_state_->speculation);
+      }
+      // speculation is valid only on top of the block it was made for, which
+      // is not the case after a reject or if another block was committed
+      if (not speculation or speculation->round != round
+          or speculation->proposal_hash != proposal.hash()
+          or not last_created_block_
+          or last_created_block_->first != speculation->parent_round
+          or last_created_block_->second != last_block->hash()) {
+        return boost::none;
+      }
+      return speculation->verified;
+    }
+
   }  // namespace simulator
 }  // namespace iroha
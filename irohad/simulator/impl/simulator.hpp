@@ -6,6 +6,10 @@
 #ifndef IROHA_SIMULATOR_HPP
 #define IROHA_SIMULATOR_HPP
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+
 #include <boost/optional.hpp>
 
 #include "ametsuchi/block_query_factory.hpp"
@@ -23,6 +27,21 @@ namespace iroha {
 
     class Simulator : public VerifiedProposalCreator, public BlockCreator {
      public:
+      /**
+       * Source of proposals for the next rounds, which must not wait for the
+       * proposal to arrive. Returns none if the proposal is not known yet
+       */
+      using SpeculativeProposalSource = std::function<
+          boost::optional<std::shared_ptr<shared_model::interface::Proposal>>(
+              const consensus::Round &)>;
+
+      /**
+       * @param speculative_proposals - if set, the proposal of the next
+       * commit round is validated in background on top of the state of the
+       * created block while the block is voted for. If the round is reached
+       * with the same proposal on top of the same block, the result is used
+       * instead of validating the proposal again
+       */
       Simulator(
           std::shared_ptr<network::OrderingGate> ordering_gate,
           std::shared_ptr<validation::StatefulValidator> statefulValidator,
@@ -32,6 +51,7 @@ namespace iroha {
               crypto_signer,
           std::unique_ptr<shared_model::interface::UnsafeBlockFactory>
               block_factory,
+          SpeculativeProposalSource speculative_proposals = {},
           logger::Logger log = logger::log("Simulator"));
 
       ~Simulator() override;
@@ -50,6 +70,53 @@ namespace iroha {
       rxcpp::observable<BlockCreatorEvent> onBlock() override;
 
      private:
+      /**
+       * Result of validation of a proposal made before its round started
+       */
+      struct Speculation {
+        consensus::Round round;
+        shared_model::interface::types::HashType proposal_hash;
+        /// round of the block the proposal was validated on top of
+        consensus::Round parent_round;
+        std::shared_ptr<validation::VerifiedProposalAndErrors> verified;
+      };
+
+      /**
+       * Speculation shared with the background preparation of the state,
+       * which may outlive the simulator
+       */
+      struct SpeculationState {
+        std::mutex mutex;
+        boost::optional<Speculation> speculation;
+      };
+
+      /**
+       * Validate the proposal of the next commit round of the given one in
+       * the state, which is rolled back afterwards, and store the result
+       * @param round - round of the block the state corresponds to
+       * @param height - height of the block the state corresponds to
+       * @param cancelled - set when the state is needed, then the validation
+       * is stopped and its result is discarded
+       */
+      static void speculate(
+          const std::shared_ptr<SpeculationState> &state,
+          validation::StatefulValidator &validator,
+          const SpeculativeProposalSource &speculative_proposals,
+          const logger::Logger &log,
+          const consensus::Round &round,
+          shared_model::interface::types::HeightType height,
+          ametsuchi::TemporaryWsv &wsv,
+          const std::atomic<bool> &cancelled);
+
+      /**
+       * Take the speculation which matches the proposal of the round, the
+       * rest of speculations are discarded
+       * @return verified proposal of the matched speculation
+       */
+      boost::optional<std::shared_ptr<validation::VerifiedProposalAndErrors>>
+      takeSpeculation(const shared_model::interface::Proposal &proposal,
+                      const consensus::Round &round);
+
       // internal
       rxcpp::subjects::subject<VerifiedProposalCreatorEvent> notifier_;
       rxcpp::subjects::subject<BlockCreatorEvent> block_notifier_;
@@ -64,10 +131,18 @@ namespace iroha {
       std::unique_ptr<shared_model::interface::UnsafeBlockFactory>
           block_factory_;
 
+      SpeculativeProposalSource speculative_proposals_;
+      std::shared_ptr<SpeculationState> speculation_state_;
+
       logger::Logger log_;
 
       // last block
       std::shared_ptr<shared_model::interface::Block> last_block;
+
+      /// round and hash of the last created block
+      boost::optional<std::pair<consensus::Round,
+                                shared_model::interface::types::HashType>>
+          last_created_block_;
     };
   }  // namespace simulator
 }  // namespace iroha
@@ -5,6 +5,8 @@
 
 #include "synchronizer/impl/synchronizer_impl.hpp"
 
+#include <algorithm>
+#include <deque>
 #include <utility>
 
 #include "ametsuchi/block_query_factory.hpp"
@@ -15,17 +17,24 @@
 namespace iroha {
   namespace synchronizer {
 
+    constexpr uint32_t SynchronizerImpl::kDefaultBlocksPerRange;
+    constexpr size_t SynchronizerImpl::kDefaultRangesInFlight;
+
     SynchronizerImpl::SynchronizerImpl(
         std::shared_ptr<network::ConsensusGate> consensus_gate,
         std::shared_ptr<validation::ChainValidator> validator,
         std::shared_ptr<ametsuchi::MutableFactory> mutable_factory,
         std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory,
         std::shared_ptr<network::BlockLoader> block_loader,
+        uint32_t blocks_per_range,
+        size_t ranges_in_flight,
         logger::Logger log)
         : validator_(std::move(validator)),
           mutable_factory_(std::move(mutable_factory)),
           block_query_factory_(std::move(block_query_factory)),
           block_loader_(std::move(block_loader)),
+          blocks_per_range_(std::max<uint32_t>(1, blocks_per_range)),
+          ranges_in_flight_(std::max<size_t>(1, ranges_in_flight)),
           log_(std::move(log)) {
       consensus_gate->onOutcome().subscribe(
           subscription_, [this](consensus::GateObject object) {
@@ -64,39 +73,93 @@ namespace iroha {
           });
     }
 
+    std::future<SynchronizerImpl::BlockRange> SynchronizerImpl::fetchRange(
+        shared_model::interface::types::HeightType first_height,
+        uint32_t count,
+        const shared_model::interface::types::PubkeyType &public_key) {
+      // blocks are validated statelessly by the loader while they are
+      // received, so ranges loaded at once have their signatures checked in
+      // parallel
+      return std::async(
+          std::launch::async, [this, first_height, count, public_key] {
+            BlockRange blocks;
+            block_loader_->retrieveBlocks(first_height - 1, public_key, count)
+                .as_blocking()
+                .subscribe(
+                    [&blocks](auto block) { blocks.push_back(block); });
+            return blocks;
+          });
+    }
+
     SynchronizationEvent SynchronizerImpl::downloadMissingBlocks(
         const consensus::VoteOther &msg,
         std::unique_ptr<ametsuchi::MutableStorage> storage,
         const shared_model::interface::types::HeightType height) {
       auto expected_height = msg.round.block_round;
+      auto top_height = height;
+      BlockRange applied_blocks;
+      size_t next_peer = 0;
 
       // while blocks are not loaded and not committed
       while (true) {
         // TODO andrei 17.10.18 IR-1763 Add delay strategy for loading blocks
-        for (const auto &public_key : msg.public_keys) {
-          auto network_chain =
-              block_loader_->retrieveBlocks(height, public_key);
+        std::deque<std::future<BlockRange>> ranges;
+        auto next_height = top_height + 1;
+        auto fetch_ranges = [&] {
+          while (ranges.size() < ranges_in_flight_
+                 and next_height <= expected_height) {
+            auto count = static_cast<uint32_t>(
+                std::min<shared_model::interface::types::HeightType>(
+                    blocks_per_range_, expected_height - next_height + 1));
+            const auto &public_key =
+                msg.public_keys[next_peer++ % msg.public_keys.size()];
+            ranges.push_back(fetchRange(next_height, count, public_key));
+            next_height += count;
+          }
+        };
 
-          std::vector<std::shared_ptr<shared_model::interface::Block>> blocks;
-          network_chain.as_blocking().subscribe(
-              [&blocks](auto block) { blocks.push_back(block); });
+        fetch_ranges();
+        while (not ranges.empty()) {
+          auto blocks = ranges.front().get();
+          ranges.pop_front();
           if (blocks.empty()) {
             log_->info("Downloaded an empty chain");
-            continue;
-          } else {
-            log_->info("Successfully downloaded {} blocks", blocks.size());
+            break;
           }
+          log_->info("Successfully downloaded {} blocks", blocks.size());
+
+          // blocks are applied one by one, so the storage keeps every block
+          // applied before a failure and loading resumes after it
+          auto applied = blocks.begin();
+          for (; applied != blocks.end(); ++applied) {
+            if ((*applied)->height() != top_height + 1
+                or not validator_->validateAndApply(
+                       rxcpp::observable<>::just(*applied), *storage)) {
+              break;
+            }
+            ++top_height;
+          }
+          applied_blocks.insert(applied_blocks.end(), blocks.begin(), applied);
 
-          auto chain =
-              rxcpp::observable<>::iterate(blocks, rxcpp::identity_immediate());
-
-          if (blocks.back()->height() >= expected_height
-              and validator_->validateAndApply(chain, *storage)) {
+          if (top_height >= expected_height) {
             mutable_factory_->commit(std::move(storage));
 
-            return {chain, SynchronizationOutcomeType::kCommit, msg.round};
+            return {rxcpp::observable<>::iterate(applied_blocks,
+                                                 rxcpp::identity_immediate()),
+                    SynchronizationOutcomeType::kCommit,
+                    msg.round};
+          }
+          if (applied != blocks.end()) {
+            log_->info("Failed to apply block {}, resuming from height {}",
+                       (*applied)->height(),
+                       top_height + 1);
+            break;
           }
+          fetch_ranges();
         }
+        // ranges which are still in flight start after a failed one, wait
+        // for them and request the blocks again from the next peers
+        ranges.clear();
       }
     }
 
@@ -155,6 +218,11 @@ namespace iroha {
         return;
       }
 
+      if (msg.public_keys.empty()) {
+        log_->error("No peers to download blocks from");
+        return;
+      }
+
       auto opt_storage = getStorage();
       if (opt_storage == boost::none) {
         return;
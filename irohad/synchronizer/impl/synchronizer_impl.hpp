@@ -8,6 +8,8 @@
 
 #include "synchronizer/synchronizer.hpp"
 
+#include <future>
+
 #include "ametsuchi/mutable_factory.hpp"
 #include "logger/logger.hpp"
 #include "network/block_loader.hpp"
@@ -24,12 +26,25 @@ namespace iroha {
 
     class SynchronizerImpl : public Synchronizer {
      public:
+      /// Default number of blocks requested from a peer at once
+      static constexpr uint32_t kDefaultBlocksPerRange = 100;
+      /// Default number of ranges which are downloaded concurrently
+      static constexpr size_t kDefaultRangesInFlight = 4;
+
+      /**
+       * @param blocks_per_range - number of blocks requested from a peer at
+       * once
+       * @param ranges_in_flight - number of ranges which are downloaded and
+       * validated concurrently, limits the number of buffered blocks
+       */
       SynchronizerImpl(
           std::shared_ptr<network::ConsensusGate> consensus_gate,
           std::shared_ptr<validation::ChainValidator> validator,
           std::shared_ptr<ametsuchi::MutableFactory> mutable_factory,
           std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory,
           std::shared_ptr<network::BlockLoader> block_loader,
+          uint32_t blocks_per_range = kDefaultBlocksPerRange,
+          size_t ranges_in_flight = kDefaultRangesInFlight,
           logger::Logger log = logger::log("Synchronizer"));
 
       ~SynchronizerImpl() override;
@@ -38,9 +53,15 @@ namespace iroha {
       rxcpp::observable<SynchronizationEvent> on_commit_chain() override;
 
      private:
+      using BlockRange =
+          std::vector<std::shared_ptr<shared_model::interface::Block>>;
+
       /**
        * Iterate through the peers which signed the commit_message, load and
-       * apply the missing blocks
+       * apply the missing blocks. Consecutive ranges of blocks are downloaded
+       * from different peers at once and applied in order of height. When a
+       * range cannot be downloaded or applied, loading is resumed from the
+       * last applied block
        * @param commit_message - the commit that triggered synchronization
        * @param storage - mutable storage to apply downloaded commits from other
        * peers
@@ -52,6 +73,18 @@ namespace iroha {
           std::unique_ptr<ametsuchi::MutableStorage> storage,
           const shared_model::interface::types::HeightType height);
 
+      /**
+       * Start downloading a range of blocks in a separate thread
+       * @param first_height - height of the first block of the range
+       * @param count - number of blocks in the range
+       * @param public_key - peer to download the range from
+       * @return blocks which were received, possibly less than requested
+       */
+      std::future<BlockRange> fetchRange(
+          shared_model::interface::types::HeightType first_height,
+          uint32_t count,
+          const shared_model::interface::types::PubkeyType &public_key);
+
       void processNext(const consensus::PairValid &msg);
       void processDifferent(const consensus::VoteOther &msg);
 
@@ -61,6 +94,8 @@ namespace iroha {
       std::shared_ptr<ametsuchi::MutableFactory> mutable_factory_;
       std::shared_ptr<ametsuchi::BlockQueryFactory> block_query_factory_;
       std::shared_ptr<network::BlockLoader> block_loader_;
+      const uint32_t blocks_per_range_;
+      const size_t ranges_in_flight_;
 
       // internal
       rxcpp::subjects::subject<SynchronizationEvent> notifier_;
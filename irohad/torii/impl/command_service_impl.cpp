@@ -41,6 +41,10 @@ namespace torii {
       }
       cache_->addItem(tx_hash, response);
     });
+    // subscribed after the cache, so that a status is cached before it is
+    // delivered to streams
+    status_dispatcher_ = std::make_shared<iroha::torii::StatusDispatcher>(
+        status_bus_->statuses());
   }
 
   void CommandServiceImpl::handleTransactionBatch(
@@ -108,14 +112,11 @@ namespace torii {
       log_->debug("tx is not received: {}", hash);
       return status_factory_->makeNotReceived(hash);
     }());
-    return status_bus_
-        ->statuses()
+    // only statuses with requested hash are delivered by the dispatcher
+    return status_dispatcher_
+        ->statuses(hash)
         // prepend initial status
         .start_with(initial_status)
-        // select statuses with requested hash
-        .filter([hash](auto response) {
-          return response->transactionHash() == hash;
-        })
         // successfully complete the observable if final status is received.
         // final status is included in the observable
         .template lift<ResponsePtrType>([](rxcpp::subscriber<ResponsePtrType>
@@ -13,6 +13,7 @@
 #include "cryptography/hash.hpp"
 #include "interfaces/iroha_internal/tx_status_factory.hpp"
 #include "logger/logger.hpp"
+#include "torii/impl/status_dispatcher.hpp"
 #include "torii/processor/transaction_processor.hpp"
 #include "torii/status_bus.hpp"
 
@@ -90,6 +91,7 @@ namespace torii {
     std::shared_ptr<iroha::torii::TransactionProcessor> tx_processor_;
     std::shared_ptr<iroha::ametsuchi::Storage> storage_;
     std::shared_ptr<iroha::torii::StatusBus> status_bus_;
+    std::shared_ptr<iroha::torii::StatusDispatcher> status_dispatcher_;
     std::shared_ptr<CacheType> cache_;
     std::shared_ptr<shared_model::interface::TxStatusFactory> status_factory_;
 
@@ -8,11 +8,14 @@
 #include "torii/impl/command_service_transport_grpc.hpp"
 
 #include <atomic>
+#include <deque>
 #include <iterator>
+#include <mutex>
 
 #include <boost/format.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/transformed.hpp>
+#include <tbb/parallel_for.h>
 #include "backend/protobuf/transaction_responses/proto_tx_response.hpp"
 #include "interfaces/iroha_internal/transaction_batch.hpp"
 #include "interfaces/iroha_internal/transaction_batch_factory.hpp"
@@ -91,9 +94,25 @@ namespace torii {
   shared_model::interface::types::SharedTxsCollectionType
   CommandServiceTransportGrpc::deserializeTransactions(
       const iroha::protocol::TxList *request) {
+    using BuildResult =
+        decltype(transaction_factory_->build(request->transactions(0)));
+    const size_t size = request->transactions_size();
+
+    // stateless validation of transactions is independent, so it is done on
+    // the shared tbb worker pool, which steals chunks from busy threads
+    std::vector<BuildResult> results(size);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, size),
+        [this, request, &results](const tbb::blocked_range<size_t> &range) {
+          for (auto i = range.begin(); i != range.end(); ++i) {
+            results[i] = transaction_factory_->build(request->transactions(i));
+          }
+        });
+
+    // results are collected in the request order, so batches are kept intact
     shared_model::interface::types::SharedTxsCollectionType tx_collection;
-    for (const auto &tx : request->transactions()) {
-      transaction_factory_->build(tx).match(
+    for (auto &result : results) {
+      result.match(
           [&tx_collection](
               iroha::expected::Value<
                   std::unique_ptr<shared_model::interface::Transaction>> &v) {
@@ -159,113 +178,249 @@ namespace torii {
     return grpc::Status::OK;
   }
 
-  namespace {
-    void handleEvents(rxcpp::composite_subscription &subscription,
-                      rxcpp::schedulers::run_loop &run_loop) {
-      while (subscription.is_subscribed() or not run_loop.empty()) {
-        run_loop.dispatch();
-      }
+  /**
+   * Single StatusStream call. The call owns itself while gRPC may deliver
+   * any of its tags. Statuses arrive from the status bus on arbitrary
+   * threads and are queued, only one write is posted at a time, so a slow
+   * client does not make the server buffer statuses in gRPC
+   */
+  class CommandServiceTransportGrpc::StatusStreamCall {
+   public:
+    /**
+     * Create a call and wait for a client on it
+     * @param transport - service which serves the call
+     * @param cq - completion queue of the server
+     */
+    static void request(CommandServiceTransportGrpc *transport,
+                        grpc::ServerCompletionQueue *cq) {
+      std::shared_ptr<StatusStreamCall> call(
+          new StatusStreamCall(transport, cq));
+      call->self_ = call;
+      call->context_.AsyncNotifyWhenDone(call->done_op_.tag());
+      transport->RequestStatusStream(&call->context_,
+                                     &call->request_,
+                                     &call->writer_,
+                                     cq,
+                                     cq,
+                                     call->request_op_.tag());
     }
-  }  // namespace
 
-  grpc::Status CommandServiceTransportGrpc::StatusStream(
-      grpc::ServerContext *context,
-      const iroha::protocol::TxStatusRequest *request,
-      grpc::ServerWriter<iroha::protocol::ToriiResponse> *response_writer) {
-    rxcpp::schedulers::run_loop rl;
-
-    auto current_thread =
-        rxcpp::synchronize_in_one_worker(rxcpp::schedulers::make_run_loop(rl));
-
-    rxcpp::composite_subscription subscription;
-
-    auto hash = shared_model::crypto::Hash::fromHexString(request->tx_hash());
-
-    auto client_id_format = boost::format("Peer: '%s', %s");
-    std::string client_id =
-        (client_id_format % context->peer() % hash.toString()).str();
-    bool last_tx_status_received = false;
-    auto status_bus = command_service_->getStatusStream(hash)
-                          .finally([&last_tx_status_received] {
-                            last_tx_status_received = true;
-                          })
-                          .publish()
-                          .ref_count();
-    auto consensus_gate_observable =
-        consensus_gate_objects_
-            // a dummy start_with lets us don't wait for the consensus event
-            // on further combine_latest
-            .start_with(ConsensusGateEvent{})
-            .publish()
-            .ref_count();
-
-    boost::optional<iroha::protocol::TxStatus> last_tx_status;
-    auto rounds_counter{0};
-    status_bus
-        // convert to transport objects
-        .map([&](auto response) {
-          log_->info("mapped {}, {}", *response, client_id);
-          return std::static_pointer_cast<
-                     shared_model::proto::TransactionResponse>(response)
-              ->getTransport();
-        })
-        .combine_latest(current_thread, consensus_gate_observable)
-        .map([](const auto &tuple) { return std::get<0>(tuple); })
-        // complete the observable if client is disconnected or too many
-        // rounds have passed without tx status change
-        .take_while([=,
-                     &rounds_counter,
-                     &last_tx_status,
-                     // last_tx_status_received has to be passed by reference to
-                     // prevent accessing its outdated state
-                     &last_tx_status_received](const auto &response) {
-          if (context->IsCancelled()) {
-            log_->debug("client unsubscribed, {}", client_id);
-            return false;
-          }
+   private:
+    using Operation = iroha::network::AsyncCallOperation<StatusStreamCall>;
+    using Response = iroha::protocol::ToriiResponse;
+
+    StatusStreamCall(CommandServiceTransportGrpc *transport,
+                     grpc::ServerCompletionQueue *cq)
+        : transport_(transport),
+          cq_(cq),
+          writer_(&context_),
+          request_op_(this, &StatusStreamCall::onRequest),
+          write_op_(this, &StatusStreamCall::onWrite),
+          finish_op_(this, &StatusStreamCall::onFinish),
+          done_op_(this, &StatusStreamCall::onDone) {}
 
-          // increment round counter when the same status arrived again.
-          auto status = response.tx_status();
-          auto status_is_same = last_tx_status and (status == *last_tx_status);
-          if (status_is_same) {
-            ++rounds_counter;
-            if (rounds_counter >= maximum_rounds_without_update_) {
-              // we stop the stream when round counter is greater than allowed.
-              return false;
+    void onRequest(bool ok) {
+      if (not ok) {
+        // the server is shutting down, done is not notified for the calls
+        // which have not started
+        auto self = std::move(self_);
+        return;
+      }
+      request(transport_, cq_);
+
+      auto hash =
+          shared_model::crypto::Hash::fromHexString(request_.tx_hash());
+      // the client may be gone already, so the call is kept alive until the
+      // subscriptions are made
+      std::shared_ptr<StatusStreamCall> self;
+      update([&] {
+        started_ = true;
+        client_id_ = (boost::format("Peer: '%s', %s") % context_.peer()
+                      % hash.toString())
+                         .str();
+        self = self_;
+      });
+      std::weak_ptr<StatusStreamCall> weak_this = self;
+
+      transport_->command_service_->getStatusStream(hash).subscribe(
+          statuses_subscription_,
+          [weak_this](const auto &response) {
+            if (auto call = weak_this.lock()) {
+              call->update([&] {
+                call->process(std::static_pointer_cast<
+                                  shared_model::proto::TransactionResponse>(
+                                  response)
+                                  ->getTransport());
+              });
             }
-            // omit the received status, but do not stop the stream
-            return true;
-          }
-          rounds_counter = 0;
-          last_tx_status = status;
+          },
+          [weak_this](std::exception_ptr ep) {
+            if (auto call = weak_this.lock()) {
+              call->update([&] {
+                call->transport_->log_->error(
+                    "something bad happened, client_id {}", call->client_id_);
+                call->stop();
+              });
+            }
+          },
+          [weak_this] {
+            if (auto call = weak_this.lock()) {
+              // no more statuses will arrive
+              call->update([&] { call->stop(); });
+            }
+          });
 
-          // write a new status to the stream
-          if (not response_writer->Write(response)) {
-            log_->error("write to stream has failed to client {}", client_id);
-            return false;
-          }
+      transport_->consensus_gate_objects_.subscribe(
+          rounds_subscription_, [weak_this](const auto &) {
+            if (auto call = weak_this.lock()) {
+              call->update([&] {
+                // the same status once more for the round counter
+                if (call->last_response_) {
+                  auto response = *call->last_response_;
+                  call->process(response);
+                }
+              });
+            }
+          });
+    }
 
-          log_->debug("status written, {}", client_id);
-          if (last_tx_status_received) {
-            // force stream to end because no more tx statuses will arrive.
-            // it is thread safe because of synchronization on current_thread
-            return false;
-          }
-          return true;
-        })
-        .subscribe(subscription,
-                   [](const auto &) {},
-                   [&](std::exception_ptr ep) {
-                     log_->error("something bad happened, client_id {}",
-                                 client_id);
-                   },
-                   [&] { log_->debug("stream done, {}", client_id); });
-
-    // run loop while subscription is active or there are pending events in
-    // the queue
-    handleEvents(subscription, rl);
-
-    log_->debug("status stream done, {}", client_id);
-    return grpc::Status::OK;
-  }  // namespace torii
+    void onWrite(bool ok) {
+      update([&] {
+        --pending_ops_;
+        if (not ok) {
+          transport_->log_->error("write to stream has failed to client {}",
+                                  client_id_);
+          queue_.clear();
+          stop();
+          return;
+        }
+        transport_->log_->debug("status written, {}", client_id_);
+        queue_.pop_front();
+        writeNext();
+      });
+    }
+
+    void onFinish(bool) {
+      update([&] {
+        --pending_ops_;
+        transport_->log_->debug("status stream done, {}", client_id_);
+      });
+    }
+
+    void onDone(bool) {
+      update([&] {
+        done_ = true;
+        if (context_.IsCancelled()) {
+          transport_->log_->debug("client unsubscribed, {}", client_id_);
+          queue_.clear();
+          stopped_ = true;
+        }
+      });
+    }
+
+    /**
+     * Apply the change to the state of the call under the lock. Releases
+     * subscriptions when the stream is stopped and the call itself when
+     * gRPC has nothing to deliver for it
+     */
+    template <typename F>
+    void update(F &&f) {
+      std::shared_ptr<StatusStreamCall> released;
+      bool stopped;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        f();
+        stopped = stopped_;
+        if (started_ and done_ and pending_ops_ == 0) {
+          released = std::move(self_);
+        }
+      }
+      if (stopped) {
+        statuses_subscription_.unsubscribe();
+        rounds_subscription_.unsubscribe();
+      }
+    }
+
+    /**
+     * Queue a status for writing. Repeating status is not written, it
+     * counts a round without update instead
+     */
+    void process(const Response &response) {
+      if (stopped_) {
+        return;
+      }
+      auto status = response.tx_status();
+      if (last_response_ and status == last_response_->tx_status()) {
+        if (++rounds_counter_
+            >= transport_->maximum_rounds_without_update_) {
+          // too many rounds have passed without tx status change
+          stop();
+        }
+        return;
+      }
+      rounds_counter_ = 0;
+      last_response_ = response;
+      queue_.push_back(response);
+      writeNext();
+    }
+
+    /**
+     * Stop accepting statuses, the stream is finished once the queued ones
+     * are written
+     */
+    void stop() {
+      stopped_ = true;
+      writeNext();
+    }
+
+    /**
+     * Post the next write, or finish the stopped stream if the queue is
+     * empty. Does nothing while another operation is in flight
+     */
+    void writeNext() {
+      if (pending_ops_ > 0 or finished_ or done_) {
+        return;
+      }
+      if (not queue_.empty()) {
+        ++pending_ops_;
+        writer_.Write(queue_.front(), write_op_.tag());
+      } else if (stopped_) {
+        ++pending_ops_;
+        finished_ = true;
+        writer_.Finish(grpc::Status::OK, finish_op_.tag());
+      }
+    }
+
+    CommandServiceTransportGrpc *transport_;
+    grpc::ServerCompletionQueue *cq_;
+
+    grpc::ServerContext context_;
+    iroha::protocol::TxStatusRequest request_;
+    grpc::ServerAsyncWriter<Response> writer_;
+
+    Operation request_op_;
+    Operation write_op_;
+    Operation finish_op_;
+    Operation done_op_;
+
+    std::mutex mutex_;
+    std::shared_ptr<StatusStreamCall> self_;
+    std::string client_id_;
+    std::deque<Response> queue_;
+    boost::optional<Response> last_response_;
+    int rounds_counter_ = 0;
+    int pending_ops_ = 0;
+    bool started_ = false;
+    bool stopped_ = false;
+    bool finished_ = false;
+    bool done_ = false;
+
+    rxcpp::composite_subscription statuses_subscription_;
+    rxcpp::composite_subscription rounds_subscription_;
+  };
+
+  void CommandServiceTransportGrpc::handleCalls(
+      grpc::ServerCompletionQueue *cq) {
+    StatusStreamCall::request(this, cq);
+  }
 }  // namespace torii
@@ -13,6 +13,7 @@
 #include "interfaces/common_objects/transaction_sequence_common.hpp"
 #include "interfaces/iroha_internal/abstract_transport_factory.hpp"
 #include "logger/logger.hpp"
+#include "network/impl/async_grpc_service.hpp"
 
 namespace iroha {
   namespace torii {
@@ -29,8 +30,15 @@ namespace shared_model {
 }  // namespace shared_model
 
 namespace torii {
+  /**
+   * Command service transport. Status streams are served asynchronously from
+   * a completion queue of the server, so a waiting client does not occupy a
+   * thread. Other methods are synchronous
+   */
   class CommandServiceTransportGrpc
-      : public iroha::protocol::CommandService_v1::Service {
+      : public iroha::protocol::CommandService_v1::WithAsyncMethod_StatusStream<
+            iroha::protocol::CommandService_v1::Service>,
+        public iroha::network::AsyncGrpcService {
    public:
     using TransportFactoryType =
         shared_model::interface::AbstractTransportFactory<
@@ -102,22 +110,20 @@ namespace torii {
                         iroha::protocol::ToriiResponse *response) override;
 
     /**
-     * StatusStream call via grpc
-     * @param context - call context
-     * @param request - TxStatusRequest object which identifies transaction
-     * uniquely
-     * @param response_writer - grpc::ServerWriter which can repeatedly send
-     * transaction statuses back to the client
-     * @return status
+     * Start serving StatusStream calls from the queue. Each stream writes
+     * statuses of the requested transaction as they appear, at most one
+     * write is in flight per stream and the rest are queued until it
+     * completes
+     * @param cq - completion queue of the server
      */
-    grpc::Status StatusStream(grpc::ServerContext *context,
-                              const iroha::protocol::TxStatusRequest *request,
-                              grpc::ServerWriter<iroha::protocol::ToriiResponse>
-                                  *response_writer) override;
+    void handleCalls(grpc::ServerCompletionQueue *cq) override;
 
    private:
+    class StatusStreamCall;
+
     /**
-     * Flat map transport transactions to shared model
+     * Flat map transport transactions to shared model. Transactions are
+     * validated in parallel, the result keeps their order in the request
      */
     shared_model::interface::types::SharedTxsCollectionType
     deserializeTransactions(const iroha::protocol::TxList *request);
@@ -0,0 +1,115 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "torii/impl/status_dispatcher.hpp"
+
+#include <vector>
+
+namespace iroha {
+  namespace torii {
+
+    constexpr uint64_t StatusDispatcher::kReportPeriod;
+
+    StatusDispatcher::StatusDispatcher(rxcpp::observable<Response> statuses,
+                                       logger::Logger log)
+        : next_id_(0),
+          active_streams_(0),
+          published_(0),
+          delivered_(0),
+          unobserved_(0),
+          log_(std::move(log)) {
+      subscription_ = statuses.subscribe(
+          [this](const Response &response) { this->dispatch(response); });
+    }
+
+    StatusDispatcher::~StatusDispatcher() {
+      subscription_.unsubscribe();
+    }
+
+    rxcpp::observable<StatusDispatcher::Response> StatusDispatcher::statuses(
+        const shared_model::crypto::Hash &hash) {
+      std::weak_ptr<StatusDispatcher> weak_this = shared_from_this();
+      return rxcpp::observable<>::create<Response>(
+          [weak_this, hash](rxcpp::subscriber<Response> subscriber) {
+            auto dispatcher = weak_this.lock();
+            if (not dispatcher) {
+              subscriber.on_completed();
+              return;
+            }
+            uint64_t id;
+            {
+              std::lock_guard<std::mutex> lock(dispatcher->mutex_);
+              id = dispatcher->next_id_++;
+              dispatcher->streams_[hash].emplace(id, subscriber);
+              ++dispatcher->active_streams_;
+            }
+            subscriber.add([weak_this, hash, id] {
+              if (auto dispatcher = weak_this.lock()) {
+                dispatcher->unsubscribe(hash, id);
+              }
+            });
+          });
+    }
+
+    StatusDispatcher::Metrics StatusDispatcher::metrics() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return Metrics{published_.load(),
+                     delivered_.load(),
+                     unobserved_.load(),
+                     streams_.size(),
+                     active_streams_};
+    }
+
+    void StatusDispatcher::dispatch(const Response &response) {
+      if (++published_ % kReportPeriod == 0) {
+        auto m = metrics();
+        log_->info(
+            "Dispatched {} statuses, {} deliveries, {} unobserved, "
+            "{} streams open for {} transactions",
+            m.published,
+            m.delivered,
+            m.unobserved,
+            m.active_streams,
+            m.active_hashes);
+      }
+
+      // subscribers are notified outside of the lock, since a final status
+      // completes the stream, which unsubscribes it from the dispatcher
+      std::vector<rxcpp::subscriber<Response>> targets;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(response->transactionHash());
+        if (it == streams_.end()) {
+          ++unobserved_;
+          return;
+        }
+        targets.reserve(it->second.size());
+        for (const auto &stream : it->second) {
+          targets.push_back(stream.second);
+        }
+      }
+      delivered_ += targets.size();
+      for (auto &target : targets) {
+        target.on_next(response);
+      }
+    }
+
+    void StatusDispatcher::unsubscribe(const shared_model::crypto::Hash &hash,
+                                       uint64_t id) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = streams_.find(hash);
+      if (it == streams_.end()) {
+        return;
+      }
+      if (it->second.erase(id) > 0) {
+        --active_streams_;
+      }
+      if (it->second.empty()) {
+        streams_.erase(it);
+      }
+    }
+
+  }  // namespace torii
+}  // namespace iroha
@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TORII_STATUS_DISPATCHER_HPP
+#define TORII_STATUS_DISPATCHER_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <rxcpp/rx.hpp>
+#include "cryptography/hash.hpp"
+#include "logger/logger.hpp"
+#include "torii/status_bus.hpp"
+
+namespace iroha {
+  namespace torii {
+
+    /**
+     * Routes statuses from the status bus to streams of particular
+     * transactions. Streams are indexed by transaction hash, so a status is
+     * handed only to the streams waiting for its transaction, instead of
+     * being filtered by every open stream.
+     */
+    class StatusDispatcher
+        : public std::enable_shared_from_this<StatusDispatcher> {
+     public:
+      using Response = StatusBus::Objects;
+
+      /**
+       * Counters of dispatch work since creation
+       */
+      struct Metrics {
+        /// statuses received from the bus
+        uint64_t published;
+        /// statuses handed to streams, i.e. total fan-out
+        uint64_t delivered;
+        /// statuses nobody was waiting for
+        uint64_t unobserved;
+        /// transactions with at least one open stream
+        size_t active_hashes;
+        /// open streams
+        size_t active_streams;
+      };
+
+      /// Number of published statuses between metrics reports in the log
+      static constexpr uint64_t kReportPeriod = 10000;
+
+      /**
+       * @param statuses - observable of all published statuses
+       * @param log to print progress
+       */
+      explicit StatusDispatcher(
+          rxcpp::observable<Response> statuses,
+          logger::Logger log = logger::log("StatusDispatcher"));
+
+      ~StatusDispatcher();
+
+      /**
+       * Stream of statuses of the transaction. The stream is registered on
+       * subscription and removed from the index on unsubscription.
+       * Dispatcher must be owned by a shared pointer
+       * @param hash - hash of the transaction
+       * @return observable over statuses published after the subscription
+       */
+      rxcpp::observable<Response> statuses(
+          const shared_model::crypto::Hash &hash);
+
+      /**
+       * @return current dispatch counters
+       */
+      Metrics metrics() const;
+
+     private:
+      using Streams = std::unordered_map<uint64_t, rxcpp::subscriber<Response>>;
+
+      /**
+       * Hand the status to the streams of its transaction
+       */
+      void dispatch(const Response &response);
+
+      /**
+       * Remove the stream from the index
+       */
+      void unsubscribe(const shared_model::crypto::Hash &hash, uint64_t id);
+
+      mutable std::mutex mutex_;
+      std::unordered_map<shared_model::crypto::Hash,
+                         Streams,
+                         shared_model::crypto::Hash::Hasher>
+          streams_;
+      uint64_t next_id_;
+      size_t active_streams_;
+
+      std::atomic<uint64_t> published_;
+      std::atomic<uint64_t> delivered_;
+      std::atomic<uint64_t> unobserved_;
+
+      rxcpp::composite_subscription subscription_;
+
+      logger::Logger log_;
+    };
+
+  }  // namespace torii
+}  // namespace iroha
+
+#endif  // TORII_STATUS_DISPATCHER_HPP
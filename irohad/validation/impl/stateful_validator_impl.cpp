@@ -5,8 +5,10 @@
 
 #include "validation/impl/stateful_validator_impl.hpp"
 
+#include <iterator>
 #include <string>
 
+#include <tbb/parallel_for.h>
 #include <boost/algorithm/cxx11/all_of.hpp>
 #include <boost/format.hpp>
 #include <boost/range/adaptor/filtered.hpp>
@@ -14,6 +16,7 @@
 #include <boost/range/adaptor/transformed.hpp>
 #include "common/result.hpp"
 #include "interfaces/iroha_internal/batch_meta.hpp"
+#include "validation/impl/transaction_scheduler.hpp"
 #include "validation/utils.hpp"
 
 namespace iroha {
@@ -40,9 +43,134 @@ namespace iroha {
           });
     };
 
+    /**
+     * Results of validation of a batch
+     */
+    struct BatchValidationResult {
+      std::vector<bool> validation_results;
+      validation::TransactionsErrors transactions_errors;
+    };
+
+    /**
+     * Validate transactions of the batch; transactions of an atomic batch are
+     * applied only if all of them are valid
+     * @param batch to be validated
+     * @param temporary_wsv to apply transactions on
+     * @return validation results of the transactions and errors
+     */
+    static BatchValidationResult validateBatch(
+        const shared_model::interface::types::TransactionsCollectionType
+            &batch,
+        ametsuchi::TemporaryWsv &temporary_wsv) {
+      BatchValidationResult result;
+      auto &transactions_errors_log = result.transactions_errors;
+      auto validation = [&](auto &tx) {
+        return checkTransactions(temporary_wsv, transactions_errors_log, tx);
+      };
+      if (batch.front().batchMeta()
+          and batch.front().batchMeta()->get()->type()
+              == shared_model::interface::types::BatchType::ATOMIC) {
+        // check all batch's transactions for validness
+        auto savepoint = temporary_wsv.createSavepoint(
+            "batch_" + batch.front().hash().hex());
+        bool validation_result = false;
+
+        if (boost::algorithm::all_of(batch, validation)) {
+          // batch is successful; release savepoint
+          validation_result = true;
+          savepoint->release();
+        } else {
+          auto failed_tx_hash = transactions_errors_log.back().tx_hash;
+          for (const auto &tx : batch) {
+            if (tx.hash() != failed_tx_hash) {
+              transactions_errors_log.emplace_back(validation::TransactionError{
+                  tx.hash(),
+                  // TODO igor-egorov 22.01.2019 IR-245 add a separate
+                  // error code for failed batch case
+                  validation::CommandError{
+                      "",
+                      1,  // internal error code
+                      "Another transaction failed the batch",
+                      true,
+                      std::numeric_limits<size_t>::max()}});
+            }
+          }
+        }
+
+        result.validation_results.assign(boost::size(batch), validation_result);
+      } else {
+        for (const auto &tx : batch) {
+          result.validation_results.push_back(validation(tx));
+        }
+      }
+      return result;
+    }
+
+    /**
+     * Validate batches which do not touch the same state concurrently, each
+     * group on a fork of the temporary wsv. Groups which can not be forked
+     * are validated on the temporary wsv after the forks are joined, which
+     * gives the same results, since groups are independent
+     * @param batches of the proposal
+     * @param indices of the batches to be validated
+     * @param sets - read and write sets of the batches to be validated
+     * @param temporary_wsv to apply transactions on
+     * @param results to write validation results of the batches to
+     * @param log to write the number of groups to
+     */
+    static void validateConcurrently(
+        const std::vector<
+            shared_model::interface::types::TransactionsCollectionType>
+            &batches,
+        const std::vector<size_t> &indices,
+        const std::vector<ReadWriteSet> &sets,
+        ametsuchi::TemporaryWsv &temporary_wsv,
+        std::vector<BatchValidationResult> &results,
+        const logger::Logger &log) {
+      auto groups = conflictFreeGroups(sets);
+      log->debug("{} batches form {} independent groups",
+                 indices.size(),
+                 groups.size());
+
+      std::vector<std::unique_ptr<ametsuchi::TemporaryWsv>> forks;
+      if (groups.size() > 1) {
+        for (const auto &group : groups) {
+          std::vector<
+              shared_model::interface::types::TransactionsCollectionType>
+              group_batches;
+          for (auto i : group) {
+            group_batches.push_back(batches[indices[i]]);
+          }
+          forks.push_back(temporary_wsv.fork(group_batches));
+        }
+      }
+      forks.resize(groups.size());
+
+      tbb::parallel_for(size_t{0}, groups.size(), [&](size_t group) {
+        if (forks[group]) {
+          for (auto i : groups[group]) {
+            results[indices[i]] =
+                validateBatch(batches[indices[i]], *forks[group]);
+          }
+        }
+      });
+
+      for (size_t group = 0; group < groups.size(); ++group) {
+        if (forks[group]) {
+          temporary_wsv.join(*forks[group]);
+        } else {
+          for (auto i : groups[group]) {
+            results[indices[i]] =
+                validateBatch(batches[indices[i]], temporary_wsv);
+          }
+        }
+      }
+    }
+
     /**
      * Validate all transactions supplied; includes special rules, such as batch
-     * validation etc
+     * validation etc. Consecutive batches of commands with known read and
+     * write sets are validated concurrently, the others one by one
      * @param txs to be validated
      * @param temporary_wsv to apply transactions on
      * @param transactions_errors_log to write errors to
@@ -56,52 +184,40 @@ namespace iroha {
         validation::TransactionsErrors &transactions_errors_log,
         const logger::Logger &log,
         const shared_model::interface::TransactionBatchParser &batch_parser) {
-      std::vector<bool> validation_results;
-      validation_results.reserve(boost::size(txs));
-
-      for (auto batch : batch_parser.parseBatches(txs)) {
-        auto validation = [&](auto &tx) {
-          return checkTransactions(temporary_wsv, transactions_errors_log, tx);
-        };
-        if (batch.front().batchMeta()
-            and batch.front().batchMeta()->get()->type()
-                == shared_model::interface::types::BatchType::ATOMIC) {
-          // check all batch's transactions for validness
-          auto savepoint = temporary_wsv.createSavepoint(
-              "batch_" + batch.front().hash().hex());
-          bool validation_result = false;
-
-          if (boost::algorithm::all_of(batch, validation)) {
-            // batch is successful; release savepoint
-            validation_result = true;
-            savepoint->release();
-          } else {
-            auto failed_tx_hash = transactions_errors_log.back().tx_hash;
-            for (const auto &tx : batch) {
-              if (tx.hash() != failed_tx_hash) {
-                transactions_errors_log.emplace_back(
-                    validation::TransactionError{
-                        tx.hash(),
-                        // TODO igor-egorov 22.01.2019 IR-245 add a separate
-                        // error code for failed batch case
-                        validation::CommandError{
-                            "",
-                            1,  // internal error code
-                            "Another transaction failed the batch",
-                            true,
-                            std::numeric_limits<size_t>::max()}});
-              }
-            }
-          }
+      auto batches = batch_parser.parseBatches(txs);
+      std::vector<BatchValidationResult> results(batches.size());
 
-          validation_results.insert(
-              validation_results.end(), boost::size(batch), validation_result);
+      std::vector<size_t> scheduled;
+      std::vector<ReadWriteSet> sets;
+      auto validate_scheduled = [&] {
+        if (not scheduled.empty()) {
+          validateConcurrently(
+              batches, scheduled, sets, temporary_wsv, results, log);
+          scheduled.clear();
+          sets.clear();
+        }
+      };
+      for (size_t i = 0; i < batches.size(); ++i) {
+        if (auto set = readWriteSet(batches[i])) {
+          scheduled.push_back(i);
+          sets.push_back(std::move(*set));
         } else {
-          for (const auto &tx : batch) {
-            validation_results.push_back(validation(tx));
-          }
+          validate_scheduled();
+          results[i] = validateBatch(batches[i], temporary_wsv);
         }
       }
+      validate_scheduled();
+
+      std::vector<bool> validation_results;
+      validation_results.reserve(boost::size(txs));
+      for (auto &result : results) {
+        validation_results.insert(validation_results.end(),
+                                  result.validation_results.begin(),
+                                  result.validation_results.end());
+        std::move(result.transactions_errors.begin(),
+                  result.transactions_errors.end(),
+                  std::back_inserter(transactions_errors_log));
+      }
 
       return txs | boost::adaptors::indexed()
           | boost::adaptors::filtered(
@@ -0,0 +1,162 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "validation/impl/transaction_scheduler.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+#include "common/visitor.hpp"
+#include "interfaces/commands/add_asset_quantity.hpp"
+#include "interfaces/commands/command_variant.hpp"
+#include "interfaces/commands/subtract_asset_quantity.hpp"
+#include "interfaces/commands/transfer_asset.hpp"
+#include "interfaces/transaction.hpp"
+
+namespace {
+  std::string accountKey(const std::string &account_id) {
+    return "account/" + account_id;
+  }
+
+  std::string permissionsKey(const std::string &account_id) {
+    return "permissions/" + account_id;
+  }
+
+  std::string signatoriesKey(const std::string &account_id) {
+    return "signatories/" + account_id;
+  }
+
+  std::string grantKey(const std::string &permittee_account_id,
+                       const std::string &account_id) {
+    return "grant/" + permittee_account_id + "/" + account_id;
+  }
+
+  std::string assetKey(const std::string &asset_id) {
+    return "asset/" + asset_id;
+  }
+
+  std::string balanceKey(const std::string &account_id,
+                         const std::string &asset_id) {
+    return "balance/" + account_id + "/" + asset_id;
+  }
+
+  /**
+   * Add parts of the state used by the command to the set
+   * @return false if they are not known
+   */
+  bool addCommand(const shared_model::interface::Command &command,
+                  const std::string &creator,
+                  iroha::validation::ReadWriteSet &set) {
+    auto asset_quantity = [&](const auto &command) {
+      set.reads.insert(accountKey(creator));
+      set.reads.insert(assetKey(command.assetId()));
+      set.writes.insert(balanceKey(creator, command.assetId()));
+      return true;
+    };
+    return iroha::visit_in_place(
+        command.get(),
+        [&](const shared_model::interface::AddAssetQuantity &add) {
+          return asset_quantity(add);
+        },
+        [&](const shared_model::interface::SubtractAssetQuantity &subtract) {
+          return asset_quantity(subtract);
+        },
+        [&](const shared_model::interface::TransferAsset &transfer) {
+          set.reads.insert(accountKey(transfer.srcAccountId()));
+          set.reads.insert(accountKey(transfer.destAccountId()));
+          set.reads.insert(permissionsKey(transfer.destAccountId()));
+          set.reads.insert(grantKey(creator, transfer.srcAccountId()));
+          set.reads.insert(assetKey(transfer.assetId()));
+          set.writes.insert(
+              balanceKey(transfer.srcAccountId(), transfer.assetId()));
+          set.writes.insert(
+              balanceKey(transfer.destAccountId(), transfer.assetId()));
+          return true;
+        },
+        [](const auto &) { return false; });
+  }
+}  // namespace
+
+namespace iroha {
+  namespace validation {
+
+    boost::optional<ReadWriteSet> readWriteSet(
+        const shared_model::interface::types::TransactionsCollectionType
+            &transactions) {
+      ReadWriteSet set;
+      for (const auto &transaction : transactions) {
+        const auto &creator = transaction.creatorAccountId();
+        set.reads.insert(signatoriesKey(creator));
+        set.reads.insert(permissionsKey(creator));
+        for (const auto &command : transaction.commands()) {
+          if (not addCommand(command, creator, set)) {
+            return boost::none;
+          }
+        }
+      }
+      return set;
+    }
+
+    std::vector<std::vector<size_t>> conflictFreeGroups(
+        const std::vector<ReadWriteSet> &sets) {
+      // disjoint-set forest, the root of a tree is its smallest index
+      std::vector<size_t> parents(sets.size());
+      std::iota(parents.begin(), parents.end(), 0);
+      auto find = [&parents](size_t i) {
+        while (parents[i] != i) {
+          parents[i] = parents[parents[i]];
+          i = parents[i];
+        }
+        return i;
+      };
+      auto unite = [&](size_t a, size_t b) {
+        a = find(a);
+        b = find(b);
+        parents[std::max(a, b)] = std::min(a, b);
+      };
+
+      struct Accesses {
+        boost::optional<size_t> writer;
+        // readers since the last write, not united with the writer
+        std::vector<size_t> readers;
+      };
+      std::unordered_map<std::string, Accesses> accesses;
+      for (size_t i = 0; i < sets.size(); ++i) {
+        for (const auto &key : sets[i].writes) {
+          auto &access = accesses[key];
+          if (access.writer) {
+            unite(i, *access.writer);
+          }
+          for (auto reader : access.readers) {
+            unite(i, reader);
+          }
+          access.readers.clear();
+          access.writer = i;
+        }
+        for (const auto &key : sets[i].reads) {
+          auto &access = accesses[key];
+          if (access.writer) {
+            unite(i, *access.writer);
+          } else {
+            access.readers.push_back(i);
+          }
+        }
+      }
+
+      std::vector<std::vector<size_t>> groups;
+      std::unordered_map<size_t, size_t> group_indices;
+      for (size_t i = 0; i < sets.size(); ++i) {
+        auto inserted = group_indices.emplace(find(i), groups.size());
+        if (inserted.second) {
+          groups.emplace_back();
+        }
+        groups[inserted.first->second].push_back(i);
+      }
+      return groups;
+    }
+
+  }  // namespace validation
+}  // namespace iroha
@@ -0,0 +1,53 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_TRANSACTION_SCHEDULER_HPP
+#define IROHA_TRANSACTION_SCHEDULER_HPP
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include "interfaces/common_objects/range_types.hpp"
+
+namespace iroha {
+  namespace validation {
+
+    /**
+     * Parts of the world state read and written by transactions
+     */
+    struct ReadWriteSet {
+      std::unordered_set<std::string> reads;
+      std::unordered_set<std::string> writes;
+    };
+
+    /**
+     * Compute parts of the world state used by commands of the transactions
+     * and by validation of their signatures
+     * @param transactions to be inspected
+     * @return read and write sets of all transactions, none if any of them has
+     * a command which is not limited to known accounts and assets, like
+     * creation of an account or a change of permissions
+     */
+    boost::optional<ReadWriteSet> readWriteSet(
+        const shared_model::interface::types::TransactionsCollectionType
+            &transactions);
+
+    /**
+     * Partition read and write sets into groups, so that no set of a group
+     * writes a part of the state used by a set of another group. Groups
+     * applied in any order give the same state as the sets applied in order
+     * @param sets to be partitioned
+     * @return indices of sets of every group in ascending order, groups are
+     * ordered by their first set
+     */
+    std::vector<std::vector<size_t>> conflictFreeGroups(
+        const std::vector<ReadWriteSet> &sets);
+
+  }  // namespace validation
+}  // namespace iroha
+
+#endif  // IROHA_TRANSACTION_SCHEDULER_HPP
@@ -6,76 +6,201 @@
 #ifndef IROHA_CACHE_HPP
 #define IROHA_CACHE_HPP
 
-#include "cache/abstract_cache.hpp"
-
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
 
 namespace iroha {
   namespace cache {
 
     /**
-     * Cache for arbitrary types
+     * Weigher which makes capacity of the cache a number of items
+     */
+    struct CountWeigher {
+      template <typename KeyType, typename ValueType>
+      size_t operator()(const KeyType &, const ValueType &) const {
+        return 1;
+      }
+    };
+
+    /**
+     * Thread-safe LRU cache for arbitrary types. Keys are spread over
+     * independently locked shards, each of them keeps its items in the order
+     * of use and evicts the least recently used ones one by one when its
+     * part of the capacity is exceeded.
      * @tparam KeyType type of key objects
      * @tparam ValueType type of value objects
      * @tparam KeyHash hasher for keys
+     * @tparam Weigher weight of an item in units of capacity, e.g. bytes
      */
     template <typename KeyType,
               typename ValueType,
-              typename KeyHash = std::hash<KeyType>>
-    class Cache : public AbstractCache<KeyType,
-                                       ValueType,
-                                       Cache<KeyType, ValueType, KeyHash>> {
+              typename KeyHash = std::hash<KeyType>,
+              typename Weigher = CountWeigher>
+    class Cache {
      public:
-      Cache(uint32_t max_handler_map_size_high = 20000,
-            uint32_t max_handler_map_size_low = 10000)
-          : max_handler_map_size_high_(max_handler_map_size_high),
-            max_handler_map_size_low_(max_handler_map_size_low) {}
+      /// Default total weight of items
+      static constexpr size_t kDefaultCapacity = 20000;
+      /// Default number of independently locked shards
+      static constexpr size_t kDefaultShards = 16;
 
-      uint32_t getIndexSizeHighImpl() const {
-        return max_handler_map_size_high_;
-      }
+      /**
+       * Counters of cache use since creation
+       */
+      struct Metrics {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t insertions;
+        uint64_t evictions;
+      };
 
-      uint32_t getIndexSizeLowImpl() const {
-        return max_handler_map_size_low_;
+      /**
+       * @param capacity - maximal total weight of items, divided evenly
+       * between shards
+       * @param shards - number of shards, decreased to the capacity if it is
+       * greater
+       */
+      explicit Cache(size_t capacity = kDefaultCapacity,
+                     size_t shards = kDefaultShards)
+          : shards_(std::max<size_t>(1, std::min(shards, capacity))),
+            shard_capacity_((capacity + shards_.size() - 1) / shards_.size()),
+            hits_(0),
+            misses_(0),
+            insertions_(0),
+            evictions_(0) {}
+
+      /**
+       * @return maximal total weight of items
+       */
+      size_t getCapacity() const {
+        return shard_capacity_ * shards_.size();
       }
 
-      uint32_t getCacheItemCountImpl() const {
-        return (uint32_t)handler_map_.size();
+      /**
+       * @return amount of items in cache
+       */
+      size_t getCacheItemCount() const {
+        size_t count = 0;
+        for (auto &shard : shards_) {
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          count += shard.items.size();
+        }
+        return count;
       }
 
-      void addItemImpl(const KeyType &key, const ValueType &value) {
-        // elements with the same hash should be replaced
-        handler_map_[key] = value;
-        handler_map_index_.push_back(key);
-        if (handler_map_.size() > getIndexSizeHighImpl()) {
-          while (handler_map_.size() > getIndexSizeLowImpl()) {
-            handler_map_.erase(handler_map_index_.front());
-            handler_map_index_.pop_front();
-          }
+      /**
+       * Adds new item to cache or replaces the value of an existing one. The
+       * item becomes the most recently used in its shard. Least recently used
+       * items of the shard are evicted until it fits the capacity, the added
+       * item itself is never evicted.
+       * @param key - key to insert
+       * @param value - value to insert
+       */
+      void addItem(const KeyType &key, const ValueType &value) {
+        auto &shard = shardOf(key);
+        auto weight = Weigher{}(key, value);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+          shard.weight -= found->second->weight;
+          found->second->value = value;
+          found->second->weight = weight;
+          shard.items.splice(
+              shard.items.begin(), shard.items, found->second);
+        } else {
+          shard.items.push_front(Item{key, value, weight});
+          shard.index.emplace(key, shard.items.begin());
+        }
+        shard.weight += weight;
+        ++insertions_;
+
+        while (shard.weight > shard_capacity_ and shard.items.size() > 1) {
+          const auto &last = shard.items.back();
+          shard.weight -= last.weight;
+          shard.index.erase(last.key);
+          shard.items.pop_back();
+          ++evictions_;
         }
       }
 
-      boost::optional<ValueType> findItemImpl(const KeyType &key) const {
-        auto found = handler_map_.find(key);
-        if (found == handler_map_.end()) {
+      /**
+       * Performs a search for an item with a specific key. Found item
+       * becomes the most recently used in its shard.
+       * @param key - key to find
+       * @return Optional of ValueType
+       */
+      boost::optional<ValueType> findItem(const KeyType &key) const {
+        auto &shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) {
+          ++misses_;
           return boost::none;
-        } else {
-          return handler_map_.at(key);
         }
+        ++hits_;
+        shard.items.splice(shard.items.begin(), shard.items, found->second);
+        return found->second->value;
+      }
+
+      /**
+       * @return current counters of cache use
+       */
+      Metrics getMetrics() const {
+        return Metrics{
+            hits_.load(), misses_.load(), insertions_.load(), evictions_.load()};
       }
 
      private:
-      std::unordered_map<KeyType, ValueType, KeyHash> handler_map_;
-      std::list<KeyType> handler_map_index_;
+      struct Item {
+        KeyType key;
+        ValueType value;
+        size_t weight;
+      };
+
+      using Items = std::list<Item>;
 
       /**
-       * Protection from handler map overflow.
-       * TODO 27/10/2017 luckychess Values are quite random and should be tuned
-       * for better performance and may be even move to config IR-579
+       * Part of the cache under its own lock. Items are ordered from the most
+       * to the least recently used, index points to them by key
        */
-      const uint32_t max_handler_map_size_high_;
-      const uint32_t max_handler_map_size_low_;
+      struct Shard {
+        std::mutex mutex;
+        Items items;
+        std::unordered_map<KeyType, typename Items::iterator, KeyHash> index;
+        size_t weight = 0;
+      };
+
+      Shard &shardOf(const KeyType &key) const {
+        return shards_[KeyHash{}(key) % shards_.size()];
+      }
+
+      mutable std::vector<Shard> shards_;
+      const size_t shard_capacity_;
+
+      mutable std::atomic<uint64_t> hits_;
+      mutable std::atomic<uint64_t> misses_;
+      std::atomic<uint64_t> insertions_;
+      std::atomic<uint64_t> evictions_;
     };
+
+    template <typename KeyType,
+              typename ValueType,
+              typename KeyHash,
+              typename Weigher>
+    constexpr size_t Cache<KeyType, ValueType, KeyHash, Weigher>::
+        kDefaultCapacity;
+
+    template <typename KeyType,
+              typename ValueType,
+              typename KeyHash,
+              typename Weigher>
+    constexpr size_t
+        Cache<KeyType, ValueType, KeyHash, Weigher>::kDefaultShards;
   }  // namespace cache
 }  // namespace iroha
 
@@ -0,0 +1,114 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backend/protobuf/proto_block_binary_converter.hpp"
+
+#include <algorithm>
+
+#include <boost/crc.hpp>
+
+#include "backend/protobuf/block.hpp"
+
+using namespace shared_model;
+using namespace shared_model::proto;
+
+namespace {
+  uint32_t checksum(const void *data, size_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+  }
+
+  void appendUint32(std::string &out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+  }
+
+  uint32_t readUint32(const char *in) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      value = (value << 8) | static_cast<uint8_t>(in[i]);
+    }
+    return value;
+  }
+}  // namespace
+
+const std::string ProtoBlockBinaryConverter::kMagic = "IRBK";
+constexpr uint8_t ProtoBlockBinaryConverter::kVersion;
+constexpr size_t ProtoBlockBinaryConverter::kHeaderSize;
+
+bool ProtoBlockBinaryConverter::isBinary(const std::string &record) {
+  return isBinary(record.data(), record.size());
+}
+
+bool ProtoBlockBinaryConverter::isBinary(const char *data, size_t size) {
+  return size >= kMagic.size()
+      and std::equal(kMagic.begin(), kMagic.end(), data);
+}
+
+iroha::expected::Result<interface::types::JsonType, std::string>
+ProtoBlockBinaryConverter::serialize(const interface::Block &block) const
+    noexcept {
+  // the blob of the block is not updated by addSignature, so the transport
+  // is serialized to keep signatures added after the block was built
+  const auto payload =
+      static_cast<const Block &>(block).getTransport().SerializeAsString();
+
+  std::string result;
+  result.reserve(kHeaderSize + payload.size());
+  result.append(kMagic);
+  result.push_back(static_cast<char>(kVersion));
+  appendUint32(result, payload.size());
+  appendUint32(result, checksum(payload.data(), payload.size()));
+  result.append(payload.begin(), payload.end());
+  return iroha::expected::makeValue(std::move(result));
+}
+
+iroha::expected::Result<std::unique_ptr<interface::Block>, std::string>
+ProtoBlockBinaryConverter::deserialize(
+    const interface::types::JsonType &record) const noexcept {
+  if (not isBinary(record)) {
+    return json_converter_.deserialize(record);
+  }
+  return deserializeFromArray(record.data(), record.size());
+}
+
+iroha::expected::Result<std::unique_ptr<interface::Block>, std::string>
+ProtoBlockBinaryConverter::deserializeFromArray(const char *data,
+                                                size_t size) const noexcept {
+  if (not isBinary(data, size)) {
+    return json_converter_.deserialize(interface::types::JsonType(data, size));
+  }
+  if (size < kHeaderSize) {
+    return iroha::expected::makeError("Truncated block record header");
+  }
+
+  auto version = static_cast<uint8_t>(data[kMagic.size()]);
+  if (version != kVersion) {
+    return iroha::expected::makeError("Unsupported block record version "
+                                      + std::to_string(version));
+  }
+
+  auto payload_size = readUint32(data + kMagic.size() + 1);
+  if (size - kHeaderSize != payload_size) {
+    return iroha::expected::makeError(
+        "Block record size mismatch: expected " + std::to_string(payload_size)
+        + " bytes, got " + std::to_string(size - kHeaderSize));
+  }
+
+  const auto *payload = data + kHeaderSize;
+  if (checksum(payload, payload_size) != readUint32(data + kMagic.size() + 5)) {
+    return iroha::expected::makeError("Block record checksum mismatch");
+  }
+
+  iroha::protocol::Block_v1 block;
+  if (not block.ParseFromArray(payload, payload_size)) {
+    return iroha::expected::makeError("Failed to parse block record payload");
+  }
+  std::unique_ptr<interface::Block> result =
+      std::make_unique<Block>(std::move(block));
+  return iroha::expected::makeValue(std::move(result));
+}
@@ -0,0 +1,71 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_PROTO_BLOCK_BINARY_CONVERTER_HPP
+#define IROHA_PROTO_BLOCK_BINARY_CONVERTER_HPP
+
+#include "backend/protobuf/proto_block_json_converter.hpp"
+
+namespace shared_model {
+  namespace proto {
+
+    /**
+     * Block converter for the block store which keeps blocks as protobuf wire
+     * bytes instead of json. Every serialized block is prefixed with a header:
+     *
+     *   | magic (4) | version (1) | payload size (4) | crc32 (4) | payload |
+     *
+     * where integers are big-endian and crc32 is computed over the payload.
+     * Records without the header are considered to be legacy json blocks and
+     * are parsed with ProtoBlockJsonConverter, so block stores written before
+     * the switch stay readable.
+     */
+    class ProtoBlockBinaryConverter : public interface::BlockJsonConverter {
+     public:
+      /// Signature at the beginning of each binary block record
+      static const std::string kMagic;
+
+      /// Current version of the binary record layout
+      static constexpr uint8_t kVersion = 1;
+
+      /// Size of the record header preceding the protobuf payload
+      static constexpr size_t kHeaderSize = 13;
+
+      iroha::expected::Result<interface::types::JsonType, std::string>
+      serialize(const interface::Block &block) const noexcept override;
+
+      iroha::expected::Result<std::unique_ptr<interface::Block>, std::string>
+      deserialize(const interface::types::JsonType &record) const
+          noexcept override;
+
+      /**
+       * Parse binary records in place, without copying them to a string
+       */
+      iroha::expected::Result<std::unique_ptr<interface::Block>, std::string>
+      deserializeFromArray(const char *data, size_t size) const
+          noexcept override;
+
+      /**
+       * Check whether the record was written by this converter
+       * @param record - serialized block
+       * @return true if the record starts with the binary header signature
+       */
+      static bool isBinary(const std::string &record);
+
+      /**
+       * Check whether the record was written by this converter
+       * @param data - pointer to the serialized block
+       * @param size - size of the serialized block
+       * @return true if the record starts with the binary header signature
+       */
+      static bool isBinary(const char *data, size_t size);
+
+     private:
+      ProtoBlockJsonConverter json_converter_;
+    };
+  }  // namespace proto
+}  // namespace shared_model
+
+#endif  // IROHA_PROTO_BLOCK_BINARY_CONVERTER_HPP
@@ -7,6 +7,7 @@
 #define IROHA_CRYPTO_VERIFIER_HPP
 
 #include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "cryptography/verification_item.hpp"
 
 namespace shared_model {
   namespace crypto {
@@ -36,6 +37,16 @@ namespace shared_model {
         return Algorithm::verify(signedData, source, pubKey);
       }
 
+      /**
+       * Verify several signatures at once
+       * @param batch - signatures with data that was signed and public keys
+       * of signatories
+       * @return true if all signatures are correct
+       */
+      static bool batchVerify(const VerificationBatch &batch) {
+        return Algorithm::batchVerify(batch);
+      }
+
       /// close constructor for forbidding instantiation
       CryptoVerifier() = delete;
     };
@@ -22,6 +22,11 @@ namespace shared_model {
       return Verifier::verify(signedData, orig, publicKey);
     }
 
+    bool CryptoProviderEd25519Sha3::batchVerify(
+        const VerificationBatch &batch) {
+      return Verifier::batchVerify(batch);
+    }
+
     Seed CryptoProviderEd25519Sha3::generateSeed() {
       return Seed(iroha::create_seed().to_string());
     }
@@ -9,6 +9,7 @@
 #include "cryptography/keypair.hpp"
 #include "cryptography/seed.hpp"
 #include "cryptography/signed.hpp"
+#include "cryptography/verification_item.hpp"
 
 namespace shared_model {
   namespace crypto {
@@ -35,6 +36,15 @@ namespace shared_model {
       static bool verify(const Signed &signedData,
                          const Blob &orig,
                          const PublicKey &publicKey);
+
+      /**
+       * Verifies several signatures at once, which is cheaper than verifying
+       * them one by one.
+       * @param batch - signatures with data and public keys
+       * @return true if all signatures are valid, false otherwise
+       */
+      static bool batchVerify(const VerificationBatch &batch);
+
       /**
        * Generates new seed
        * @return Seed generated
@@ -4,11 +4,20 @@
  */
 
 #include "verifier.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <unordered_map>
+
 #include "cryptography/ed25519_sha3_impl/internal/ed25519_impl.hpp"
 #include "cryptography/ed25519_sha3_impl/internal/sha3_hash.hpp"
 
 namespace shared_model {
   namespace crypto {
+    constexpr size_t Verifier::kMinItemsPerThread;
+
     bool Verifier::verify(const Signed &signedData,
                           const Blob &orig,
                           const PublicKey &publicKey) {
@@ -17,5 +26,58 @@ namespace shared_model {
           iroha::pubkey_t::from_string(toBinaryString(publicKey)),
           iroha::sig_t::from_string(toBinaryString(signedData)));
     }
+
+    bool Verifier::batchVerify(const VerificationBatch &batch) {
+      // signed data is the hash of the source, sources shared by several
+      // signatures, e.g. block payload, are hashed once
+      std::unordered_map<const Blob *, std::string> source_hashes;
+      std::vector<const std::string *> hashes;
+      hashes.reserve(batch.size());
+      for (const auto &item : batch) {
+        auto it = source_hashes.find(&item.source);
+        if (it == source_hashes.end()) {
+          it = source_hashes
+                   .emplace(&item.source,
+                            iroha::sha3_256(toBinaryString(item.source))
+                                .to_string())
+                   .first;
+        }
+        hashes.push_back(&it->second);
+      }
+
+      std::atomic<bool> valid{true};
+      auto verify_range = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end and valid; ++i) {
+          const auto &item = batch[i];
+          if (not iroha::verify(
+                  *hashes[i],
+                  iroha::pubkey_t::from_string(
+                      toBinaryString(item.public_key)),
+                  iroha::sig_t::from_string(
+                      toBinaryString(item.signed_data)))) {
+            valid = false;
+          }
+        }
+      };
+
+      const size_t threads = std::max<size_t>(
+          1,
+          std::min<size_t>(std::thread::hardware_concurrency(),
+                           batch.size() / kMinItemsPerThread));
+      const size_t chunk = (batch.size() + threads - 1) / threads;
+      std::vector<std::future<void>> workers;
+      for (size_t begin = chunk; begin < batch.size(); begin += chunk) {
+        workers.push_back(std::async(std::launch::async,
+                                     verify_range,
+                                     begin,
+                                     std::min(begin + chunk, batch.size())));
+      }
+      // the first chunk is verified by the calling thread
+      verify_range(0, std::min(chunk, batch.size()));
+      for (auto &worker : workers) {
+        worker.wait();
+      }
+      return valid;
+    }
   }  // namespace crypto
 }  // namespace shared_model
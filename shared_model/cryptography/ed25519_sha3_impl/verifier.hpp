@@ -8,6 +8,7 @@
 
 #include "cryptography/public_key.hpp"
 #include "cryptography/signed.hpp"
+#include "cryptography/verification_item.hpp"
 
 namespace shared_model {
   namespace crypto {
@@ -16,9 +17,20 @@ namespace shared_model {
      */
     class Verifier {
      public:
+      /// Minimal number of signatures verified by a separate thread
+      static constexpr size_t kMinItemsPerThread = 16;
+
       static bool verify(const Signed &signedData,
                          const Blob &orig,
                          const PublicKey &publicKey);
+
+      /**
+       * Verify several signatures. Data passed as the same object is hashed
+       * once for all of its signatures, and large batches are split between
+       * threads. Verification stops at the first invalid signature
+       * @return true if all signatures are valid
+       */
+      static bool batchVerify(const VerificationBatch &batch);
     };
 
   }  // namespace crypto
@@ -0,0 +1,33 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef IROHA_SHARED_MODEL_VERIFICATION_ITEM_HPP
+#define IROHA_SHARED_MODEL_VERIFICATION_ITEM_HPP
+
+#include <vector>
+
+#include "cryptography/public_key.hpp"
+#include "cryptography/signed.hpp"
+
+namespace shared_model {
+  namespace crypto {
+
+    /**
+     * Signature together with the data and the key it is checked against.
+     * Refers to the objects, which must outlive the verification
+     */
+    struct VerificationItem {
+      const Signed &signed_data;
+      const Blob &source;
+      const PublicKey &public_key;
+    };
+
+    /// Signatures verified at once
+    using VerificationBatch = std::vector<VerificationItem>;
+
+  }  // namespace crypto
+}  // namespace shared_model
+
+#endif  // IROHA_SHARED_MODEL_VERIFICATION_ITEM_HPP
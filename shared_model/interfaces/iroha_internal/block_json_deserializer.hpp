@@ -28,6 +28,19 @@ namespace shared_model {
       virtual iroha::expected::Result<std::unique_ptr<Block>, std::string>
       deserialize(const types::JsonType &json) const noexcept = 0;
 
+      /**
+       * Try to parse a serialized block located in memory which is not owned
+       * by a string, e.g. a memory-mapped block store file. Default
+       * implementation copies the data to a string
+       * @param data - pointer to the first byte of a serialized block
+       * @param size - size of the serialized block
+       * @return pointer to a block if data was valid or an error
+       */
+      virtual iroha::expected::Result<std::unique_ptr<Block>, std::string>
+      deserializeFromArray(const char *data, size_t size) const noexcept {
+        return deserialize(types::JsonType(data, size));
+      }
+
       virtual ~BlockJsonDeserializer() = default;
     };
   }  // namespace interface
@@ -308,6 +308,7 @@ namespace shared_model {
       if (boost::empty(signatures)) {
         reason.second.emplace_back("Signatures cannot be empty");
       }
+      crypto::VerificationBatch batch;
       for (const auto &signature : signatures) {
         const auto &sign = signature.signedData();
         const auto &pkey = signature.publicKey();
@@ -325,11 +326,21 @@ namespace shared_model {
           is_valid = false;
         }
 
-        if (is_valid
-            && not shared_model::crypto::CryptoVerifier<>::verify(
-                   sign, source, pkey)) {
+        if (is_valid) {
+          batch.push_back(crypto::VerificationItem{sign, source, pkey});
+        }
+      }
+
+      if (shared_model::crypto::CryptoVerifier<>::batchVerify(batch)) {
+        return;
+      }
+      // wrong signatures are found one by one only if there are any
+      for (const auto &item : batch) {
+        if (not shared_model::crypto::CryptoVerifier<>::verify(
+                item.signed_data, item.source, item.public_key)) {
           reason.second.push_back((boost::format("Wrong signature [%s;%s]")
-                                   % sign.hex() % pkey.hex())
+                                   % item.signed_data.hex()
+                                   % item.public_key.hex())
                                       .str());
         }
       }
@@ -6,6 +6,8 @@
 #ifndef IROHA_SHARED_MODEL_TRANSACTION_VALIDATOR_HPP
 #define IROHA_SHARED_MODEL_TRANSACTION_VALIDATOR_HPP
 
+#include <atomic>
+
 #include <boost/format.hpp>
 #include <boost/variant.hpp>
 
@@ -45,6 +47,10 @@ namespace shared_model {
           const FieldValidator &validator = FieldValidator())
           : validator_(validator) {}
 
+      CommandValidatorVisitor(const CommandValidatorVisitor &other)
+          : validator_(other.validator_),
+            command_counter(other.command_counter.load()) {}
+
       ReasonsGroupType operator()(
           const interface::AddAssetQuantity &aaq) const {
         ReasonsGroupType reason;
@@ -221,14 +227,14 @@ namespace shared_model {
 
      private:
       FieldValidator validator_;
-      mutable int command_counter{0};
+      // atomic, since transactions may be validated concurrently
+      mutable std::atomic<int> command_counter{0};
 
       // adds command to a reason, appends and increments counter
       void addInvalidCommand(ReasonsGroupType &reason,
                              const std::string &command_name) const {
         reason.first =
-            (boost::format("%d %s") % command_counter % command_name).str();
-        command_counter++;
+            (boost::format("%d %s") % command_counter++ % command_name).str();
       }
     };
 
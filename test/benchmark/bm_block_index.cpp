@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures commit-time cost of block indexing depending on the number of
+ * transactions in a block. Each transaction contains one transfer asset
+ * command, which is the most index-heavy command. Indexing runs in a
+ * transaction which is rolled back after each iteration, so that all
+ * iterations index the same block into the same tables.
+ *
+ * Requires a running postgres, credentials are taken from IROHA_POSTGRES_*
+ * environment variables as in the tests.
+ */
+
+#include <benchmark/benchmark.h>
+#include <soci/postgresql/soci-postgresql.h>
+#include <soci/soci.h>
+#include <boost/filesystem.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include "ametsuchi/impl/postgres_block_index.hpp"
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "datetime/time.hpp"
+#include "framework/config_helper.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+#include "validators/field_validator.hpp"
+
+namespace {
+  shared_model::proto::Block makeBlock(int64_t number_of_txs) {
+    std::vector<shared_model::proto::Transaction> txs;
+    for (int64_t i = 0; i < number_of_txs; i++) {
+      txs.push_back(TestTransactionBuilder()
+                        .createdTime(iroha::time::now() + i)
+                        .creatorAccountId("player@one")
+                        .quorum(1)
+                        .transferAsset(
+                            "player@one", "player@two", "coin#one", "", "5.00")
+                        .build());
+    }
+    return TestBlockBuilder()
+        .height(1)
+        .createdTime(iroha::time::now())
+        .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+        .transactions(txs)
+        .rejectedTransactions(std::vector<shared_model::crypto::Hash>{
+            shared_model::crypto::Hash(std::string(32, '1'))})
+        .build();
+  }
+
+  /**
+   * Creates a database with iroha schema and drops it on destruction
+   */
+  class Database {
+   public:
+    Database()
+        : block_store_path_((boost::filesystem::temp_directory_path()
+                             / boost::filesystem::unique_path())
+                                .string()),
+          pgopt_("dbname=d"
+                 + boost::uuids::to_string(boost::uuids::random_generator()())
+                       .substr(0, 8)
+                 + " " + integration_framework::getPostgresCredsOrDefault()) {
+      auto factory =
+          std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
+              shared_model::validation::FieldValidator>>();
+      iroha::ametsuchi::StorageImpl::create(
+          block_store_path_,
+          pgopt_,
+          factory,
+          std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+          std::make_shared<shared_model::proto::ProtoPermissionToString>())
+          .match(
+              [this](iroha::expected::Value<
+                     std::shared_ptr<iroha::ametsuchi::StorageImpl>> &v) {
+                storage_ = v.value;
+              },
+              [](iroha::expected::Error<std::string> &e) {
+                throw std::runtime_error(e.error);
+              });
+    }
+
+    ~Database() {
+      storage_->dropStorage();
+      boost::filesystem::remove_all(block_store_path_);
+    }
+
+    const std::string &options() const {
+      return pgopt_;
+    }
+
+   private:
+    std::string block_store_path_;
+    std::string pgopt_;
+    std::shared_ptr<iroha::ametsuchi::StorageImpl> storage_;
+  };
+}  // namespace
+
+/**
+ * Indexing of a block with given number of transactions
+ */
+static void BM_IndexBlock(benchmark::State &state) {
+  Database database;
+  soci::session sql(soci::postgresql, database.options());
+  iroha::ametsuchi::PostgresBlockIndex block_index(sql);
+  auto block = makeBlock(state.range(0));
+
+  while (state.KeepRunning()) {
+    sql << "BEGIN";
+    block_index.index(block);
+    state.PauseTiming();
+    sql << "ROLLBACK";
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  sql.close();
+}
+BENCHMARK(BM_IndexBlock)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,218 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Compares block store encodings: protobuf json mapping and binary protobuf
+ * records. Each benchmark is parametrized by the encoding (0 - json,
+ * 1 - protobuf) and the number of transactions in a block.
+ *
+ * BM_LoadRange compares range reads through copying get() and memory-mapped
+ * getView() on both block storages.
+ *
+ * BM_ReadChain decodes every block of an existing block store. Set
+ * IROHA_BENCHMARK_BLOCK_STORE to the path of a block store copied from a real
+ * node to run it; the benchmark is skipped otherwise.
+ */
+
+#include <cstdlib>
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+#include "backend/protobuf/proto_block_binary_converter.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "common/byteutils.hpp"
+#include "datetime/time.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+namespace {
+  std::shared_ptr<shared_model::interface::BlockJsonConverter> makeConverter(
+      int64_t format) {
+    if (format == 0) {
+      return std::make_shared<shared_model::proto::ProtoBlockJsonConverter>();
+    }
+    return std::make_shared<shared_model::proto::ProtoBlockBinaryConverter>();
+  }
+
+  shared_model::proto::Block makeBlock(int64_t number_of_txs) {
+    std::vector<shared_model::proto::Transaction> txs;
+    for (int64_t i = 0; i < number_of_txs; i++) {
+      txs.push_back(TestTransactionBuilder()
+                        .createdTime(iroha::time::now() + i)
+                        .creatorAccountId("player@one")
+                        .quorum(1)
+                        .transferAsset(
+                            "player@one", "player@two", "coin#one", "", "5.00")
+                        .build());
+    }
+    return TestBlockBuilder()
+        .height(1)
+        .createdTime(iroha::time::now())
+        .prevHash(shared_model::crypto::Hash(std::string(32, '0')))
+        .transactions(txs)
+        .build();
+  }
+
+  /// json and protobuf encodings for blocks of 1, 100 and 1000 transactions
+  void formatsAndSizes(benchmark::internal::Benchmark *b) {
+    for (int format : {0, 1}) {
+      for (int number_of_txs : {1, 100, 1000}) {
+        b->Args({format, number_of_txs});
+      }
+    }
+  }
+
+  template <typename T>
+  T unwrap(iroha::expected::Result<T, std::string> result) {
+    return std::move(
+        boost::get<iroha::expected::Value<T>>(std::move(result)).value);
+  }
+}  // namespace
+
+/**
+ * Encoding of a block to the block store record
+ */
+static void BM_Serialize(benchmark::State &state) {
+  auto converter = makeConverter(state.range(0));
+  auto block = makeBlock(state.range(1));
+
+  size_t bytes = 0;
+  while (state.KeepRunning()) {
+    auto record = unwrap(converter->serialize(block));
+    bytes += record.size();
+    benchmark::DoNotOptimize(record);
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_Serialize)->Apply(formatsAndSizes)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Decoding of a block store record, including access to the transactions
+ */
+static void BM_Deserialize(benchmark::State &state) {
+  auto converter = makeConverter(state.range(0));
+  auto record = unwrap(converter->serialize(makeBlock(state.range(1))));
+
+  while (state.KeepRunning()) {
+    auto block = unwrap(converter->deserialize(record));
+    benchmark::DoNotOptimize(block->transactions());
+  }
+  state.SetBytesProcessed(state.iterations() * record.size());
+}
+BENCHMARK(BM_Deserialize)
+    ->Apply(formatsAndSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Store and load of a block through the flat file, as done on commit and by
+ * block queries
+ */
+static void BM_StoreAndLoad(benchmark::State &state) {
+  auto converter = makeConverter(state.range(0));
+  auto block = makeBlock(state.range(1));
+  auto path = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path();
+  auto block_store =
+      std::move(*iroha::ametsuchi::FlatFile::create(path.string()));
+
+  iroha::ametsuchi::FlatFile::Identifier id = 0;
+  while (state.KeepRunning()) {
+    auto record = unwrap(converter->serialize(block));
+    block_store->add(++id, iroha::stringToBytes(record));
+    auto loaded = unwrap(
+        converter->deserialize(iroha::bytesToString(*block_store->get(id))));
+    benchmark::DoNotOptimize(loaded);
+  }
+  boost::filesystem::remove_all(path);
+}
+BENCHMARK(BM_StoreAndLoad)
+    ->Apply(formatsAndSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Read and decoding of a range of binary blocks, as done by block loader for a
+ * lagging peer. Parametrized by the storage (0 - flat file, 1 - segmented
+ * log) and the read path (0 - get, 1 - getView)
+ */
+static void BM_LoadRange(benchmark::State &state) {
+  const iroha::ametsuchi::KeyValueStorage::Identifier kBlocks = 1000;
+  shared_model::proto::ProtoBlockBinaryConverter converter;
+  auto path = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path();
+  std::unique_ptr<iroha::ametsuchi::KeyValueStorage> block_store;
+  if (state.range(0) == 0) {
+    block_store = std::move(*iroha::ametsuchi::FlatFile::create(path.string()));
+  } else {
+    block_store =
+        std::move(*iroha::ametsuchi::SegmentedLog::create(path.string()));
+  }
+  auto record =
+      iroha::stringToBytes(unwrap(converter.serialize(makeBlock(10))));
+  for (iroha::ametsuchi::KeyValueStorage::Identifier id = 1; id <= kBlocks;
+       ++id) {
+    block_store->add(id, record);
+  }
+
+  while (state.KeepRunning()) {
+    for (iroha::ametsuchi::KeyValueStorage::Identifier id = 1; id <= kBlocks;
+         ++id) {
+      if (state.range(1) == 0) {
+        benchmark::DoNotOptimize(unwrap(converter.deserialize(
+            iroha::bytesToString(*block_store->get(id)))));
+      } else {
+        auto view = block_store->getView(id);
+        benchmark::DoNotOptimize(unwrap(converter.deserializeFromArray(
+            reinterpret_cast<const char *>(view->data), view->size)));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBlocks);
+  boost::filesystem::remove_all(path);
+}
+BENCHMARK(BM_LoadRange)
+    ->Args({0, 0})
+    ->Args({0, 1})
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * Decoding of all blocks of a real chain
+ */
+static void BM_ReadChain(benchmark::State &state) {
+  const char *path = std::getenv("IROHA_BENCHMARK_BLOCK_STORE");
+  if (path == nullptr) {
+    state.SkipWithError("IROHA_BENCHMARK_BLOCK_STORE is not set");
+    return;
+  }
+  auto converter = makeConverter(state.range(0));
+  shared_model::proto::ProtoBlockBinaryConverter reader;
+  auto source = std::move(*iroha::ametsuchi::FlatFile::create(path));
+
+  // re-encode the chain to the benchmarked format in memory
+  std::vector<std::string> records;
+  for (iroha::ametsuchi::FlatFile::Identifier id = 1; id <= source->last_id();
+       ++id) {
+    auto block =
+        unwrap(reader.deserialize(iroha::bytesToString(*source->get(id))));
+    records.push_back(unwrap(converter->serialize(*block)));
+  }
+
+  size_t bytes = 0;
+  while (state.KeepRunning()) {
+    for (const auto &record : records) {
+      benchmark::DoNotOptimize(unwrap(converter->deserialize(record)));
+      bytes += record.size();
+    }
+  }
+  state.SetBytesProcessed(bytes);
+  state.counters["blocks"] = records.size();
+}
+BENCHMARK(BM_ReadChain)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,214 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the number of commands per second executed by
+ * PostgresCommandExecutor with validation for each command type. Every
+ * iteration executes one valid command in a savepoint, which is rolled back
+ * afterwards, so that all iterations execute the command on the same state.
+ *
+ * Requires a running postgres, credentials are taken from IROHA_POSTGRES_*
+ * environment variables as in the tests.
+ */
+
+#include <benchmark/benchmark.h>
+#include <soci/postgresql/soci-postgresql.h>
+#include <soci/soci.h>
+#include <boost/filesystem.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include "ametsuchi/impl/postgres_command_executor.hpp"
+#include "ametsuchi/impl/storage_impl.hpp"
+#include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "backend/protobuf/proto_block_json_converter.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "datetime/time.hpp"
+#include "framework/config_helper.hpp"
+#include "interfaces/commands/command_variant.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+#include "validators/field_validator.hpp"
+
+namespace {
+  using shared_model::interface::permissions::Grantable;
+  using shared_model::interface::permissions::Role;
+
+  const std::string kAdmin = "admin@test";
+  const std::string kUser = "user@test";
+  const std::string kAsset = "coin#test";
+
+  shared_model::crypto::PublicKey makeKey(char c) {
+    return shared_model::crypto::PublicKey(std::string(32, c));
+  }
+
+  /**
+   * Creates a database with iroha schema and drops it on destruction
+   */
+  class Database {
+   public:
+    Database()
+        : block_store_path_((boost::filesystem::temp_directory_path()
+                             / boost::filesystem::unique_path())
+                                .string()),
+          pgopt_("dbname=d"
+                 + boost::uuids::to_string(boost::uuids::random_generator()())
+                       .substr(0, 8)
+                 + " " + integration_framework::getPostgresCredsOrDefault()) {
+      auto factory =
+          std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
+              shared_model::validation::FieldValidator>>();
+      iroha::ametsuchi::StorageImpl::create(
+          block_store_path_,
+          pgopt_,
+          factory,
+          std::make_shared<shared_model::proto::ProtoBlockJsonConverter>(),
+          std::make_shared<shared_model::proto::ProtoPermissionToString>())
+          .match(
+              [this](iroha::expected::Value<
+                     std::shared_ptr<iroha::ametsuchi::StorageImpl>> &v) {
+                storage_ = v.value;
+              },
+              [](iroha::expected::Error<std::string> &e) {
+                throw std::runtime_error(e.error);
+              });
+    }
+
+    ~Database() {
+      storage_->dropStorage();
+      boost::filesystem::remove_all(block_store_path_);
+    }
+
+    const std::string &options() const {
+      return pgopt_;
+    }
+
+   private:
+    std::string block_store_path_;
+    std::string pgopt_;
+    std::shared_ptr<iroha::ametsuchi::StorageImpl> storage_;
+  };
+
+  auto builder() {
+    return TestTransactionBuilder()
+        .creatorAccountId(kAdmin)
+        .createdTime(iroha::time::now())
+        .quorum(1);
+  }
+
+  /**
+   * State in which every benchmarked command is valid: the admin has all
+   * permissions, two signatories and a balance, the user has a grantable
+   * permission of the admin
+   */
+  shared_model::proto::Transaction genesis() {
+    shared_model::interface::RolePermissionSet all;
+    all.set();
+    return builder()
+        .createRole("admin", all)
+        .createRole("user", {Role::kReceive})
+        .createRole("other", {Role::kReceive})
+        .createDomain("test", "user")
+        .createAccount("admin", "test", makeKey('a'))
+        .createAccount("user", "test", makeKey('u'))
+        .appendRole(kAdmin, "admin")
+        .addSignatory(kAdmin, makeKey('b'))
+        .grantPermission(kUser, Grantable::kSetMyAccountDetail)
+        .createAsset("coin", "test", 2)
+        .addAssetQuantity(kAsset, "1000000.00")
+        .build();
+  }
+
+  /**
+   * Execution of a command built by the given function
+   */
+  template <typename CommandBuilder>
+  void BM_Command(benchmark::State &state, CommandBuilder build_command) {
+    Database database;
+    soci::session sql(soci::postgresql, database.options());
+    iroha::ametsuchi::PostgresCommandExecutor::prepareStatements(sql);
+    iroha::ametsuchi::PostgresCommandExecutor executor(
+        sql, std::make_shared<shared_model::proto::ProtoPermissionToString>());
+
+    sql << "BEGIN";
+    executor.setCreatorAccountId(kAdmin);
+    executor.doValidation(false);
+    auto initial_state = genesis();
+    for (const auto &command : initial_state.commands()) {
+      boost::apply_visitor(executor, command.get());
+    }
+    executor.doValidation(true);
+
+    auto transaction = build_command(builder()).build();
+    const auto &command = transaction.commands().front().get();
+    while (state.KeepRunning()) {
+      state.PauseTiming();
+      sql << "SAVEPOINT iteration";
+      state.ResumeTiming();
+      auto result = boost::apply_visitor(executor, command);
+      state.PauseTiming();
+      sql << "ROLLBACK TO SAVEPOINT iteration";
+      if (auto error = boost::get<
+              iroha::expected::Error<iroha::ametsuchi::CommandError>>(
+              &result)) {
+        state.SkipWithError(error->error.toString().c_str());
+      }
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations());
+    sql << "ROLLBACK";
+    sql.close();
+  }
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_Command, AddAssetQuantity, [](auto builder) {
+  return builder.addAssetQuantity(kAsset, "1.00");
+});
+BENCHMARK_CAPTURE(BM_Command, AddPeer, [](auto builder) {
+  return builder.addPeer("127.0.0.1:10001", makeKey('p'));
+});
+BENCHMARK_CAPTURE(BM_Command, AddSignatory, [](auto builder) {
+  return builder.addSignatory(kAdmin, makeKey('c'));
+});
+BENCHMARK_CAPTURE(BM_Command, AppendRole, [](auto builder) {
+  return builder.appendRole(kUser, "other");
+});
+BENCHMARK_CAPTURE(BM_Command, CreateAccount, [](auto builder) {
+  return builder.createAccount("new", "test", makeKey('n'));
+});
+BENCHMARK_CAPTURE(BM_Command, CreateAsset, [](auto builder) {
+  return builder.createAsset("new", "test", 2);
+});
+BENCHMARK_CAPTURE(BM_Command, CreateDomain, [](auto builder) {
+  return builder.createDomain("new", "user");
+});
+BENCHMARK_CAPTURE(BM_Command, CreateRole, [](auto builder) {
+  return builder.createRole("new", {Role::kReceive});
+});
+BENCHMARK_CAPTURE(BM_Command, DetachRole, [](auto builder) {
+  return builder.detachRole(kUser, "user");
+});
+BENCHMARK_CAPTURE(BM_Command, GrantPermission, [](auto builder) {
+  return builder.grantPermission(kUser, Grantable::kSetMyQuorum);
+});
+BENCHMARK_CAPTURE(BM_Command, RemoveSignatory, [](auto builder) {
+  return builder.removeSignatory(kAdmin, makeKey('b'));
+});
+BENCHMARK_CAPTURE(BM_Command, RevokePermission, [](auto builder) {
+  return builder.revokePermission(kUser, Grantable::kSetMyAccountDetail);
+});
+BENCHMARK_CAPTURE(BM_Command, SetAccountDetail, [](auto builder) {
+  return builder.setAccountDetail(kAdmin, "key", "value");
+});
+BENCHMARK_CAPTURE(BM_Command, SetQuorum, [](auto builder) {
+  return builder.setAccountQuorum(kAdmin, 2);
+});
+BENCHMARK_CAPTURE(BM_Command, SubtractAssetQuantity, [](auto builder) {
+  return builder.subtractAssetQuantity(kAsset, "1.00");
+});
+BENCHMARK_CAPTURE(BM_Command, TransferAsset, [](auto builder) {
+  return builder.transferAsset(kAdmin, kUser, kAsset, "", "1.00");
+});
+
+BENCHMARK_MAIN();
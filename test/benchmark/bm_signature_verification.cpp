@@ -0,0 +1,105 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Verification of a set of signatures one by one compared to a batch
+ * verification, parametrized by the number of signatures. *SameData
+ * benchmarks verify signatures of a 1 MiB payload by different keys, like
+ * signatures of a block, *DistinctData ones verify signatures of small
+ * distinct payloads, like YAC votes.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "cryptography/crypto_provider/crypto_verifier.hpp"
+
+namespace {
+  using namespace shared_model::crypto;
+
+  /**
+   * Payloads signed by different keys
+   */
+  struct SignatureSet {
+    SignatureSet(size_t number_of_signatures, bool same_data) {
+      for (size_t i = 0; i < number_of_signatures; ++i) {
+        keypairs.push_back(DefaultCryptoAlgorithmType::generateKeypair());
+        if (i == 0 or not same_data) {
+          payloads.emplace_back(
+              same_data ? std::string(1024 * 1024, 'a')
+                        : "vote for block " + std::to_string(i));
+        }
+      }
+      for (size_t i = 0; i < number_of_signatures; ++i) {
+        const auto &payload = payloads[same_data ? 0 : i];
+        signatures.push_back(
+            DefaultCryptoAlgorithmType::sign(payload, keypairs[i]));
+        batch.push_back(
+            VerificationItem{signatures[i], payload, keypairs[i].publicKey()});
+      }
+    }
+
+    std::vector<Keypair> keypairs;
+    std::vector<Blob> payloads;
+    std::vector<Signed> signatures;
+    VerificationBatch batch;
+  };
+
+  void serialVerify(benchmark::State &state, bool same_data) {
+    SignatureSet set(state.range(0), same_data);
+    while (state.KeepRunning()) {
+      bool valid = true;
+      for (const auto &item : set.batch) {
+        valid = valid
+            and CryptoVerifier<>::verify(
+                    item.signed_data, item.source, item.public_key);
+      }
+      benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void batchVerify(benchmark::State &state, bool same_data) {
+    SignatureSet set(state.range(0), same_data);
+    while (state.KeepRunning()) {
+      benchmark::DoNotOptimize(CryptoVerifier<>::batchVerify(set.batch));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}  // namespace
+
+static void BM_SerialVerifySameData(benchmark::State &state) {
+  serialVerify(state, true);
+}
+BENCHMARK(BM_SerialVerifySameData)
+    ->RangeMultiplier(4)
+    ->Range(1, 256)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_BatchVerifySameData(benchmark::State &state) {
+  batchVerify(state, true);
+}
+BENCHMARK(BM_BatchVerifySameData)
+    ->RangeMultiplier(4)
+    ->Range(1, 256)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_SerialVerifyDistinctData(benchmark::State &state) {
+  serialVerify(state, false);
+}
+BENCHMARK(BM_SerialVerifyDistinctData)
+    ->RangeMultiplier(4)
+    ->Range(1, 256)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_BatchVerifyDistinctData(benchmark::State &state) {
+  batchVerify(state, false);
+}
+BENCHMARK(BM_BatchVerifyDistinctData)
+    ->RangeMultiplier(4)
+    ->Range(1, 256)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Cost of delivering transaction statuses to many concurrently open status
+ * streams, each waiting for its own transaction. BM_FilterStreams subscribes
+ * every stream to all statuses and filters them by hash, BM_DispatchStreams
+ * uses StatusDispatcher. Both are parametrized by the number of open streams,
+ * and each iteration publishes one status for every stream.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "backend/protobuf/proto_tx_status_factory.hpp"
+#include "torii/impl/status_dispatcher.hpp"
+
+namespace {
+  using Response = iroha::torii::StatusDispatcher::Response;
+
+  std::vector<Response> makeStatuses(int64_t number_of_streams) {
+    std::shared_ptr<shared_model::interface::TxStatusFactory> factory =
+        std::make_shared<shared_model::proto::ProtoTxStatusFactory>();
+    std::vector<Response> statuses;
+    for (int64_t i = 0; i < number_of_streams; ++i) {
+      statuses.push_back(factory->makeStatelessValid(
+          shared_model::crypto::Hash("tx" + std::to_string(i))));
+    }
+    return statuses;
+  }
+}  // namespace
+
+static void BM_FilterStreams(benchmark::State &state) {
+  rxcpp::subjects::subject<Response> bus;
+  auto statuses = makeStatuses(state.range(0));
+  size_t received = 0;
+  rxcpp::composite_subscription subscriptions;
+  for (const auto &status : statuses) {
+    auto hash = status->transactionHash();
+    bus.get_observable()
+        .filter([hash](const Response &response) {
+          return response->transactionHash() == hash;
+        })
+        .subscribe(subscriptions, [&received](auto) { ++received; });
+  }
+
+  while (state.KeepRunning()) {
+    for (const auto &status : statuses) {
+      bus.get_subscriber().on_next(status);
+    }
+  }
+  subscriptions.unsubscribe();
+  state.SetItemsProcessed(received);
+}
+BENCHMARK(BM_FilterStreams)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_DispatchStreams(benchmark::State &state) {
+  rxcpp::subjects::subject<Response> bus;
+  auto dispatcher =
+      std::make_shared<iroha::torii::StatusDispatcher>(bus.get_observable());
+  auto statuses = makeStatuses(state.range(0));
+  size_t received = 0;
+  rxcpp::composite_subscription subscriptions;
+  for (const auto &status : statuses) {
+    dispatcher->statuses(status->transactionHash())
+        .subscribe(subscriptions, [&received](auto) { ++received; });
+  }
+
+  while (state.KeepRunning()) {
+    for (const auto &status : statuses) {
+      bus.get_subscriber().on_next(status);
+    }
+  }
+  subscriptions.unsubscribe();
+  state.SetItemsProcessed(received);
+  auto metrics = dispatcher->metrics();
+  state.counters["fan_out"] = metrics.published == 0
+      ? 0.
+      : static_cast<double>(metrics.delivered) / metrics.published;
+}
+BENCHMARK(BM_DispatchStreams)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
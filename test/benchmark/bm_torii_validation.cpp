@@ -0,0 +1,129 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Throughput of stateless validation of a transaction list received by
+ * Torii. BM_SerialValidation builds transactions one by one, as Torii did
+ * before, BM_ParallelValidation spreads them over the tbb worker pool in the
+ * same way as CommandServiceTransportGrpc does. Both are parametrized by the
+ * number of transactions in the list, and each iteration validates the whole
+ * list.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <tbb/parallel_for.h>
+
+#include "backend/protobuf/proto_transport_factory.hpp"
+#include "backend/protobuf/transaction.hpp"
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "datetime/time.hpp"
+#include "endpoint.pb.h"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+#include "validators/default_validator.hpp"
+#include "validators/protobuf/proto_transaction_validator.hpp"
+
+namespace {
+  using FactoryType = shared_model::proto::ProtoTransportFactory<
+      shared_model::interface::Transaction,
+      shared_model::proto::Transaction>;
+  using BuildResult = iroha::expected::Result<
+      std::unique_ptr<shared_model::interface::Transaction>,
+      FactoryType::Error>;
+
+  /**
+   * Factory with the same validators as the one used by Torii
+   */
+  std::shared_ptr<FactoryType> makeFactory() {
+    return std::make_shared<FactoryType>(
+        std::make_unique<shared_model::validation::
+                             DefaultOptionalSignedTransactionValidator>(),
+        std::make_shared<
+            shared_model::validation::ProtoTransactionValidator>());
+  }
+
+  /**
+   * @return 1 if the transaction is valid, 0 otherwise
+   */
+  size_t isValid(const BuildResult &result) {
+    return boost::get<iroha::expected::Value<
+               std::unique_ptr<shared_model::interface::Transaction>>>(
+               &result)
+        ? 1
+        : 0;
+  }
+
+  /**
+   * List of signed transactions, each with a few transfers
+   */
+  iroha::protocol::TxList makeTransactions(int64_t number_of_transactions) {
+    auto keypair =
+        shared_model::crypto::DefaultCryptoAlgorithmType::generateKeypair();
+    iroha::protocol::TxList list;
+    for (int64_t i = 0; i < number_of_transactions; ++i) {
+      auto tx = TestUnsignedTransactionBuilder()
+                    .creatorAccountId("player@one")
+                    .createdTime(iroha::time::now() + i)
+                    .quorum(1)
+                    .transferAsset(
+                        "player@one", "player@two", "coin#one", "", "5.00")
+                    .transferAsset(
+                        "player@one", "player@three", "coin#one", "", "5.00")
+                    .build()
+                    .signAndAddSignature(keypair)
+                    .finish();
+      *list.add_transactions() = tx.getTransport();
+    }
+    return list;
+  }
+}  // namespace
+
+static void BM_SerialValidation(benchmark::State &state) {
+  auto factory = makeFactory();
+  auto list = makeTransactions(state.range(0));
+  size_t valid = 0;
+
+  while (state.KeepRunning()) {
+    for (const auto &tx : list.transactions()) {
+      valid += isValid(factory->build(tx));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["valid"] = valid / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_SerialValidation)
+    ->RangeMultiplier(10)
+    ->Range(1, 1000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_ParallelValidation(benchmark::State &state) {
+  auto factory = makeFactory();
+  auto list = makeTransactions(state.range(0));
+  size_t valid = 0;
+
+  while (state.KeepRunning()) {
+    std::vector<BuildResult> results(list.transactions_size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, results.size()),
+        [&](const tbb::blocked_range<size_t> &range) {
+          for (auto i = range.begin(); i != range.end(); ++i) {
+            results[i] = factory->build(list.transactions(i));
+          }
+        });
+    for (const auto &result : results) {
+      valid += isValid(result);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["valid"] = valid / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_ParallelValidation)
+    ->RangeMultiplier(10)
+    ->Range(1, 1000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
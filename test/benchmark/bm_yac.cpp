@@ -0,0 +1,205 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Cost of a YAC round depending on the number of peers. All peers run in
+ * the same process and exchange messages through an in-memory queue, votes
+ * are signed and verified with real keys. Each iteration is a round in which
+ * every peer votes for the same hash, and the round ends when all peers have
+ * received the commit. Reported counters are per round: number of sent
+ * messages, bytes of serialized messages and commits emitted by peers.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <unordered_map>
+
+#include "backend/protobuf/common_objects/peer.hpp"
+#include "backend/protobuf/common_objects/proto_common_objects_factory.hpp"
+#include "consensus/yac/impl/yac_crypto_provider_impl.hpp"
+#include "consensus/yac/storage/yac_vote_storage.hpp"
+#include "consensus/yac/timer.hpp"
+#include "consensus/yac/transport/yac_pb_converters.hpp"
+#include "consensus/yac/yac.hpp"
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "validators/field_validator.hpp"
+
+namespace {
+  using namespace iroha::consensus::yac;
+
+  /**
+   * Timer which never fires, so votes are sent only to the first leader
+   */
+  class NoTimer : public Timer {
+   public:
+    void invokeAfterDelay(std::function<void()> handler) override {}
+    void deny() override {}
+  };
+
+  /**
+   * Delivers messages between peers of the same process in order of sending
+   */
+  class InProcessNetwork : public YacNetwork {
+   public:
+    InProcessNetwork(std::shared_ptr<std::deque<std::pair<
+                         std::string,
+                         std::shared_ptr<std::vector<VoteMessage>>>>> queue,
+                     uint64_t &messages,
+                     uint64_t &bytes)
+        : queue_(std::move(queue)),
+          messages_(messages),
+          bytes_(bytes) {}
+
+    void subscribe(std::shared_ptr<YacNetworkNotifications> handler) override {
+      handler_ = handler;
+    }
+
+    void sendState(const shared_model::interface::Peer &to,
+                   const std::vector<VoteMessage> &state) override {
+      send(to, std::make_shared<std::vector<VoteMessage>>(state), size(state));
+    }
+
+    void broadcastState(
+        const std::vector<std::shared_ptr<shared_model::interface::Peer>> &to,
+        const std::vector<VoteMessage> &state) override {
+      auto shared_state = std::make_shared<std::vector<VoteMessage>>(state);
+      auto state_size = size(state);
+      for (const auto &peer : to) {
+        send(*peer, shared_state, state_size);
+      }
+    }
+
+    void deliver(const std::vector<VoteMessage> &state) {
+      handler_.lock()->onState(state);
+    }
+
+   private:
+    static size_t size(const std::vector<VoteMessage> &state) {
+      proto::State request;
+      for (const auto &vote : state) {
+        *request.add_votes() = PbConverters::serializeVote(vote);
+      }
+      return request.ByteSizeLong();
+    }
+
+    void send(const shared_model::interface::Peer &to,
+              std::shared_ptr<std::vector<VoteMessage>> state,
+              size_t state_size) {
+      ++messages_;
+      bytes_ += state_size;
+      queue_->emplace_back(to.address(), std::move(state));
+    }
+
+    std::shared_ptr<std::deque<
+        std::pair<std::string, std::shared_ptr<std::vector<VoteMessage>>>>>
+        queue_;
+    uint64_t &messages_;
+    uint64_t &bytes_;
+    std::weak_ptr<YacNetworkNotifications> handler_;
+  };
+
+  /**
+   * Peers of a network and their YAC instances
+   */
+  class Cluster {
+   public:
+    explicit Cluster(size_t number_of_peers)
+        : queue_(std::make_shared<decltype(queue_)::element_type>()) {
+      auto factory =
+          std::make_shared<shared_model::proto::ProtoCommonObjectsFactory<
+              shared_model::validation::FieldValidator>>();
+      std::vector<shared_model::crypto::Keypair> keypairs;
+      for (size_t i = 0; i < number_of_peers; ++i) {
+        using shared_model::crypto::DefaultCryptoAlgorithmType;
+        keypairs.push_back(DefaultCryptoAlgorithmType::generateKeypair());
+        iroha::protocol::Peer peer;
+        peer.set_address("peer" + std::to_string(i));
+        peer.set_peer_key(keypairs.back().publicKey().hex());
+        peers_.push_back(std::make_shared<shared_model::proto::Peer>(peer));
+      }
+      order_ = *ClusterOrdering::create(peers_);
+
+      for (size_t i = 0; i < number_of_peers; ++i) {
+        auto network =
+            std::make_shared<InProcessNetwork>(queue_, messages, bytes);
+        auto yac = Yac::create(
+            YacVoteStorage(),
+            network,
+            std::make_shared<CryptoProviderImpl>(keypairs[i], factory),
+            std::make_shared<NoTimer>(),
+            *order_);
+        network->subscribe(yac);
+        yac->onOutcome().subscribe(subscription_,
+                                   [this](const auto &) { ++commits; });
+        networks_.emplace(peers_[i]->address(), network);
+        yacs_.push_back(yac);
+      }
+    }
+
+    ~Cluster() {
+      subscription_.unsubscribe();
+    }
+
+    /**
+     * Vote for the hash on all peers and deliver messages until none is left
+     */
+    void round(const YacHash &hash) {
+      for (auto &yac : yacs_) {
+        yac->vote(hash, *order_);
+      }
+      while (not queue_->empty()) {
+        auto message = std::move(queue_->front());
+        queue_->pop_front();
+        networks_.at(message.first)->deliver(*message.second);
+      }
+    }
+
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t commits = 0;
+
+   private:
+    std::shared_ptr<std::deque<
+        std::pair<std::string, std::shared_ptr<std::vector<VoteMessage>>>>>
+        queue_;
+    std::vector<std::shared_ptr<shared_model::interface::Peer>> peers_;
+    boost::optional<ClusterOrdering> order_;
+    std::unordered_map<std::string, std::shared_ptr<InProcessNetwork>>
+        networks_;
+    std::vector<std::shared_ptr<Yac>> yacs_;
+    rxcpp::composite_subscription subscription_;
+  };
+}  // namespace
+
+/**
+ * YAC round among the given number of peers
+ */
+static void BM_YacRound(benchmark::State &state) {
+  spdlog::set_level(spdlog::level::err);
+  Cluster cluster(state.range(0));
+  uint64_t block_round = 0;
+
+  while (state.KeepRunning()) {
+    ++block_round;
+    cluster.round(YacHash(iroha::consensus::Round{block_round, 0},
+                          "proposal" + std::to_string(block_round),
+                          "block" + std::to_string(block_round)));
+  }
+
+  auto rounds = static_cast<double>(state.iterations());
+  state.counters["messages"] = cluster.messages / rounds;
+  state.counters["bytes"] = cluster.bytes / rounds;
+  state.counters["commits"] = cluster.commits / rounds;
+}
+BENCHMARK(BM_YacRound)
+    ->Arg(4)
+    ->Arg(10)
+    ->Arg(25)
+    ->Arg(50)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -141,31 +141,39 @@ CREATE TABLE IF NOT EXISTS account_has_grantable_permissions (
     PRIMARY KEY (permittee_account_id, account_id, permission_id)
 );
 CREATE TABLE IF NOT EXISTS position_by_hash (
-    hash varchar,
-    height text,
-    index text
+    hash bytea NOT NULL,
+    height bigint NOT NULL,
+    index bigint NOT NULL,
+    PRIMARY KEY (height, index)
 );
 
 CREATE TABLE IF NOT EXISTS tx_status_by_hash (
-    hash varchar,
-    status boolean
+    hash bytea NOT NULL,
+    status boolean NOT NULL,
+    height bigint
 );
 
 CREATE TABLE IF NOT EXISTS height_by_account_set (
-    account_id text,
-    height text
+    account_id text NOT NULL,
+    height bigint NOT NULL
 );
 CREATE TABLE IF NOT EXISTS index_by_creator_height (
     id serial,
-    creator_id text,
-    height text,
-    index text
-);
-CREATE TABLE IF NOT EXISTS index_by_id_height_asset (
-    id text,
-    height text,
-    asset_id text,
-    index text
+    creator_id text NOT NULL,
+    height bigint NOT NULL,
+    index bigint NOT NULL,
+    PRIMARY KEY (id)
+);
+CREATE TABLE IF NOT EXISTS position_by_account_asset (
+    account_id text NOT NULL,
+    asset_id text NOT NULL,
+    height bigint NOT NULL,
+    index bigint NOT NULL
+);
+CREATE TABLE IF NOT EXISTS height_by_block_hash (
+    hash bytea NOT NULL,
+    height bigint NOT NULL,
+    PRIMARY KEY (hash)
 );
 )";
     };
@@ -155,9 +155,19 @@ namespace iroha {
                        shared_model::interface::types::HeightType));
       MOCK_METHOD1(getTopBlocks, std::vector<BlockQuery::wBlock>(uint32_t));
       MOCK_METHOD0(getTopBlock, expected::Result<wBlock, std::string>(void));
+      MOCK_METHOD1(getBlockHeight,
+                   boost::optional<shared_model::interface::types::HeightType>(
+                       const shared_model::crypto::Hash &));
       MOCK_METHOD1(checkTxPresence,
                    boost::optional<TxCacheStatusType>(
                        const shared_model::crypto::Hash &));
+      MOCK_METHOD1(checkTxsPresence,
+                   boost::optional<std::vector<TxCacheStatusType>>(
+                       const std::vector<shared_model::crypto::Hash> &));
+      MOCK_METHOD1(forEachTxHash,
+                   boost::optional<size_t>(
+                       const std::function<void(
+                           const shared_model::crypto::Hash &)> &));
       MOCK_METHOD0(getTopBlockHeight, uint32_t(void));
     };
 
@@ -172,6 +182,15 @@ namespace iroha {
         // gmock workaround for non-copyable parameters
         prepareBlock_(wsv);
       }
+
+      MOCK_METHOD2(prepareBlockAsync_,
+                   void(std::unique_ptr<TemporaryWsv> &, PreparationWork));
+
+      void prepareBlockAsync(std::unique_ptr<TemporaryWsv> wsv,
+                             PreparationWork work) override {
+        // gmock workaround for non-copyable parameters
+        prepareBlockAsync_(wsv, std::move(work));
+      }
     };
 
     class MockTemporaryWsv : public TemporaryWsv {
@@ -182,6 +201,12 @@ namespace iroha {
       MOCK_METHOD1(
           createSavepoint,
           std::unique_ptr<TemporaryWsv::SavepointWrapper>(const std::string &));
+      MOCK_METHOD1(
+          fork,
+          std::unique_ptr<TemporaryWsv>(const std::vector<
+                                        shared_model::interface::types::
+                                            TransactionsCollectionType> &));
+      MOCK_METHOD1(join, void(TemporaryWsv &));
     };
 
     class MockTemporaryWsvSavepointWrapper
@@ -266,7 +291,13 @@ namespace iroha {
       MOCK_METHOD1(insertBlocks,
                    bool(const std::vector<
                         std::shared_ptr<shared_model::interface::Block>> &));
+      MOCK_METHOD1(applyStoredBlocks,
+                   bool(shared_model::interface::types::HeightType));
+      MOCK_METHOD0(
+          restoreWsvSnapshot,
+          boost::optional<shared_model::interface::types::HeightType>());
       MOCK_METHOD0(reset, void(void));
+      MOCK_METHOD0(resetWsv, void(void));
       MOCK_METHOD0(dropStorage, void(void));
       MOCK_METHOD0(freeConnections, void(void));
       MOCK_METHOD1(prepareBlock_, void(std::unique_ptr<TemporaryWsv> &));
@@ -276,15 +307,30 @@ namespace iroha {
         prepareBlock_(wsv);
       }
 
+      MOCK_METHOD2(prepareBlockAsync_,
+                   void(std::unique_ptr<TemporaryWsv> &, PreparationWork));
+
+      void prepareBlockAsync(std::unique_ptr<TemporaryWsv> wsv,
+                             PreparationWork work) override {
+        // gmock workaround for non-copyable parameters
+        prepareBlockAsync_(wsv, std::move(work));
+      }
+
       rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
       on_commit() override {
         return notifier.get_observable();
       }
+      rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
+      on_pre_commit() override {
+        return pre_commit_notifier.get_observable();
+      }
       void commit(std::unique_ptr<MutableStorage> storage) override {
         doCommit(storage.get());
       }
       rxcpp::subjects::subject<std::shared_ptr<shared_model::interface::Block>>
           notifier;
+      rxcpp::subjects::subject<std::shared_ptr<shared_model::interface::Block>>
+          pre_commit_notifier;
     };
 
     class MockKeyValueStorage : public KeyValueStorage {
@@ -338,6 +384,11 @@ namespace iroha {
           check,
           boost::optional<TxPresenceCache::BatchStatusCollectionType>(
               const shared_model::interface::TransactionBatch &));
+
+      MOCK_CONST_METHOD1(
+          check,
+          boost::optional<TxPresenceCache::BatchStatusCollectionType>(
+              const std::vector<shared_model::crypto::Hash> &));
     };
 
     namespace tx_cache_status_responses {
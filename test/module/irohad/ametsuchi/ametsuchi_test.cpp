@@ -3,6 +3,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <atomic>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include "ametsuchi/impl/postgres_block_query.hpp"
@@ -590,6 +593,117 @@ TEST_F(AmetsuchiTest, TestRestoreWSV) {
   EXPECT_TRUE(res);
 }
 
+/**
+ * Make a block which creates the domain, the role is created as well for the
+ * first block
+ */
+shared_model::proto::Block makeDomainBlock(
+    shared_model::interface::types::HeightType height,
+    const shared_model::crypto::Hash &prev_hash,
+    const std::string &domain) {
+  const std::string role = "admin";
+  auto tx_builder = [] {
+    return shared_model::proto::TransactionBuilder()
+        .creatorAccountId("admin@test")
+        .createdTime(iroha::time::now())
+        .quorum(1);
+  };
+  auto keypair =
+      shared_model::crypto::DefaultCryptoAlgorithmType::generateKeypair();
+  std::vector<shared_model::proto::Transaction> txs;
+  if (height == 1) {
+    txs.push_back(tx_builder()
+                      .createRole(role, {Role::kCreateDomain})
+                      .build()
+                      .signAndAddSignature(keypair)
+                      .finish());
+  }
+  txs.push_back(tx_builder()
+                    .createDomain(domain, role)
+                    .build()
+                    .signAndAddSignature(keypair)
+                    .finish());
+  return TestBlockBuilder()
+      .transactions(txs)
+      .height(height)
+      .prevHash(prev_hash)
+      .createdTime(iroha::time::now())
+      .build();
+}
+
+/**
+ * @given storage with two blocks and a WSV snapshot taken after the first one
+ * @when WSV is spoiled @and the snapshot is restored
+ * @then WSV has the state of the first block @and only the first block is
+ * indexed @and applying stored blocks after the snapshot brings both to the
+ * top
+ */
+TEST_F(AmetsuchiTest, RestoreWsvSnapshot) {
+  auto block1 = makeDomainBlock(
+      1,
+      shared_model::crypto::Sha3_256::makeHash(
+          shared_model::crypto::Blob("")),
+      "test");
+  apply(storage, block1);
+  ASSERT_TRUE(storage->createWsvSnapshot());
+  apply(storage, makeDomainBlock(2, block1.hash(), "other"));
+
+  // spoil WSV
+  *sql << "DELETE FROM domain";
+
+  ASSERT_EQ(storage->restoreWsvSnapshot(),
+            boost::make_optional<shared_model::interface::types::HeightType>(
+                1));
+  EXPECT_TRUE(storage->getWsvQuery()->getDomain("test"));
+  EXPECT_FALSE(storage->getWsvQuery()->getDomain("other"));
+  int indexed = 0;
+  *sql << "SELECT count(*) FROM height_by_block_hash", soci::into(indexed);
+  EXPECT_EQ(1, indexed);
+  *sql << "SELECT count(*) FROM tx_status_by_hash", soci::into(indexed);
+  EXPECT_EQ(2, indexed);
+
+  ASSERT_TRUE(storage->applyStoredBlocks(2));
+  EXPECT_TRUE(storage->getWsvQuery()->getDomain("test"));
+  EXPECT_TRUE(storage->getWsvQuery()->getDomain("other"));
+  *sql << "SELECT count(*) FROM height_by_block_hash", soci::into(indexed);
+  EXPECT_EQ(2, indexed);
+  *sql << "SELECT count(*) FROM tx_status_by_hash", soci::into(indexed);
+  EXPECT_EQ(3, indexed);
+}
+
+/**
+ * @given storage with two blocks and a WSV snapshot, which does not match
+ * the stored blocks
+ * @when WSV is spoiled @and restored
+ * @then the snapshot is not used @and WSV is valid
+ */
+TEST_F(AmetsuchiTest, RestoreWsvWithMismatchingSnapshot) {
+  auto block1 = makeDomainBlock(
+      1,
+      shared_model::crypto::Sha3_256::makeHash(
+          shared_model::crypto::Blob("")),
+      "test");
+  apply(storage, block1);
+  ASSERT_TRUE(storage->createWsvSnapshot());
+  apply(storage, makeDomainBlock(2, block1.hash(), "other"));
+
+  *sql << "UPDATE wsv_snapshot.top_block SET hash = decode('00', 'hex')";
+  // spoil WSV
+  *sql << "DELETE FROM domain";
+
+  ASSERT_FALSE(storage->restoreWsvSnapshot());
+
+  WsvRestorerImpl wsvRestorer;
+  wsvRestorer.restoreWsv(*storage).match(
+      [](iroha::expected::Value<void>) {},
+      [&](iroha::expected::Error<std::string> &error) {
+        FAIL() << "Failed to recover WSV";
+      });
+
+  EXPECT_TRUE(storage->getWsvQuery()->getDomain("test"));
+  EXPECT_TRUE(storage->getWsvQuery()->getDomain("other"));
+}
+
 class PreparedBlockTest : public AmetsuchiTest {
  public:
   PreparedBlockTest()
@@ -607,6 +721,29 @@ class PreparedBlockTest : public AmetsuchiTest {
         .finish();
   }
 
+  shared_model::proto::Transaction createTransfer(
+      const std::string &dest_account_id, const std::string &amount) {
+    return shared_model::proto::TransactionBuilder()
+        .creatorAccountId("admin@test")
+        .createdTime(iroha::time::now())
+        .quorum(1)
+        .transferAsset("admin@test", dest_account_id, "coin#test", "", amount)
+        .build()
+        .signAndAddSignature(key)
+        .finish();
+  }
+
+  shared_model::proto::Transaction createDomain(const std::string &domain_id) {
+    return shared_model::proto::TransactionBuilder()
+        .creatorAccountId("admin@test")
+        .createdTime(iroha::time::now())
+        .quorum(1)
+        .createDomain(domain_id, default_role)
+        .build()
+        .signAndAddSignature(key)
+        .finish();
+  }
+
   shared_model::proto::Block createBlock(
       std::initializer_list<shared_model::proto::Transaction> txs) {
     return TestBlockBuilder()
@@ -751,3 +888,116 @@ TEST_F(PreparedBlockTest, CommitPreparedFailsAfterCommit) {
   validateAccountAsset(
       storage->getWsvQuery(), "admin@test", "coin#test", resultingBalance);
 }
+
+/**
+ * @given TemporaryWSV
+ * @when a transaction executed in memory fails @and a valid one is applied
+ * @then only changes of the valid transaction are committed
+ */
+TEST_F(PreparedBlockTest, FailedTransactionInMemory) {
+  using framework::expected::err;
+  ASSERT_TRUE(err(temp_wsv->apply(createTransfer("none@test", "1.00"))));
+  ASSERT_FALSE(err(temp_wsv->apply(*initial_tx)));
+  storage->prepareBlock(std::move(temp_wsv));
+
+  ASSERT_TRUE(storage->commitPrepared(createBlock({*initial_tx})));
+
+  validateAccountAsset(storage->getWsvQuery(),
+                       "admin@test",
+                       "coin#test",
+                       shared_model::interface::Amount("10.00"));
+}
+
+/**
+ * @given TemporaryWSV with a transaction executed in memory
+ * @when transactions executed in memory are applied in a savepoint which is
+ * rolled back @and in a savepoint which is released
+ * @then only changes of the released savepoint are committed
+ */
+TEST_F(PreparedBlockTest, SavepointsOfTransactionsInMemory) {
+  using framework::expected::err;
+  ASSERT_FALSE(err(temp_wsv->apply(*initial_tx)));
+  {
+    auto savepoint = temp_wsv->createSavepoint("rolled_back");
+    ASSERT_FALSE(err(temp_wsv->apply(createAddAsset("1.00"))));
+  }
+  {
+    auto savepoint = temp_wsv->createSavepoint("released");
+    ASSERT_FALSE(err(temp_wsv->apply(createAddAsset("2.00"))));
+    savepoint->release();
+  }
+  storage->prepareBlock(std::move(temp_wsv));
+
+  ASSERT_TRUE(storage->commitPrepared(createBlock({*initial_tx})));
+
+  validateAccountAsset(storage->getWsvQuery(),
+                       "admin@test",
+                       "coin#test",
+                       shared_model::interface::Amount("12.00"));
+}
+
+/**
+ * @given TemporaryWSV with a transaction executed in memory
+ * @when a transaction executed in memory and a transaction executed by the
+ * database are applied in a savepoint which is rolled back
+ * @then changes of both transactions are not committed
+ */
+TEST_F(PreparedBlockTest, SavepointOfTransactionInDatabase) {
+  using framework::expected::err;
+  ASSERT_FALSE(err(temp_wsv->apply(*initial_tx)));
+  {
+    auto savepoint = temp_wsv->createSavepoint("rolled_back");
+    ASSERT_FALSE(err(temp_wsv->apply(createAddAsset("1.00"))));
+    ASSERT_FALSE(err(temp_wsv->apply(createDomain("other"))));
+  }
+  storage->prepareBlock(std::move(temp_wsv));
+
+  ASSERT_TRUE(storage->commitPrepared(createBlock({*initial_tx})));
+
+  validateAccountAsset(storage->getWsvQuery(),
+                       "admin@test",
+                       "coin#test",
+                       shared_model::interface::Amount("10.00"));
+  EXPECT_FALSE(storage->getWsvQuery()->getDomain("other"));
+}
+
+/**
+ * @given Storage with prepared state
+ * @when WSV snapshots are taken while the prepared block is committed
+ * @and the last snapshot is restored @and stored blocks after it are applied
+ * @then the balance has the state of the committed block, so the block is
+ * applied exactly once
+ */
+TEST_F(PreparedBlockTest, SnapshotConcurrentWithCommitPrepared) {
+  auto block = TestBlockBuilder()
+                   .transactions(std::vector<shared_model::proto::Transaction>{
+                       *initial_tx})
+                   .height(2)
+                   .prevHash(genesis_block->hash())
+                   .createdTime(iroha::time::now())
+                   .build();
+  ASSERT_FALSE(framework::expected::err(temp_wsv->apply(*initial_tx)));
+  storage->prepareBlock(std::move(temp_wsv));
+
+  std::atomic<bool> committed{false};
+  std::thread snapshots([&] {
+    bool last;
+    do {
+      last = committed;
+      storage->createWsvSnapshot();
+    } while (not last);
+  });
+  auto commit_result = storage->commitPrepared(block);
+  committed = true;
+  snapshots.join();
+  ASSERT_TRUE(commit_result);
+
+  auto height = storage->restoreWsvSnapshot();
+  ASSERT_TRUE(height);
+  ASSERT_TRUE(storage->applyStoredBlocks(*height + 1));
+
+  validateAccountAsset(storage->getWsvQuery(),
+                       "admin@test",
+                       "coin#test",
+                       shared_model::interface::Amount("10.00"));
+}
@@ -85,6 +85,7 @@ class BlockQueryTest : public AmetsuchiTest {
           [this, &b](const iroha::expected::Value<std::string> &json) {
             file->add(b.height(), iroha::stringToBytes(json.value));
             index->index(b);
+            block_hashes.push_back(b.hash());
             blocks_total++;
           },
           [](const auto &error) { FAIL() << error.error; });
@@ -98,6 +99,7 @@ class BlockQueryTest : public AmetsuchiTest {
 
   std::unique_ptr<soci::session> sql;
   std::vector<shared_model::crypto::Hash> tx_hashes;
+  std::vector<shared_model::crypto::Hash> block_hashes;
   std::shared_ptr<BlockQuery> blocks;
   std::shared_ptr<BlockQuery> empty_blocks;
   std::shared_ptr<BlockIndex> index;
@@ -279,6 +281,48 @@ TEST_F(BlockQueryTest, HasTxWithRejectedHash) {
   });
 }
 
+/**
+ * @given block store with preinserted blocks
+ * @when checkTxsPresence is invoked on a missing, a rejected and committed
+ * hashes
+ * @then statuses of all of them are returned in the same order
+ */
+TEST_F(BlockQueryTest, HasTxsWithMixedHashes) {
+  shared_model::crypto::Hash missing_tx_hash(zero_string);
+  std::vector<shared_model::crypto::Hash> hashes{missing_tx_hash,
+                                                 rejected_hash};
+  hashes.insert(hashes.end(), tx_hashes.begin(), tx_hashes.end());
+
+  auto statuses = blocks->checkTxsPresence(hashes);
+  ASSERT_TRUE(statuses);
+  ASSERT_EQ(statuses->size(), hashes.size());
+  ASSERT_NO_THROW({
+    boost::get<tx_cache_status_responses::Missing>(statuses->at(0));
+    boost::get<tx_cache_status_responses::Rejected>(statuses->at(1));
+    for (size_t i = 2; i < hashes.size(); ++i) {
+      auto status =
+          boost::get<tx_cache_status_responses::Committed>(statuses->at(i));
+      ASSERT_EQ(status.hash, hashes.at(i));
+    }
+  });
+}
+
+/**
+ * @given block store with preinserted blocks
+ * @when getBlockHeight is invoked on hashes of the blocks and on a hash which
+ * is not a block one
+ * @then heights of the blocks are returned @and nothing is returned for the
+ * other hash
+ */
+TEST_F(BlockQueryTest, GetBlockHeightByHash) {
+  for (size_t i = 0; i < block_hashes.size(); ++i) {
+    auto height = blocks->getBlockHeight(block_hashes.at(i));
+    ASSERT_TRUE(height);
+    ASSERT_EQ(*height, i + 1);
+  }
+  ASSERT_FALSE(blocks->getBlockHeight(tx_hashes.front()));
+}
+
 /**
  * @given block store with preinserted blocks
  * @when getTopBlock is invoked on this block store
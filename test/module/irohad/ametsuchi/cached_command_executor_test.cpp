@@ -0,0 +1,345 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/cached_command_executor.hpp"
+
+#include "ametsuchi/impl/postgres_command_executor.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "framework/result_fixture.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
+#include "module/shared_model/mock_objects_factories/mock_command_factory.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using namespace framework::expected;
+    using shared_model::interface::permissions::Grantable;
+    using shared_model::interface::permissions::Role;
+
+    /**
+     * Every command is executed twice from the same state: by
+     * PostgresCommandExecutor and by CachedCommandExecutor with a flush of the
+     * cache afterwards. Results and the resulting balances have to be equal
+     */
+    class CachedCommandExecutorTest : public AmetsuchiTest {
+     public:
+      void SetUp() override {
+        AmetsuchiTest::SetUp();
+        sql = std::make_unique<soci::session>(soci::postgresql, pgopt_);
+        PostgresCommandExecutor::prepareStatements(*sql);
+        *sql << init_;
+
+        postgres_executor =
+            std::make_unique<PostgresCommandExecutor>(*sql, perm_converter);
+        cache = std::make_unique<WsvCache>(*sql);
+        cached_executor = std::make_unique<CachedCommandExecutor>(
+            *cache,
+            std::make_unique<PostgresCommandExecutor>(*sql, perm_converter));
+
+        shared_model::interface::RolePermissionSet all;
+        all.set();
+        prepare(*factory.constructCreateRole("all", all));
+        prepare(*factory.constructCreateRole(
+            "domain",
+            {Role::kAddDomainAssetQty,
+             Role::kSubtractDomainAssetQty,
+             Role::kReceive}));
+        prepare(*factory.constructCreateRole("user", {Role::kReceive}));
+        prepare(*factory.constructCreateDomain("domain", "user"));
+        prepare(*factory.constructCreateDomain("other", "user"));
+        prepare(*factory.constructCreateAccount("admin", "domain", pubkey));
+        prepare(*factory.constructCreateAccount("alice", "domain", pubkey));
+        prepare(*factory.constructCreateAccount("bob", "other", pubkey));
+        prepare(*factory.constructAppendRole(admin, "all"));
+        prepare(*factory.constructAppendRole(alice, "domain"));
+        prepare(*factory.constructCreateAsset("coin", "domain", 2));
+        prepare(*factory.constructCreateAsset("coin", "other", 2));
+        prepare(*factory.constructAddAssetQuantity(coin, amount("10.00")));
+      }
+
+      void TearDown() override {
+        sql->close();
+        AmetsuchiTest::TearDown();
+      }
+
+      /**
+       * Execute a command without validation with the postgres executor
+       */
+      template <typename CommandType>
+      void prepare(const CommandType &command) {
+        postgres_executor->doValidation(false);
+        postgres_executor->setCreatorAccountId(admin);
+        ASSERT_TRUE(val((*postgres_executor)(command)));
+      }
+
+      /**
+       * @return all balances of the world state as a string
+       */
+      std::string balances() {
+        std::string result;
+        *sql << "SELECT COALESCE(string_agg(account_id || ' ' || asset_id "
+                "|| ' ' || amount, '; ' ORDER BY account_id, asset_id), '') "
+                "FROM account_has_asset",
+            soci::into(result);
+        return result;
+      }
+
+      /**
+       * Execute the command with both executors and check that the results
+       * and the balances are the same. State of the cached execution is kept
+       * @return result of the cached executor
+       */
+      template <typename CommandType>
+      CommandResult execute(const CommandType &command,
+                            const std::string &creator) {
+        *sql << "SAVEPOINT compare";
+        postgres_executor->doValidation(true);
+        postgres_executor->setCreatorAccountId(creator);
+        auto expected = (*postgres_executor)(command);
+        auto expected_balances = balances();
+        *sql << "ROLLBACK TO SAVEPOINT compare";
+
+        cache->clear();
+        cached_executor->doValidation(true);
+        cached_executor->setCreatorAccountId(creator);
+        auto result = (*cached_executor)(command);
+        cache->flush();
+        *sql << "RELEASE SAVEPOINT compare";
+
+        EXPECT_EQ(expected_balances, balances());
+        auto expected_error = err(expected);
+        auto error = err(result);
+        EXPECT_EQ(static_cast<bool>(expected_error), static_cast<bool>(error));
+        if (expected_error and error) {
+          EXPECT_EQ(expected_error->error.command_name,
+                    error->error.command_name);
+          EXPECT_EQ(expected_error->error.error_code, error->error.error_code);
+          EXPECT_EQ(expected_error->error.error_extra,
+                    error->error.error_extra);
+        }
+        return result;
+      }
+
+      static shared_model::interface::Amount amount(const std::string &str) {
+        return shared_model::interface::Amount(str);
+      }
+
+      /**
+       * @return error code of the result, 0 on success
+       */
+      static CommandError::ErrorCodeType code(const CommandResult &result) {
+        auto error = err(result);
+        return error ? error->error.error_code : 0;
+      }
+
+      const std::string admin = "admin@domain";
+      const std::string alice = "alice@domain";
+      const std::string bob = "bob@other";
+      const std::string coin = "coin#domain";
+      const std::string other_coin = "coin#other";
+      const shared_model::interface::types::PubkeyType pubkey{
+          std::string(32, '1')};
+
+      std::unique_ptr<soci::session> sql;
+      std::unique_ptr<CommandExecutor> postgres_executor;
+      std::unique_ptr<WsvCache> cache;
+      std::unique_ptr<CommandExecutor> cached_executor;
+      std::shared_ptr<shared_model::interface::PermissionToString>
+          perm_converter =
+              std::make_shared<shared_model::proto::ProtoPermissionToString>();
+      shared_model::interface::MockCommandFactory factory;
+    };
+
+    /**
+     * @given accounts with global and domain permissions
+     * @when asset quantity is added by them to assets of various domains
+     * and precisions
+     * @then results and balances are the same as of the postgres executor
+     */
+    TEST_F(CachedCommandExecutorTest, AddAssetQuantity) {
+      EXPECT_EQ(0,
+                code(execute(
+                    *factory.constructAddAssetQuantity(coin, amount("1.5")),
+                    admin)));
+      EXPECT_EQ(0,
+                code(execute(
+                    *factory.constructAddAssetQuantity(coin, amount("1.25")),
+                    alice)));
+      EXPECT_EQ(2,
+                code(execute(*factory.constructAddAssetQuantity(
+                                 other_coin, amount("1.25")),
+                             alice)));
+      EXPECT_EQ(2,
+                code(execute(
+                    *factory.constructAddAssetQuantity(coin, amount("1")),
+                    bob)));
+      EXPECT_EQ(3,
+                code(execute(*factory.constructAddAssetQuantity(
+                                 "none#domain", amount("1")),
+                             admin)));
+      EXPECT_EQ(3,
+                code(execute(
+                    *factory.constructAddAssetQuantity(coin, amount("1.125")),
+                    admin)));
+    }
+
+    /**
+     * @given an account with a balance close to the maximum
+     * @when more is added to it
+     * @then the overflow is reported the same way as by the postgres executor
+     */
+    TEST_F(CachedCommandExecutorTest, AddAssetQuantityOverflow) {
+      const shared_model::interface::Amount halfmax{
+          "5789604461865809771178549250434395392663499233282028201972879200"
+          "3956564819968"};  // 2**255
+      EXPECT_EQ(
+          0,
+          code(execute(*factory.constructAddAssetQuantity(coin, halfmax),
+                       admin)));
+      EXPECT_EQ(
+          4,
+          code(execute(*factory.constructAddAssetQuantity(coin, halfmax),
+                       admin)));
+    }
+
+    /**
+     * @given an account with a balance
+     * @when asset quantity is subtracted from it and other accounts
+     * @then results and balances are the same as of the postgres executor
+     */
+    TEST_F(CachedCommandExecutorTest, SubtractAssetQuantity) {
+      EXPECT_EQ(0,
+                code(execute(*factory.constructSubtractAssetQuantity(
+                                 coin, amount("2.5")),
+                             admin)));
+      EXPECT_EQ(4,
+                code(execute(*factory.constructSubtractAssetQuantity(
+                                 coin, amount("100")),
+                             admin)));
+      EXPECT_EQ(4,
+                code(execute(*factory.constructSubtractAssetQuantity(
+                                 coin, amount("1")),
+                             alice)));
+      EXPECT_EQ(2,
+                code(execute(*factory.constructSubtractAssetQuantity(
+                                 coin, amount("1")),
+                             bob)));
+      EXPECT_EQ(3,
+                code(execute(*factory.constructSubtractAssetQuantity(
+                                 "none#domain", amount("1")),
+                             admin)));
+    }
+
+    /**
+     * @given accounts with and without receive permission
+     * @when assets are transferred between them
+     * @then results and balances are the same as of the postgres executor
+     */
+    TEST_F(CachedCommandExecutorTest, TransferAsset) {
+      EXPECT_EQ(
+          0,
+          code(execute(*factory.constructTransferAsset(
+                           admin, alice, coin, "", amount("2.5")),
+                       admin)));
+      EXPECT_EQ(
+          6,
+          code(execute(*factory.constructTransferAsset(
+                           admin, alice, coin, "", amount("20")),
+                       admin)));
+      // the missing account has no receive permission
+      EXPECT_EQ(
+          2,
+          code(execute(*factory.constructTransferAsset(
+                           admin, "none@domain", coin, "", amount("1")),
+                       admin)));
+      EXPECT_EQ(
+          5,
+          code(execute(*factory.constructTransferAsset(
+                           admin, alice, "none#domain", "", amount("1")),
+                       admin)));
+      EXPECT_EQ(
+          5,
+          code(execute(*factory.constructTransferAsset(
+                           admin, alice, coin, "", amount("1.125")),
+                       admin)));
+      // alice has no transfer permission
+      EXPECT_EQ(
+          2,
+          code(execute(*factory.constructTransferAsset(
+                           alice, admin, coin, "", amount("1")),
+                       alice)));
+      // transfer to the same account is delegated
+      EXPECT_EQ(
+          0,
+          code(execute(*factory.constructTransferAsset(
+                           admin, admin, coin, "", amount("1")),
+                       admin)));
+    }
+
+    /**
+     * @given an account which granted transfer of its assets to another one
+     * @when the permittee transfers the assets of the account
+     * @then results and balances are the same as of the postgres executor
+     */
+    TEST_F(CachedCommandExecutorTest, TransferAssetWithGrantablePermission) {
+      EXPECT_EQ(
+          2,
+          code(execute(*factory.constructTransferAsset(
+                           admin, alice, coin, "", amount("1")),
+                       alice)));
+      EXPECT_EQ(0,
+                code(execute(*factory.constructGrantPermission(
+                                 alice, Grantable::kTransferMyAssets),
+                             admin)));
+      EXPECT_EQ(
+          0,
+          code(execute(*factory.constructTransferAsset(
+                           admin, alice, coin, "", amount("1")),
+                       alice)));
+    }
+
+    /**
+     * @given balances changed in the cache
+     * @when a command which is not executed in memory follows them
+     * @then it sees the changed balances
+     */
+    TEST_F(CachedCommandExecutorTest, DelegatedCommandSeesCachedChanges) {
+      cached_executor->doValidation(true);
+      cached_executor->setCreatorAccountId(admin);
+      ASSERT_TRUE(val((*cached_executor)(
+          *factory.constructSubtractAssetQuantity(coin, amount("9")))));
+      EXPECT_EQ(1, cache->changes());
+
+      // the balance of 1.00 is not enough for a transfer of 2 in postgres
+      auto result = (*cached_executor)(*factory.constructTransferAsset(
+          admin, admin, coin, "", amount("2")));
+      EXPECT_EQ(6, code(result));
+      EXPECT_EQ(0, cache->changes());
+      EXPECT_EQ("admin@domain coin#domain 1.00", balances());
+    }
+
+    /**
+     * @given balances changed in the cache after a checkpoint
+     * @when the cache is rolled back to the checkpoint and flushed
+     * @then only the changes made before the checkpoint are written
+     */
+    TEST_F(CachedCommandExecutorTest, RollbackToCheckpoint) {
+      cached_executor->doValidation(true);
+      cached_executor->setCreatorAccountId(admin);
+      ASSERT_TRUE(val((*cached_executor)(*factory.constructTransferAsset(
+          admin, alice, coin, "", amount("1")))));
+      auto checkpoint = cache->checkpoint();
+      ASSERT_TRUE(val((*cached_executor)(*factory.constructTransferAsset(
+          admin, alice, coin, "", amount("2")))));
+
+      cache->rollback(checkpoint);
+      cache->flush();
+
+      EXPECT_EQ("admin@domain coin#domain 9.00; alice@domain coin#domain 1",
+                balances());
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
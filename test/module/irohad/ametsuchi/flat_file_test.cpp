@@ -5,6 +5,7 @@
 
 #include "ametsuchi/impl/flat_file/flat_file.hpp"
 #include <gtest/gtest.h>
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include "common/byteutils.hpp"
@@ -119,6 +120,24 @@ TEST_F(BlStore_Test, BlockStoreInitializationFromNonemptyFolder) {
   ASSERT_EQ(bl_store1->last_id(), bl_store2->last_id());
 }
 
+/**
+ * @given folder with a segmented log
+ * @when flat file block storage is initialized
+ * @then initialization fails and the segments are kept
+ */
+TEST_F(BlStore_Test, SegmentedLogFolder) {
+  auto log = SegmentedLog::create(block_store_path);
+  ASSERT_TRUE(log);
+  ASSERT_TRUE((*log)->add(1u, block));
+  log->reset();
+
+  ASSERT_FALSE(FlatFile::create(block_store_path));
+
+  auto reopened = SegmentedLog::create(block_store_path);
+  ASSERT_TRUE(reopened);
+  ASSERT_EQ((*reopened)->last_id(), 1u);
+}
+
 /**
  * @given empty folder name
  * @then check consistency fails
@@ -216,3 +235,23 @@ TEST_F(BlStore_Test, WriteDeniedFolder) {
   auto res = bl_store->add(id, block);
   ASSERT_FALSE(res);
 }
+
+/**
+ * @given block store with an entry
+ * @when the entry is read through a view and then removed from the disk
+ * @then the view has the entry content and stays readable after removal
+ */
+TEST_F(BlStore_Test, GetView) {
+  auto store = FlatFile::create(block_store_path);
+  ASSERT_TRUE(store);
+  auto bl_store = std::move(*store);
+  auto id = 1u;
+  bl_store->add(id, block);
+
+  auto view = bl_store->getView(id);
+  ASSERT_TRUE(view);
+  fs::remove(fs::path(block_store_path) / FlatFile::id_to_name(id));
+
+  ASSERT_EQ(std::vector<uint8_t>(view->data, view->data + view->size), block);
+  ASSERT_FALSE(bl_store->getView(id));
+}
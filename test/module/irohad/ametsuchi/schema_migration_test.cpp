@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/postgres_schema_migration.hpp"
+
+#include <gtest/gtest.h>
+#include "framework/result_fixture.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
+
+using namespace iroha::ametsuchi;
+using namespace framework::expected;
+
+class SchemaMigrationTest : public AmetsuchiTest {
+ protected:
+  /**
+   * Replace block index tables with the ones of the schema before versioning
+   */
+  void createLegacySchema() {
+    *sql << R"(
+DROP TABLE IF EXISTS position_by_hash;
+DROP TABLE IF EXISTS tx_status_by_hash;
+DROP TABLE IF EXISTS height_by_account_set;
+DROP TABLE IF EXISTS index_by_creator_height;
+DROP TABLE IF EXISTS position_by_account_asset;
+DROP TABLE IF EXISTS height_by_block_hash;
+DROP TABLE IF EXISTS schema_version;
+CREATE TABLE position_by_hash (hash varchar, height text, index text);
+CREATE TABLE tx_status_by_hash (hash varchar, status boolean);
+CREATE TABLE height_by_account_set (account_id text, height text);
+CREATE TABLE index_by_creator_height (
+    id serial, creator_id text, height text, index text);
+CREATE TABLE position_by_account_asset (
+    account_id text, asset_id text, height text, index text);
+)";
+  }
+
+  const std::string hash = std::string(64, 'a');
+};
+
+/**
+ * @given database with legacy block index tables filled with data
+ * @when schema is migrated
+ * @then version is updated, data is converted to typed columns and is ordered
+ * numerically
+ */
+TEST_F(SchemaMigrationTest, MigratesLegacySchema) {
+  createLegacySchema();
+  *sql << "INSERT INTO position_by_hash VALUES (:hash, '10', '0')",
+      soci::use(hash);
+  *sql << "INSERT INTO position_by_hash VALUES ('bb', '9', '1')";
+  *sql << "INSERT INTO tx_status_by_hash VALUES (:hash, TRUE)",
+      soci::use(hash);
+  *sql << "INSERT INTO index_by_creator_height(creator_id, height, index) "
+          "VALUES ('user@test', '10', '0')";
+  ASSERT_EQ(getSchemaVersion(*sql), 1);
+
+  ASSERT_TRUE(val(migrateSchema(*sql)));
+  ASSERT_EQ(getSchemaVersion(*sql), kSchemaVersion);
+
+  long long height = 0, index = 0;
+  *sql << "SELECT height, index FROM position_by_hash "
+          "WHERE hash = decode(:hash, 'hex')",
+      soci::into(height), soci::into(index), soci::use(hash);
+  ASSERT_EQ(height, 10);
+  ASSERT_EQ(index, 0);
+
+  *sql << "SELECT height FROM position_by_hash ORDER BY height LIMIT 1",
+      soci::into(height);
+  ASSERT_EQ(height, 9);
+
+  int status = 0;
+  *sql << "SELECT status FROM tx_status_by_hash "
+          "WHERE hash = decode(:hash, 'hex')",
+      soci::into(status), soci::use(hash);
+  ASSERT_EQ(status, 1);
+
+  // migration of the current schema does nothing
+  ASSERT_TRUE(val(migrateSchema(*sql)));
+  ASSERT_EQ(getSchemaVersion(*sql), kSchemaVersion);
+}
+
+/**
+ * @given database with schema of a newer version
+ * @when schema is migrated
+ * @then migration fails
+ */
+TEST_F(SchemaMigrationTest, RejectsNewerSchema) {
+  ASSERT_EQ(getSchemaVersion(*sql), kSchemaVersion);
+  *sql << "UPDATE schema_version SET version = version + 1";
+
+  ASSERT_TRUE(err(migrateSchema(*sql)));
+
+  *sql << "UPDATE schema_version SET version = version - 1";
+}
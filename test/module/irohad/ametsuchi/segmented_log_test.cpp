@@ -0,0 +1,243 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/segmented_log/segmented_log.hpp"
+
+#include <gtest/gtest.h>
+#include "ametsuchi/impl/flat_file/flat_file.hpp"
+#include <boost/filesystem.hpp>
+
+using namespace iroha::ametsuchi;
+namespace fs = boost::filesystem;
+
+class SegmentedLogTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    fs::create_directory(block_store_path);
+    // three records fit into one segment
+    options.segment_size = 3 * (block.size() + SegmentedLog::kRecordHeaderSize);
+  }
+
+  void TearDown() override {
+    fs::remove_all(block_store_path);
+  }
+
+  std::unique_ptr<SegmentedLog> createLog() {
+    auto log = SegmentedLog::create(block_store_path, options);
+    return log ? std::move(*log) : nullptr;
+  }
+
+  /**
+   * @return blob which differs for each id
+   */
+  SegmentedLog::Bytes makeBlock(SegmentedLog::Identifier id) {
+    auto result = block;
+    result[0] = static_cast<uint8_t>(id);
+    return result;
+  }
+
+  static SegmentedLog::Bytes toBytes(const SegmentedLog::BytesView &view) {
+    return SegmentedLog::Bytes(view.data, view.data + view.size);
+  }
+
+  std::string block_store_path =
+      (fs::temp_directory_path() / fs::unique_path()).string();
+  SegmentedLog::Bytes block = SegmentedLog::Bytes(1000, 5);
+  SegmentedLog::Options options;
+};
+
+/**
+ * @given empty segmented log
+ * @when entries are added
+ * @then the same entries are returned by get and last_id is updated
+ */
+TEST_F(SegmentedLogTest, ReadWrite) {
+  auto log = createLog();
+  ASSERT_TRUE(log);
+
+  ASSERT_TRUE(log->add(1, makeBlock(1)));
+  ASSERT_TRUE(log->add(2, makeBlock(2)));
+
+  ASSERT_EQ(log->last_id(), 2);
+  ASSERT_EQ(*log->get(1), makeBlock(1));
+  ASSERT_EQ(*log->get(2), makeBlock(2));
+  ASSERT_FALSE(log->get(0));
+  ASSERT_FALSE(log->get(3));
+  ASSERT_EQ(log->directory(), block_store_path);
+}
+
+/**
+ * @given segmented log with one entry
+ * @when entry with non-consecutive key is added
+ * @then add fails
+ */
+TEST_F(SegmentedLogTest, NonConsecutiveAdd) {
+  auto log = createLog();
+  ASSERT_TRUE(log);
+
+  ASSERT_TRUE(log->add(1, makeBlock(1)));
+  ASSERT_FALSE(log->add(3, makeBlock(3)));
+  ASSERT_FALSE(log->add(1, makeBlock(1)));
+  ASSERT_EQ(log->last_id(), 1);
+}
+
+/**
+ * @given segmented log with small segment size
+ * @when more entries than a segment can hold are added
+ * @then new segments are started and all entries are readable after restart
+ */
+TEST_F(SegmentedLogTest, SegmentsRollOverAndReopen) {
+  {
+    auto log = createLog();
+    ASSERT_TRUE(log);
+    for (SegmentedLog::Identifier id = 1; id <= 7; ++id) {
+      ASSERT_TRUE(log->add(id, makeBlock(id)));
+    }
+    ASSERT_EQ(log->segmentsCount(), 3);
+  }
+
+  auto log = createLog();
+  ASSERT_TRUE(log);
+  ASSERT_EQ(log->last_id(), 7);
+  ASSERT_EQ(log->segmentsCount(), 3);
+  for (SegmentedLog::Identifier id = 1; id <= 7; ++id) {
+    ASSERT_EQ(*log->get(id), makeBlock(id));
+  }
+  ASSERT_TRUE(log->add(8, makeBlock(8)));
+  ASSERT_EQ(*log->get(8), makeBlock(8));
+}
+
+/**
+ * @given segmented log whose last record was partially written
+ * @when the log is reopened
+ * @then the torn record is cut off and appending continues after the last
+ * complete one
+ */
+TEST_F(SegmentedLogTest, RecoverTornTail) {
+  fs::path last_segment;
+  {
+    auto log = createLog();
+    ASSERT_TRUE(log);
+    for (SegmentedLog::Identifier id = 1; id <= 5; ++id) {
+      ASSERT_TRUE(log->add(id, makeBlock(id)));
+    }
+  }
+  last_segment = fs::path(block_store_path) / "0000000000000004.seg";
+  ASSERT_TRUE(fs::exists(last_segment));
+  fs::resize_file(last_segment, fs::file_size(last_segment) - 10);
+
+  auto log = createLog();
+  ASSERT_TRUE(log);
+  ASSERT_EQ(log->last_id(), 4);
+  ASSERT_EQ(*log->get(4), makeBlock(4));
+  ASSERT_TRUE(log->add(5, makeBlock(5)));
+  ASSERT_EQ(*log->get(5), makeBlock(5));
+}
+
+/**
+ * @given segmented log whose last record payload is corrupted
+ * @when the log is reopened
+ * @then the corrupted record is dropped
+ */
+TEST_F(SegmentedLogTest, RecoverCorruptedTail) {
+  {
+    auto log = createLog();
+    ASSERT_TRUE(log);
+    ASSERT_TRUE(log->add(1, makeBlock(1)));
+    ASSERT_TRUE(log->add(2, makeBlock(2)));
+  }
+  auto segment = fs::path(block_store_path) / "0000000000000001.seg";
+  {
+    fs::fstream file(segment, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put(0);
+  }
+
+  auto log = createLog();
+  ASSERT_TRUE(log);
+  ASSERT_EQ(log->last_id(), 1);
+  ASSERT_EQ(*log->get(1), makeBlock(1));
+}
+
+/**
+ * @given segmented log with several segments
+ * @when dropAll is called
+ * @then the log is empty and can be filled from the first key again
+ */
+TEST_F(SegmentedLogTest, DropAll) {
+  auto log = createLog();
+  ASSERT_TRUE(log);
+  for (SegmentedLog::Identifier id = 1; id <= 4; ++id) {
+    ASSERT_TRUE(log->add(id, makeBlock(id)));
+  }
+
+  log->dropAll();
+
+  ASSERT_EQ(log->last_id(), 0);
+  ASSERT_FALSE(log->get(1));
+  ASSERT_TRUE(fs::is_empty(block_store_path));
+  ASSERT_TRUE(log->add(1, makeBlock(1)));
+  ASSERT_EQ(*log->get(1), makeBlock(1));
+}
+
+/**
+ * @given segmented log with entries in several segments
+ * @when entries are read through views while more entries are appended and
+ * the log is dropped afterwards
+ * @then views have the entries content and stay valid after all of that
+ */
+TEST_F(SegmentedLogTest, GetView) {
+  auto log = createLog();
+  ASSERT_TRUE(log);
+  ASSERT_TRUE(log->add(1, makeBlock(1)));
+
+  // view of the growing last segment
+  auto first = log->getView(1);
+  ASSERT_TRUE(first);
+  for (SegmentedLog::Identifier id = 2; id <= 7; ++id) {
+    ASSERT_TRUE(log->add(id, makeBlock(id)));
+  }
+
+  std::vector<SegmentedLog::BytesView> views;
+  for (SegmentedLog::Identifier id = 1; id <= 7; ++id) {
+    auto view = log->getView(id);
+    ASSERT_TRUE(view);
+    ASSERT_EQ(toBytes(*view), makeBlock(id));
+    views.push_back(*view);
+  }
+  ASSERT_FALSE(log->getView(0));
+  ASSERT_FALSE(log->getView(8));
+
+  log->dropAll();
+  log.reset();
+
+  ASSERT_EQ(toBytes(*first), makeBlock(1));
+  for (SegmentedLog::Identifier id = 1; id <= 7; ++id) {
+    ASSERT_EQ(toBytes(views[id - 1]), makeBlock(id));
+  }
+}
+
+/**
+ * @given empty path
+ * @when segmented log is created
+ * @then creation fails
+ */
+TEST_F(SegmentedLogTest, EmptyPath) {
+  ASSERT_FALSE(SegmentedLog::create(""));
+}
+
+/**
+ * @given folder with a flat file block store
+ * @when segmented log is created
+ * @then creation fails and the blocks are kept
+ */
+TEST_F(SegmentedLogTest, FlatFileFolder) {
+  auto store = FlatFile::create(block_store_path);
+  ASSERT_TRUE(store);
+  ASSERT_TRUE((*store)->add(1, makeBlock(1)));
+
+  ASSERT_FALSE(createLog());
+  ASSERT_EQ(*(*store)->get(1), makeBlock(1));
+}
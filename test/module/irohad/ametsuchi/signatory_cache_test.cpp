@@ -0,0 +1,153 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/signatory_cache.hpp"
+
+#include "ametsuchi/impl/postgres_command_executor.hpp"
+#include "backend/protobuf/proto_permission_to_string.hpp"
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "datetime/time.hpp"
+#include "framework/result_fixture.hpp"
+#include "module/irohad/ametsuchi/ametsuchi_fixture.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+namespace iroha {
+  namespace ametsuchi {
+
+    using shared_model::crypto::DefaultCryptoAlgorithmType;
+    using shared_model::crypto::Keypair;
+
+    class SignatoryCacheTest : public AmetsuchiTest {
+     public:
+      void SetUp() override {
+        AmetsuchiTest::SetUp();
+        sql = std::make_unique<soci::session>(soci::postgresql, pgopt_);
+        PostgresCommandExecutor::prepareStatements(*sql);
+        *sql << init_;
+        executor = std::make_unique<PostgresCommandExecutor>(
+            *sql,
+            std::make_shared<shared_model::proto::ProtoPermissionToString>());
+
+        execute(TestTransactionBuilder()
+                    .createRole("user", {})
+                    .createDomain("domain", "user")
+                    .createAccount("user", "domain", first.publicKey())
+                    .build());
+      }
+
+      void TearDown() override {
+        sql->close();
+        AmetsuchiTest::TearDown();
+      }
+
+      /**
+       * Execute commands of the transaction without validation
+       */
+      void execute(const shared_model::interface::Transaction &transaction) {
+        executor->doValidation(false);
+        executor->setCreatorAccountId(account_id);
+        for (const auto &command : transaction.commands()) {
+          ASSERT_TRUE(framework::expected::val(
+              boost::apply_visitor(*executor, command.get())));
+        }
+      }
+
+      /**
+       * @return transaction signed by the keys
+       */
+      static shared_model::proto::Transaction signedBy(
+          std::initializer_list<Keypair> keys) {
+        auto transaction = TestUnsignedTransactionBuilder()
+                               .creatorAccountId(account_id)
+                               .createdTime(iroha::time::now())
+                               .quorum(1)
+                               .setAccountQuorum(account_id, 1)
+                               .build();
+        for (const auto &key : keys) {
+          transaction.signAndAddSignature(key);
+        }
+        return transaction.finish();
+      }
+
+      static const std::string account_id;
+      Keypair first = DefaultCryptoAlgorithmType::generateKeypair();
+      Keypair second = DefaultCryptoAlgorithmType::generateKeypair();
+      Keypair third = DefaultCryptoAlgorithmType::generateKeypair();
+
+      std::unique_ptr<soci::session> sql;
+      std::unique_ptr<CommandExecutor> executor;
+      SignatoryCache cache;
+    };
+
+    const std::string SignatoryCacheTest::account_id = "user@domain";
+
+    /**
+     * @given an account with a signatory
+     * @when its signatories are requested @and signatories of an account
+     * which does not exist
+     * @then quorum and signatories of the first one are returned @and none
+     * for the second one
+     */
+    TEST_F(SignatoryCacheTest, Get) {
+      auto signatories = cache.get(account_id, *sql);
+      ASSERT_TRUE(signatories);
+      EXPECT_EQ(1, (*signatories)->quorum);
+      EXPECT_EQ(std::unordered_set<std::string>{first.publicKey().hex()},
+                (*signatories)->public_keys);
+
+      EXPECT_FALSE(cache.get("none@domain", *sql));
+    }
+
+    /**
+     * @given cached signatories of an account
+     * @when they are changed in the database
+     * @then cached ones are returned until a block with the changes is
+     * committed
+     */
+    TEST_F(SignatoryCacheTest, InvalidatedByBlock) {
+      ASSERT_TRUE(cache.get(account_id, *sql));
+      auto transaction = TestTransactionBuilder()
+                             .creatorAccountId(account_id)
+                             .addSignatory(account_id, second.publicKey())
+                             .setAccountQuorum(account_id, 2)
+                             .build();
+      execute(transaction);
+
+      EXPECT_EQ(1, (*cache.get(account_id, *sql))->quorum);
+
+      cache.invalidate(
+          TestBlockBuilder()
+              .transactions(
+                  std::vector<shared_model::proto::Transaction>{transaction})
+              .build());
+
+      auto signatories = cache.get(account_id, *sql);
+      ASSERT_TRUE(signatories);
+      EXPECT_EQ(2, (*signatories)->quorum);
+      EXPECT_EQ(2, (*signatories)->public_keys.size());
+    }
+
+    /**
+     * @given an account with two signatories and quorum of two
+     * @when signatures of transactions are checked
+     * @then only transactions signed by enough signatories pass
+     */
+    TEST_F(SignatoryCacheTest, IsSignedBy) {
+      SignatoryCache::AccountSignatories signatories{
+          2, {first.publicKey().hex(), second.publicKey().hex()}};
+
+      auto both = signedBy({first, second});
+      auto one = signedBy({first});
+      auto other = signedBy({first, third});
+      EXPECT_TRUE(signatories.isSignedBy(both.signatures()));
+      EXPECT_FALSE(signatories.isSignedBy(one.signatures()));
+      EXPECT_FALSE(signatories.isSignedBy(other.signatures()));
+      EXPECT_TRUE(signatories.hasSignatories(one.signatures()));
+      EXPECT_FALSE(signatories.hasSignatories(other.signatures()));
+    }
+
+  }  // namespace ametsuchi
+}  // namespace iroha
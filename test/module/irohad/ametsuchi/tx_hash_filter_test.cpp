@@ -0,0 +1,67 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ametsuchi/impl/tx_hash_filter.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace iroha::ametsuchi;
+
+class TxHashFilterTest : public ::testing::Test {
+ protected:
+  shared_model::crypto::Hash makeHash(size_t i) {
+    return shared_model::crypto::Hash("tx_hash_" + std::to_string(i));
+  }
+
+  const size_t kItems = 10000;
+};
+
+/**
+ * @given filter sized for the number of hashes
+ * @when the hashes are added
+ * @then all of them are reported as possibly present and counted
+ */
+TEST_F(TxHashFilterTest, NoFalseNegatives) {
+  TxHashFilter filter(kItems);
+  for (size_t i = 0; i < kItems; ++i) {
+    filter.add(makeHash(i));
+  }
+
+  ASSERT_EQ(filter.size(), kItems);
+  for (size_t i = 0; i < kItems; ++i) {
+    ASSERT_TRUE(filter.mayContain(makeHash(i)));
+  }
+}
+
+/**
+ * @given filter filled up to its capacity
+ * @when hashes which were not added are looked up
+ * @then only a small fraction of them is reported as possibly present
+ */
+TEST_F(TxHashFilterTest, FalsePositiveRate) {
+  TxHashFilter filter(kItems);
+  for (size_t i = 0; i < kItems; ++i) {
+    filter.add(makeHash(i));
+  }
+
+  size_t false_positives = 0;
+  for (size_t i = kItems; i < 11 * kItems; ++i) {
+    if (filter.mayContain(makeHash(i))) {
+      ++false_positives;
+    }
+  }
+  ASSERT_LT(false_positives, kItems / 5);
+}
+
+/**
+ * @given empty filter
+ * @when a hash is looked up
+ * @then it is reported as definitely absent
+ */
+TEST_F(TxHashFilterTest, EmptyFilter) {
+  TxHashFilter filter(0);
+  ASSERT_EQ(filter.size(), 0);
+  ASSERT_FALSE(filter.mayContain(makeHash(0)));
+}
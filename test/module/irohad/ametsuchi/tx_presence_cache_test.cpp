@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <future>
+
 #include <gtest/gtest.h>
 
 #include "ametsuchi/impl/tx_presence_cache_impl.hpp"
@@ -104,20 +106,19 @@ TEST_F(TxPresenceCacheTest, MissingThenCommittedHashTest) {
  * @when cache asked for batch status
  * @then cache returns BatchStatusCollectionType with Rejected, Committed and
  * Missing statuses accordingly
+ * @and storage is queried once for all of them
  */
 TEST_F(TxPresenceCacheTest, BatchHashTest) {
   shared_model::crypto::Hash hash1("1");
   shared_model::crypto::Hash hash2("2");
   shared_model::crypto::Hash hash3("3");
-  EXPECT_CALL(*mock_block_query, checkTxPresence(hash1))
-      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
-          tx_cache_status_responses::Rejected(hash1))));
-  EXPECT_CALL(*mock_block_query, checkTxPresence(hash2))
-      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
-          tx_cache_status_responses::Committed(hash2))));
-  EXPECT_CALL(*mock_block_query, checkTxPresence(hash3))
-      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
-          tx_cache_status_responses::Missing(hash3))));
+  EXPECT_CALL(*mock_block_query, checkTxPresence(_)).Times(0);
+  EXPECT_CALL(*mock_block_query,
+              checkTxsPresence(ElementsAre(hash1, hash2, hash3)))
+      .WillOnce(Return(boost::make_optional(std::vector<TxCacheStatusType>{
+          tx_cache_status_responses::Rejected(hash1),
+          tx_cache_status_responses::Committed(hash2),
+          tx_cache_status_responses::Missing(hash3)})));
   auto tx1 = std::make_shared<MockTransaction>();
   EXPECT_CALL(*tx1, hash()).WillOnce(ReturnRefOfCopy(hash1));
   auto tx2 = std::make_shared<MockTransaction>();
@@ -165,3 +166,161 @@ TEST_F(TxPresenceCacheTest, BatchHashTest) {
         FAIL() << error.error;
       });
 }
+
+/**
+ * @given cache which has already got a committed status of a hash
+ * @when cache is asked for statuses of the hash and of two other hashes
+ * @then only the other hashes are queried from storage, at once
+ * @and statuses are returned in the order of the hashes
+ */
+TEST_F(TxPresenceCacheTest, BulkCheckQueriesUnknownHashes) {
+  shared_model::crypto::Hash hash1("1");
+  shared_model::crypto::Hash hash2("2");
+  shared_model::crypto::Hash hash3("3");
+  EXPECT_CALL(*mock_block_query, checkTxPresence(hash2))
+      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
+          tx_cache_status_responses::Committed(hash2))));
+  EXPECT_CALL(*mock_block_query, checkTxsPresence(ElementsAre(hash1, hash3)))
+      .WillOnce(Return(boost::make_optional(std::vector<TxCacheStatusType>{
+          tx_cache_status_responses::Missing(hash1),
+          tx_cache_status_responses::Rejected(hash3)})));
+  TxPresenceCacheImpl cache(mock_storage);
+  cache.check(hash2);
+
+  auto statuses = cache.check(std::vector<shared_model::crypto::Hash>{
+      hash1, hash2, hash3});
+  ASSERT_TRUE(statuses);
+  ASSERT_EQ(3, statuses->size());
+  ASSERT_NO_THROW(
+      boost::get<tx_cache_status_responses::Missing>(statuses->at(0)));
+  ASSERT_NO_THROW(
+      boost::get<tx_cache_status_responses::Committed>(statuses->at(1)));
+  ASSERT_NO_THROW(
+      boost::get<tx_cache_status_responses::Rejected>(statuses->at(2)));
+}
+
+/**
+ * @given cache
+ * @when storage fails to answer a bulk query
+ * @then cache reports a failure for the whole request
+ */
+TEST_F(TxPresenceCacheTest, BulkCheckStorageFailure) {
+  shared_model::crypto::Hash hash1("1");
+  shared_model::crypto::Hash hash2("2");
+  EXPECT_CALL(*mock_block_query, checkTxsPresence(_))
+      .WillOnce(Return(boost::none));
+  TxPresenceCacheImpl cache(mock_storage);
+
+  ASSERT_FALSE(
+      cache.check(std::vector<shared_model::crypto::Hash>{hash1, hash2}));
+}
+
+/**
+ * @given cache with a filter loaded from storage which has a single hash
+ * @when cache is asked for a hash which is not in storage
+ * @then cache returns Missing status without a storage query
+ * @and a hash from storage is checked in storage
+ */
+TEST_F(TxPresenceCacheTest, FilterAnswersMissing) {
+  shared_model::crypto::Hash stored_hash("1");
+  shared_model::crypto::Hash new_hash("2");
+  EXPECT_CALL(*mock_block_query, forEachTxHash(_))
+      .WillOnce(Invoke([&stored_hash](const auto &visitor) {
+        visitor(stored_hash);
+        return boost::make_optional<size_t>(1);
+      }));
+  EXPECT_CALL(*mock_block_query, checkTxPresence(new_hash)).Times(0);
+  EXPECT_CALL(*mock_block_query, checkTxPresence(stored_hash))
+      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
+          tx_cache_status_responses::Committed(stored_hash))));
+  TxPresenceCacheImpl cache(mock_storage, true);
+
+  ASSERT_NO_THROW(
+      boost::get<tx_cache_status_responses::Missing>(*cache.check(new_hash)));
+  ASSERT_NO_THROW(boost::get<tx_cache_status_responses::Committed>(
+      *cache.check(stored_hash)));
+}
+
+/**
+ * Make a block with no transactions and given rejected hashes
+ */
+std::shared_ptr<MockBlock> makeRejectedBlock(
+    shared_model::interface::types::HeightType height,
+    std::vector<shared_model::crypto::Hash> rejected) {
+  static std::vector<MockTransaction> transactions;
+  auto block = std::make_shared<MockBlock>();
+  EXPECT_CALL(*block, height()).WillRepeatedly(Return(height));
+  EXPECT_CALL(*block, transactions())
+      .WillRepeatedly(Return(
+          shared_model::interface::types::TransactionsCollectionType(
+              transactions)));
+  EXPECT_CALL(*block, rejected_transactions_hashes())
+      .WillRepeatedly(Invoke([rejected] {
+        return shared_model::interface::types::HashCollectionType(rejected);
+      }));
+  return block;
+}
+
+/**
+ * @given cache with a filter loaded from empty storage
+ * @when a block with a rejected transaction is about to be committed
+ * @then hash of the transaction is checked in storage
+ */
+TEST_F(TxPresenceCacheTest, FilterUpdatedBeforeCommit) {
+  shared_model::crypto::Hash rejected_hash("1");
+  EXPECT_CALL(*mock_block_query, forEachTxHash(_))
+      .WillOnce(Return(boost::make_optional<size_t>(0)));
+  EXPECT_CALL(*mock_block_query, checkTxPresence(rejected_hash))
+      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
+          tx_cache_status_responses::Rejected(rejected_hash))));
+  TxPresenceCacheImpl cache(mock_storage, true);
+
+  mock_storage->pre_commit_notifier.get_subscriber().on_next(
+      makeRejectedBlock(1, {rejected_hash}));
+
+  ASSERT_NO_THROW(boost::get<tx_cache_status_responses::Rejected>(
+      *cache.check(rejected_hash)));
+}
+
+/**
+ * @given cache with a full filter
+ * @when a block is about to be committed
+ * @then the notification is not held while the filter is rebuilt
+ * @and hashes of the block are checked in storage during the rebuild and
+ * after it
+ */
+TEST_F(TxPresenceCacheTest, FilterRebuiltInBackground) {
+  shared_model::crypto::Hash stored_hash("1");
+  shared_model::crypto::Hash first_hash("2");
+  shared_model::crypto::Hash second_hash("3");
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  auto visit_stored = [&stored_hash](const auto &visitor) {
+    visitor(stored_hash);
+    return boost::make_optional<size_t>(1);
+  };
+  EXPECT_CALL(*mock_block_query, forEachTxHash(_))
+      .WillOnce(Invoke(visit_stored))
+      .WillOnce(Invoke([&](const auto &visitor) {
+        EXPECT_EQ(std::future_status::ready,
+                  released.wait_for(std::chrono::seconds(5)));
+        return visit_stored(visitor);
+      }));
+  EXPECT_CALL(*mock_block_query, checkTxPresence(first_hash))
+      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
+          tx_cache_status_responses::Rejected(first_hash))));
+  EXPECT_CALL(*mock_block_query, checkTxPresence(second_hash))
+      .WillOnce(Return(boost::make_optional<TxCacheStatusType>(
+          tx_cache_status_responses::Rejected(second_hash))));
+  // the filter is full with the single stored hash
+  TxPresenceCacheImpl cache(mock_storage, true, 1);
+
+  mock_storage->pre_commit_notifier.get_subscriber().on_next(
+      makeRejectedBlock(1, {first_hash, second_hash}));
+  ASSERT_NO_THROW(boost::get<tx_cache_status_responses::Rejected>(
+      *cache.check(first_hash)));
+  release.set_value();
+
+  ASSERT_NO_THROW(boost::get<tx_cache_status_responses::Rejected>(
+      *cache.check(second_hash)));
+}
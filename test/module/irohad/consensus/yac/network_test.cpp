@@ -11,6 +11,7 @@
 
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::InvokeWithoutArgs;
 using ::testing::SaveArg;
 
@@ -90,6 +91,41 @@ namespace iroha {
         ASSERT_EQ(1, state.size());
         ASSERT_EQ(message, state.front());
       }
+
+      /**
+       * @given initialized network
+       * @when the same votes are broadcasted to several recipients, which are
+       * the network itself
+       * @then votes are handled once per recipient
+       */
+      TEST_F(YacNetworkTest, MessageHandledWhenMessageBroadcasted) {
+        constexpr size_t kRecipients = 3;
+        size_t processed = 0;
+
+        std::vector<std::vector<VoteMessage>> states;
+        EXPECT_CALL(*notifications, onState(_))
+            .Times(kRecipients)
+            .WillRepeatedly(Invoke([&](std::vector<VoteMessage> state) {
+              std::lock_guard<std::mutex> lock(mtx);
+              states.push_back(std::move(state));
+              ++processed;
+              cv.notify_all();
+            }));
+
+        network->broadcastState(
+            std::vector<std::shared_ptr<shared_model::interface::Peer>>(
+                kRecipients, peer),
+            {message});
+
+        // wait for response reader thread
+        std::unique_lock<std::mutex> lk(mtx);
+        cv.wait(lk, [&] { return processed == kRecipients; });
+
+        for (const auto &state : states) {
+          ASSERT_EQ(1, state.size());
+          ASSERT_EQ(message, state.front());
+        }
+      }
     }  // namespace yac
   }    // namespace consensus
 }  // namespace iroha
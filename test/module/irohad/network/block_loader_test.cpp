@@ -35,6 +35,7 @@ using testing::Return;
 
 using wPeer = std::shared_ptr<shared_model::interface::Peer>;
 using wBlock = std::shared_ptr<shared_model::interface::Block>;
+using shared_model::interface::types::HeightType;
 
 class BlockLoaderTest : public testing::Test {
  public:
@@ -156,11 +157,11 @@ TEST_F(BlockLoaderTest, ValidWhenSameTopBlock) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(block.height() + 1))
-      .WillOnce(Return(std::vector<wBlock>()));
+  EXPECT_CALL(*storage, getTopBlockHeight()).WillOnce(Return(block.height()));
+  EXPECT_CALL(*storage, getBlocks(_, _)).Times(0);
 
   auto wrapper = make_test_subscriber<CallExact>(
-      loader->retrieveBlocks(1, peer->pubkey()), 0);
+      loader->retrieveBlocks(1, peer->pubkey(), 0), 0);
   wrapper.subscribe();
 
   ASSERT_TRUE(wrapper.validate());
@@ -190,10 +191,12 @@ TEST_F(BlockLoaderTest, ValidWhenOneBlock) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(block.height() + 1))
+  EXPECT_CALL(*storage, getTopBlockHeight())
+      .WillOnce(Return(top_block.height()));
+  EXPECT_CALL(*storage, getBlocks(block.height() + 1, 1))
       .WillOnce(Return(std::vector<wBlock>{clone(top_block)}));
   auto wrapper =
-      make_test_subscriber<CallExact>(loader->retrieveBlocks(1, peer_key), 1);
+      make_test_subscriber<CallExact>(loader->retrieveBlocks(1, peer_key, 0), 1);
   wrapper.subscribe(
       [&top_block](auto block) { ASSERT_EQ(*block.operator->(), top_block); });
 
@@ -230,9 +233,84 @@ TEST_F(BlockLoaderTest, ValidWhenMultipleBlocks) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(next_height)).WillOnce(Return(blocks));
+  EXPECT_CALL(*storage, getTopBlockHeight())
+      .WillOnce(Return(next_height + num_blocks - 1));
+  EXPECT_CALL(*storage, getBlocks(next_height, num_blocks))
+      .WillOnce(Return(blocks));
   auto wrapper = make_test_subscriber<CallExact>(
-      loader->retrieveBlocks(1, peer_key), num_blocks);
+      loader->retrieveBlocks(1, peer_key, 0), num_blocks);
+  auto height = next_height;
+  wrapper.subscribe(
+      [&height](auto block) { ASSERT_EQ(block->height(), height++); });
+
+  ASSERT_TRUE(wrapper.validate());
+}
+
+/**
+ * @given block loader and more blocks than the service reads at once
+ * @when retrieveBlocks is called
+ * @then blocks are read from storage in chunks @and all of them are returned
+ * in order
+ */
+TEST_F(BlockLoaderTest, ValidWhenBlocksAreReadInChunks) {
+  const HeightType next_height = 2;
+  const HeightType num_blocks = BlockLoaderService::kBlocksPerRead + 1;
+
+  std::vector<wBlock> blocks;
+  for (auto i = next_height; i < next_height + num_blocks; ++i) {
+    auto blk = getBaseBlockBuilder()
+                   .height(i)
+                   .build()
+                   .signAndAddSignature(key)
+                   .finish();
+    blocks.emplace_back(clone(blk));
+  }
+  auto first_chunk_end = blocks.begin() + BlockLoaderService::kBlocksPerRead;
+
+  EXPECT_CALL(*peer_query, getLedgerPeers())
+      .WillOnce(Return(std::vector<wPeer>{peer}));
+  EXPECT_CALL(*storage, getTopBlockHeight())
+      .WillOnce(Return(next_height + num_blocks - 1));
+  EXPECT_CALL(*storage,
+              getBlocks(next_height, BlockLoaderService::kBlocksPerRead))
+      .WillOnce(Return(std::vector<wBlock>(blocks.begin(), first_chunk_end)));
+  EXPECT_CALL(*storage,
+              getBlocks(next_height + BlockLoaderService::kBlocksPerRead, 1))
+      .WillOnce(Return(std::vector<wBlock>(first_chunk_end, blocks.end())));
+  auto wrapper = make_test_subscriber<CallExact>(
+      loader->retrieveBlocks(1, peer_key, 0), num_blocks);
+  auto height = next_height;
+  wrapper.subscribe(
+      [&height](auto block) { ASSERT_EQ(block->height(), height++); });
+
+  ASSERT_TRUE(wrapper.validate());
+}
+
+/**
+ * @given block loader and a peer with more blocks than requested
+ * @when retrieveBlocks is called with a count of blocks
+ * @then only the requested number of blocks is read from storage and returned
+ */
+TEST_F(BlockLoaderTest, ValidWhenCountIsLimited) {
+  const HeightType next_height = 2;
+  const uint32_t count = 2;
+
+  std::vector<wBlock> blocks;
+  for (auto i = next_height; i < next_height + count; ++i) {
+    auto blk = getBaseBlockBuilder()
+                   .height(i)
+                   .build()
+                   .signAndAddSignature(key)
+                   .finish();
+    blocks.emplace_back(clone(blk));
+  }
+
+  EXPECT_CALL(*peer_query, getLedgerPeers())
+      .WillOnce(Return(std::vector<wPeer>{peer}));
+  EXPECT_CALL(*storage, getTopBlockHeight()).WillOnce(Return(10));
+  EXPECT_CALL(*storage, getBlocks(next_height, count)).WillOnce(Return(blocks));
+  auto wrapper = make_test_subscriber<CallExact>(
+      loader->retrieveBlocks(1, peer_key, count), count);
   auto height = next_height;
   wrapper.subscribe(
       [&height](auto block) { ASSERT_EQ(block->height(), height++); });
@@ -259,7 +337,8 @@ TEST_F(BlockLoaderTest, ValidWhenBlockPresent) {
       .WillOnce(Return(std::vector<wPeer>{peer}));
   EXPECT_CALL(*validator, validate(RefAndPointerEq(block)))
       .WillOnce(Return(Answer{}));
-  EXPECT_CALL(*storage, getBlocksFrom(_)).Times(0);
+  EXPECT_CALL(*storage, getBlockHeight(_)).Times(0);
+  EXPECT_CALL(*storage, getBlocks(_, _)).Times(0);
   auto retrieved_block = loader->retrieveBlock(peer_key, block->hash());
 
   ASSERT_TRUE(retrieved_block);
@@ -270,8 +349,8 @@ TEST_F(BlockLoaderTest, ValidWhenBlockPresent) {
  * @given block loader @and consensus cache with a block @and mocked storage
  * with two blocks
  * @when retrieveBlock is called with a hash of previous block
- * @then consensus cache is missed @and block loader tries to fetch block from
- * the storage
+ * @then consensus cache is missed @and block loader reads the block at the
+ * height from the index of block hashes
  */
 TEST_F(BlockLoaderTest, ValidWhenBlockMissing) {
   auto prev_block = std::make_shared<shared_model::proto::Block>(
@@ -285,10 +364,10 @@ TEST_F(BlockLoaderTest, ValidWhenBlockMissing) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(
-          Return(std::vector<std::shared_ptr<shared_model::interface::Block>>{
-              prev_block, cur_block}));
+  EXPECT_CALL(*storage, getBlockHeight(prev_block->hash()))
+      .WillOnce(Return(boost::make_optional<HeightType>(1)));
+  EXPECT_CALL(*storage, getBlocks(1, 1))
+      .WillOnce(Return(std::vector<wBlock>{prev_block}));
 
   auto block = loader->retrieveBlock(peer_key, prev_block->hash());
   ASSERT_TRUE(block);
@@ -298,8 +377,8 @@ TEST_F(BlockLoaderTest, ValidWhenBlockMissing) {
 /**
  * @given block loader @and empty consensus cache @and two blocks in storage
  * @when retrieveBlock is called with first block's hash
- * @then consensus cache is missed @and block loader tries to fetch block from
- * the storage
+ * @then consensus cache is missed @and block loader reads the block at the
+ * height from the index of block hashes
  */
 TEST_F(BlockLoaderTest, ValidWithEmptyCache) {
   auto prev_block = std::make_shared<shared_model::proto::Block>(
@@ -312,10 +391,10 @@ TEST_F(BlockLoaderTest, ValidWithEmptyCache) {
 
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(
-          Return(std::vector<std::shared_ptr<shared_model::interface::Block>>{
-              prev_block, cur_block}));
+  EXPECT_CALL(*storage, getBlockHeight(prev_block->hash()))
+      .WillOnce(Return(boost::make_optional<HeightType>(1)));
+  EXPECT_CALL(*storage, getBlocks(1, 1))
+      .WillOnce(Return(std::vector<wBlock>{prev_block}));
 
   auto block = loader->retrieveBlock(peer_key, prev_block->hash());
   ASSERT_TRUE(block);
@@ -325,15 +404,15 @@ TEST_F(BlockLoaderTest, ValidWithEmptyCache) {
 /**
  * @given block loader @and empty consensus cache @and no blocks in storage
  * @when retrieveBlock is called with some block hash
- * @then consensus cache is missed @and block storage is missed @and block
- * loader returns nothing
+ * @then consensus cache is missed @and the hash is not in the index @and
+ * block loader returns nothing without reading blocks
  */
 TEST_F(BlockLoaderTest, NoBlocksInStorage) {
   EXPECT_CALL(*peer_query, getLedgerPeers())
       .WillOnce(Return(std::vector<wPeer>{peer}));
-  EXPECT_CALL(*storage, getBlocksFrom(1))
-      .WillOnce(Return(
-          std::vector<std::shared_ptr<shared_model::interface::Block>>{}));
+  EXPECT_CALL(*storage, getBlockHeight(kPrevHash))
+      .WillOnce(Return(boost::none));
+  EXPECT_CALL(*storage, getBlocks(_, _)).Times(0);
 
   auto block = loader->retrieveBlock(peer_key, kPrevHash);
   ASSERT_FALSE(block);
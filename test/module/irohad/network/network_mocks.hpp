@@ -45,11 +45,12 @@ namespace iroha {
 
     class MockBlockLoader : public BlockLoader {
      public:
-      MOCK_METHOD2(
+      MOCK_METHOD3(
           retrieveBlocks,
           rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>(
               const shared_model::interface::types::HeightType,
-              const shared_model::crypto::PublicKey &));
+              const shared_model::crypto::PublicKey &,
+              uint32_t));
       MOCK_METHOD2(
           retrieveBlock,
           boost::optional<std::shared_ptr<shared_model::interface::Block>>(
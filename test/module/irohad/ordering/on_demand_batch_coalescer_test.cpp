@@ -0,0 +1,166 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ordering/impl/on_demand_batch_coalescer.hpp"
+
+#include <gtest/gtest.h>
+#include "interfaces/iroha_internal/proposal.hpp"
+#include "module/irohad/ordering/ordering_mocks.hpp"
+#include "module/shared_model/interface_mocks.hpp"
+
+using namespace iroha;
+using namespace iroha::ordering;
+using namespace iroha::ordering::transport;
+
+using ::testing::_;
+using ::testing::ByMove;
+using ::testing::ElementsAreArray;
+using ::testing::Invoke;
+using ::testing::Return;
+
+struct OnDemandBatchCoalescerTest : public ::testing::Test {
+  void SetUp() override {
+    auto connection = std::make_unique<MockOdOsNotification>();
+    notification = connection.get();
+    metrics = std::make_shared<BatchCoalescerMetrics>();
+    coalescer = std::make_unique<OnDemandBatchCoalescer>(
+        std::move(connection),
+        [this] { return delay.get_observable(); },
+        kMaxBatches,
+        metrics);
+  }
+
+  /**
+   * @return collection of distinct batches of the given size
+   */
+  static OdOsNotification::CollectionType makeBatches(size_t size) {
+    OdOsNotification::CollectionType batches;
+    for (size_t i = 0; i < size; ++i) {
+      batches.push_back(std::make_shared<MockTransactionBatch>());
+    }
+    return batches;
+  }
+
+  /**
+   * Save batches passed to the mocked connection
+   */
+  void saveSent() {
+    EXPECT_CALL(*notification, onBatches(_, _))
+        .WillRepeatedly(Invoke(
+            [this](auto round, auto batches) {
+              sent.emplace_back(round, std::move(batches));
+            }));
+  }
+
+  static constexpr size_t kMaxBatches = 3;
+
+  const consensus::Round round{1, 1};
+  MockOdOsNotification *notification;
+  rxcpp::subjects::subject<OnDemandBatchCoalescer::DelayType> delay;
+  std::shared_ptr<BatchCoalescerMetrics> metrics;
+  std::unique_ptr<OnDemandBatchCoalescer> coalescer;
+  std::vector<std::pair<consensus::Round, OdOsNotification::CollectionType>>
+      sent;
+};
+
+constexpr size_t OnDemandBatchCoalescerTest::kMaxBatches;
+
+/**
+ * @given coalescer with an empty queue
+ * @when batches are passed in two calls and the flush delay expires
+ * @then nothing is sent before the delay expires
+ * AND all batches are sent with a single request after it
+ */
+TEST_F(OnDemandBatchCoalescerTest, FlushOnDelay) {
+  saveSent();
+  auto first = makeBatches(1), second = makeBatches(1);
+  auto expected = first;
+  expected.insert(expected.end(), second.begin(), second.end());
+
+  coalescer->onBatches(round, first);
+  coalescer->onBatches(round, second);
+  ASSERT_TRUE(sent.empty());
+
+  delay.get_subscriber().on_next(0);
+  ASSERT_EQ(sent.size(), 1);
+  ASSERT_EQ(sent[0].first, round);
+  ASSERT_THAT(sent[0].second, ElementsAreArray(expected));
+
+  auto m = metrics->metrics();
+  ASSERT_EQ(m.requests, 1);
+  ASSERT_EQ(m.batches, 2);
+}
+
+/**
+ * @given coalescer with an empty queue
+ * @when batches of the maximal queue size are passed
+ * @then they are sent at once
+ * AND the following delay emission does not send an empty request
+ */
+TEST_F(OnDemandBatchCoalescerTest, FlushOnSize) {
+  saveSent();
+  auto batches = makeBatches(kMaxBatches);
+
+  coalescer->onBatches(round, batches);
+  ASSERT_EQ(sent.size(), 1);
+  ASSERT_THAT(sent[0].second, ElementsAreArray(batches));
+
+  delay.get_subscriber().on_next(0);
+  ASSERT_EQ(sent.size(), 1);
+}
+
+/**
+ * @given coalescer with a queued batch
+ * @when a batch for another round is passed
+ * @then queued batch is sent for its own round
+ * AND the new one is queued
+ */
+TEST_F(OnDemandBatchCoalescerTest, FlushOnRoundChange) {
+  saveSent();
+  auto first = makeBatches(1), second = makeBatches(1);
+  const consensus::Round next_round{2, 1};
+
+  coalescer->onBatches(round, first);
+  coalescer->onBatches(next_round, second);
+  ASSERT_EQ(sent.size(), 1);
+  ASSERT_EQ(sent[0].first, round);
+  ASSERT_THAT(sent[0].second, ElementsAreArray(first));
+
+  delay.get_subscriber().on_next(0);
+  ASSERT_EQ(sent.size(), 2);
+  ASSERT_EQ(sent[1].first, next_round);
+  ASSERT_THAT(sent[1].second, ElementsAreArray(second));
+}
+
+/**
+ * @given coalescer with a queued batch
+ * @when coalescer is destroyed and the delay expires afterwards
+ * @then the batch is sent once on destruction
+ */
+TEST_F(OnDemandBatchCoalescerTest, FlushOnDestruction) {
+  saveSent();
+  auto batches = makeBatches(1);
+
+  coalescer->onBatches(round, batches);
+  coalescer.reset();
+  ASSERT_EQ(sent.size(), 1);
+  ASSERT_THAT(sent[0].second, ElementsAreArray(batches));
+
+  delay.get_subscriber().on_next(0);
+  ASSERT_EQ(sent.size(), 1);
+}
+
+/**
+ * @given coalescer
+ * @when proposal is requested
+ * @then the request is passed to the wrapped connection
+ */
+TEST_F(OnDemandBatchCoalescerTest, RequestProposal) {
+  EXPECT_CALL(*notification, onRequestProposal(round))
+      .WillOnce(Return(ByMove(boost::make_optional(
+          OdOsNotification::ProposalType(std::make_unique<MockProposal>())))));
+
+  ASSERT_TRUE(coalescer->onRequestProposal(round));
+}
@@ -16,9 +16,12 @@ using namespace iroha;
 using namespace iroha::ordering;
 using namespace iroha::ordering::transport;
 
+using ::testing::AtMost;
 using ::testing::ByMove;
+using ::testing::Invoke;
 using ::testing::Ref;
 using ::testing::Return;
+using ::testing::ReturnRefOfCopy;
 
 /**
  * Create unique_ptr with MockOdOsNotification, save to var, and return it
@@ -44,8 +47,12 @@ struct OnDemandConnectionManagerTest : public ::testing::Test {
       set(boost::get<0>(pair), boost::get<1>(pair));
     }
 
+    // prefetch requests are made synchronously
     manager = std::make_shared<OnDemandConnectionManager>(
-        factory, peers.get_observable(), cpeers);
+        factory,
+        peers.get_observable(),
+        cpeers,
+        rxcpp::schedulers::make_immediate());
   }
 
   OnDemandConnectionManager::CurrentPeers cpeers;
@@ -133,3 +140,136 @@ TEST_F(OnDemandConnectionManagerTest, onRequestProposalNone) {
 
   ASSERT_FALSE(result);
 }
+
+/**
+ * @given initialized OnDemandConnectionManager
+ * @when onRequestProposal is called
+ * @then proposals of the next reject and commit rounds are requested from
+ * their issuers
+ */
+TEST_F(OnDemandConnectionManagerTest, PrefetchNextRounds) {
+  consensus::Round round{1, 2};
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kIssuer],
+              onRequestProposal(round))
+      .WillOnce(Return(ByMove(boost::none)));
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kNextRejectRoundIssuer],
+              onRequestProposal(nextRejectRound(round)))
+      .WillOnce(Return(ByMove(boost::none)));
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kNextCommitRoundIssuer],
+              onRequestProposal(nextCommitRound(round)))
+      .WillOnce(Return(ByMove(boost::none)));
+
+  manager->onRequestProposal(round);
+}
+
+/**
+ * @given OnDemandConnectionManager which prefetches proposals in background
+ * @when a proposal of the next reject round is inspected before its request
+ * is completed
+ * @then none is returned without waiting for the request
+ */
+TEST_F(OnDemandConnectionManagerTest, PrefetchedProposalNotWaited) {
+  consensus::Round round{1, 2}, next_round = nextRejectRound(round);
+  manager = std::make_shared<OnDemandConnectionManager>(
+      factory,
+      peers.get_observable(),
+      cpeers,
+      rxcpp::schedulers::make_new_thread());
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kIssuer],
+              onRequestProposal(round))
+      .WillOnce(Return(ByMove(boost::none)));
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kNextRejectRoundIssuer],
+              onRequestProposal(next_round))
+      .WillOnce(Invoke([released](consensus::Round) {
+        released.wait();
+        return boost::optional<OnDemandConnectionManager::ProposalType>{};
+      }));
+  // the request is made after the blocked one, if the manager is alive
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kNextCommitRoundIssuer],
+              onRequestProposal(nextCommitRound(round)))
+      .Times(AtMost(1))
+      .WillRepeatedly(Invoke([](consensus::Round) {
+        return boost::optional<OnDemandConnectionManager::ProposalType>{};
+      }));
+  manager->onRequestProposal(round);
+
+  EXPECT_FALSE(manager->prefetchedProposal(next_round));
+  release.set_value();
+}
+
+/**
+ * @given initialized OnDemandConnectionManager with a proposal prefetched
+ * for the next reject round
+ * @when the prefetched proposal is inspected
+ * AND the next round starts with the same issuer
+ * AND onRequestProposal is called
+ * @then prefetched proposal is returned in both cases
+ */
+TEST_F(OnDemandConnectionManagerTest, PrefetchedProposalUsed) {
+  consensus::Round round{1, 2}, next_round = nextRejectRound(round);
+  auto mock_proposal = std::make_unique<MockProposal>();
+  auto proposal = mock_proposal.get();
+  auto cloned = new MockProposal();
+  EXPECT_CALL(*mock_proposal, clone()).WillOnce(Return(cloned));
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kNextRejectRoundIssuer],
+              onRequestProposal(next_round))
+      .WillOnce(Return(ByMove(boost::make_optional(
+          OnDemandConnectionManager::ProposalType(std::move(mock_proposal))))));
+  manager->onRequestProposal(round);
+
+  auto prefetched = manager->prefetchedProposal(next_round);
+  ASSERT_TRUE(prefetched);
+  ASSERT_EQ(prefetched->get(), proposal);
+
+  auto next_peers = cpeers;
+  next_peers.peers[OnDemandConnectionManager::kIssuer] =
+      cpeers.peers[OnDemandConnectionManager::kNextRejectRoundIssuer];
+  peers.get_subscriber().on_next(next_peers);
+
+  auto result = manager->onRequestProposal(next_round);
+
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result.value().get(), cloned);
+}
+
+/**
+ * @given initialized OnDemandConnectionManager with a proposal prefetched
+ * for the next reject round
+ * @when the next round starts with another issuer
+ * AND onRequestProposal is called
+ * @then prefetched proposal is discarded and the issuer is requested
+ */
+TEST_F(OnDemandConnectionManagerTest, PrefetchedProposalFromOtherPeer) {
+  consensus::Round round{1, 2}, next_round = nextRejectRound(round);
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kNextRejectRoundIssuer],
+              onRequestProposal(next_round))
+      .WillOnce(Return(ByMove(boost::make_optional(
+          OnDemandConnectionManager::ProposalType(
+              std::make_unique<MockProposal>())))));
+  manager->onRequestProposal(round);
+
+  auto prefetched_from = std::static_pointer_cast<MockPeer>(
+      cpeers.peers[OnDemandConnectionManager::kNextRejectRoundIssuer]);
+  auto issuer = std::static_pointer_cast<MockPeer>(
+      cpeers.peers[OnDemandConnectionManager::kIssuer]);
+  EXPECT_CALL(*prefetched_from, address())
+      .WillRepeatedly(ReturnRefOfCopy(std::string("127.0.0.1:1")));
+  EXPECT_CALL(*issuer, address())
+      .WillRepeatedly(ReturnRefOfCopy(std::string("127.0.0.1:2")));
+  EXPECT_CALL(*prefetched_from, pubkey())
+      .WillRepeatedly(ReturnRefOfCopy(
+          shared_model::interface::types::PubkeyType(std::string(32, '1'))));
+  EXPECT_CALL(*issuer, pubkey())
+      .WillRepeatedly(ReturnRefOfCopy(
+          shared_model::interface::types::PubkeyType(std::string(32, '2'))));
+  EXPECT_CALL(*connections[OnDemandConnectionManager::kIssuer],
+              onRequestProposal(next_round))
+      .WillOnce(Return(ByMove(boost::none)));
+
+  auto result = manager->onRequestProposal(next_round);
+
+  ASSERT_FALSE(result);
+}
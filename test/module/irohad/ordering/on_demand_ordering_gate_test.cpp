@@ -39,10 +39,13 @@ class OnDemandOrderingGateTest : public ::testing::Test {
     factory = ufactory.get();
     tx_cache = std::make_shared<ametsuchi::MockTxPresenceCache>();
     ON_CALL(*tx_cache,
-            check(testing::Matcher<const shared_model::crypto::Hash &>(_)))
-        .WillByDefault(
-            Return(boost::make_optional<ametsuchi::TxCacheStatusType>(
-                iroha::ametsuchi::tx_cache_status_responses::Missing())));
+            check(testing::Matcher<
+                  const std::vector<shared_model::crypto::Hash> &>(_)))
+        .WillByDefault(testing::Invoke([](const auto &hashes) {
+          return ametsuchi::TxPresenceCache::BatchStatusCollectionType(
+              hashes.size(),
+              iroha::ametsuchi::tx_cache_status_responses::Missing());
+        }));
     ordering_gate =
         std::make_shared<OnDemandOrderingGate>(ordering_service,
                                                notification,
@@ -233,9 +236,11 @@ TEST_F(OnDemandOrderingGateTest, ReplayedTransactionInProposal) {
   EXPECT_CALL(*notification, onRequestProposal(round))
       .WillOnce(Return(ByMove(std::move(arriving_proposal))));
   EXPECT_CALL(*tx_cache,
-              check(testing::Matcher<const shared_model::crypto::Hash &>(_)))
-      .WillOnce(Return(boost::make_optional<ametsuchi::TxCacheStatusType>(
-          iroha::ametsuchi::tx_cache_status_responses::Committed())));
+              check(testing::Matcher<
+                    const std::vector<shared_model::crypto::Hash> &>(
+                  testing::ElementsAre(hash))))
+      .WillOnce(Return(ametsuchi::TxPresenceCache::BatchStatusCollectionType{
+          iroha::ametsuchi::tx_cache_status_responses::Committed()}));
   // expect proposal to be created without any transactions because it was
   // removed by tx cache
   auto ufactory_proposal = std::make_unique<MockProposal>();
@@ -14,6 +14,7 @@
 #include "datetime/time.hpp"
 #include "interfaces/iroha_internal/transaction_batch_impl.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
+#include "module/irohad/ordering/ordering_mocks.hpp"
 #include "module/shared_model/interface_mocks.hpp"
 #include "module/shared_model/validators/validators.hpp"
 #include "ordering/impl/on_demand_common.hpp"
@@ -28,13 +29,28 @@ using testing::ByMove;
 using testing::Invoke;
 using testing::Matcher;
 using testing::NiceMock;
-using testing::Ref;
 using testing::Return;
 
 using shared_model::interface::Proposal;
 using shared_model::validation::MockValidator;
 using MockProposalValidator = MockValidator<Proposal>;
 
+/**
+ * Cache response with all transactions missing
+ */
+boost::optional<iroha::ametsuchi::TxPresenceCache::BatchStatusCollectionType>
+allMissing(const std::vector<shared_model::crypto::Hash> &hashes) {
+  iroha::ametsuchi::TxPresenceCache::BatchStatusCollectionType result;
+  std::transform(hashes.begin(),
+                 hashes.end(),
+                 std::back_inserter(result),
+                 [](const auto &hash) {
+                   return iroha::ametsuchi::tx_cache_status_responses::Missing{
+                       hash};
+                 });
+  return result;
+}
+
 class OnDemandOsTest : public ::testing::Test {
  public:
   std::shared_ptr<OnDemandOrderingService> os;
@@ -54,13 +70,9 @@ class OnDemandOsTest : public ::testing::Test {
         std::make_unique<NiceMock<iroha::ametsuchi::MockTxPresenceCache>>();
     mock_cache = tx_cache.get();
     // every batch is new by default
-    ON_CALL(
-        *mock_cache,
-        check(
-            testing::Matcher<const shared_model::interface::TransactionBatch &>(
-                _)))
-        .WillByDefault(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
-            iroha::ametsuchi::tx_cache_status_responses::Missing()}));
+    ON_CALL(*mock_cache,
+            check(A<const std::vector<shared_model::crypto::Hash> &>()))
+        .WillByDefault(Invoke(allMissing));
     os = std::make_shared<OnDemandOrderingServiceImpl>(transaction_limit,
                                                        std::move(factory),
                                                        std::move(tx_cache),
@@ -68,6 +80,29 @@ class OnDemandOsTest : public ::testing::Test {
                                                        initial_round);
   }
 
+  /**
+   * Replace the OS with the one which passes leftover batches to the
+   * consumer
+   */
+  void createOs(std::shared_ptr<OdOsNotification> consumer,
+                size_t max_leftover_batches) {
+    auto factory = std::make_unique<
+        shared_model::proto::ProtoProposalFactory<MockProposalValidator>>();
+    auto tx_cache =
+        std::make_unique<NiceMock<iroha::ametsuchi::MockTxPresenceCache>>();
+    ON_CALL(*tx_cache,
+            check(A<const std::vector<shared_model::crypto::Hash> &>()))
+        .WillByDefault(Invoke(allMissing));
+    mock_cache = tx_cache.get();
+    os = std::make_shared<OnDemandOrderingServiceImpl>(transaction_limit,
+                                                       std::move(factory),
+                                                       std::move(tx_cache),
+                                                       proposal_limit,
+                                                       initial_round,
+                                                       std::move(consumer),
+                                                       max_leftover_batches);
+  }
+
   /**
    * Generate transactions with provided range
    * @param os - ordering service for insertion
@@ -156,6 +191,64 @@ TEST_F(OnDemandOsTest, OverflowRound) {
             (*os->onRequestProposal(target_round))->transactions().size());
 }
 
+/**
+ * @given on-demand OS with a consumer of leftover batches
+ * @when  send number of transactions greater that limit
+ * AND initiate next round
+ * @then  the rest of transactions is passed to the consumer for the round
+ */
+TEST_F(OnDemandOsTest, OverflowForwarded) {
+  auto consumer = std::make_shared<MockOdOsNotification>();
+  createOs(consumer, OnDemandOrderingServiceImpl::kDefaultMaxLeftoverBatches);
+  generateTransactionsAndInsert(target_round, {1, transaction_limit + 5});
+
+  EXPECT_CALL(*consumer, onBatches(commit_round, _))
+      .WillOnce(Invoke([](auto, const auto &batches) {
+        EXPECT_EQ(4, batches.size());
+      }));
+  os->onCollaborationOutcome(commit_round);
+
+  ASSERT_EQ(transaction_limit,
+            (*os->onRequestProposal(target_round))->transactions().size());
+}
+
+/**
+ * @given on-demand OS with a consumer of leftover batches and a limit of them
+ * @when  send number of transactions greater that limit
+ * AND initiate next round
+ * @then  only the limited number of the rest of batches is passed to the
+ * consumer
+ */
+TEST_F(OnDemandOsTest, OverflowForwardedUpToLimit) {
+  auto consumer = std::make_shared<MockOdOsNotification>();
+  createOs(consumer, 2);
+  generateTransactionsAndInsert(target_round, {1, transaction_limit + 5});
+
+  EXPECT_CALL(*consumer, onBatches(commit_round, _))
+      .WillOnce(Invoke([](auto, const auto &batches) {
+        EXPECT_EQ(2, batches.size());
+      }));
+  os->onCollaborationOutcome(commit_round);
+}
+
+/**
+ * @given initialized on-demand OS
+ * @when  send the same batches twice
+ * AND initiate next round
+ * @then  check that the proposal contains each transaction once
+ */
+TEST_F(OnDemandOsTest, DuplicateBatchesSkipped) {
+  auto batches = generateTransactions({1, 3});
+  os->onBatches(target_round, batches);
+  os->onBatches(target_round, batches);
+
+  os->onCollaborationOutcome(commit_round);
+
+  auto proposal = os->onRequestProposal(target_round);
+  ASSERT_TRUE(proposal);
+  ASSERT_EQ(2, (*proposal)->transactions().size());
+}
+
 /**
  * @given initialized on-demand OS
  * @when  send transactions from different threads
@@ -250,19 +343,8 @@ TEST_F(OnDemandOsTest, UseFactoryForProposal) {
   auto tx_cache =
       std::make_unique<NiceMock<iroha::ametsuchi::MockTxPresenceCache>>();
   ON_CALL(*tx_cache,
-          check(A<const shared_model::interface::TransactionBatch &>()))
-      .WillByDefault(Invoke([](const auto &batch) {
-        iroha::ametsuchi::TxPresenceCache::BatchStatusCollectionType result;
-        std::transform(
-            batch.transactions().begin(),
-            batch.transactions().end(),
-            std::back_inserter(result),
-            [](auto &tx) {
-              return iroha::ametsuchi::tx_cache_status_responses::Missing{
-                  tx->hash()};
-            });
-        return result;
-      }));
+          check(A<const std::vector<shared_model::crypto::Hash> &>()))
+      .WillByDefault(Invoke(allMissing));
   os = std::make_shared<OnDemandOrderingServiceImpl>(transaction_limit,
                                                      std::move(factory),
                                                      std::move(tx_cache),
@@ -279,10 +361,17 @@ TEST_F(OnDemandOsTest, UseFactoryForProposal) {
   ASSERT_TRUE(os->onRequestProposal(target_round));
 }
 
-// Return matcher for batch, which passes it by const &
-// used when passing batch as an argument to check() in transaction cache
-auto batchRef(const shared_model::interface::TransactionBatch &batch) {
-  return Matcher<const shared_model::interface::TransactionBatch &>(Ref(batch));
+// Return matcher for hashes of all transactions of the batches, which are
+// passed as an argument to check() in transaction cache
+auto hashesOf(const OnDemandOrderingService::CollectionType &batches) {
+  std::vector<shared_model::crypto::Hash> hashes;
+  for (const auto &batch : batches) {
+    for (const auto &tx : batch->transactions()) {
+      hashes.push_back(tx->hash());
+    }
+  }
+  return Matcher<const std::vector<shared_model::crypto::Hash> &>(
+      testing::ContainerEq(hashes));
 }
 
 /**
@@ -292,9 +381,8 @@ auto batchRef(const shared_model::interface::TransactionBatch &batch) {
  */
 TEST_F(OnDemandOsTest, AlreadyProcessedProposalDiscarded) {
   auto batches = generateTransactions({1, 2});
-  auto &batch = *batches.at(0);
 
-  EXPECT_CALL(*mock_cache, check(batchRef(batch)))
+  EXPECT_CALL(*mock_cache, check(hashesOf(batches)))
       .WillOnce(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
           iroha::ametsuchi::tx_cache_status_responses::Committed()}));
 
@@ -314,9 +402,8 @@ TEST_F(OnDemandOsTest, AlreadyProcessedProposalDiscarded) {
  */
 TEST_F(OnDemandOsTest, PassMissingTransaction) {
   auto batches = generateTransactions({1, 2});
-  auto &batch = *batches.at(0);
 
-  EXPECT_CALL(*mock_cache, check(batchRef(batch)))
+  EXPECT_CALL(*mock_cache, check(hashesOf(batches)))
       .WillOnce(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
           iroha::ametsuchi::tx_cache_status_responses::Missing()}));
 
@@ -335,21 +422,16 @@ TEST_F(OnDemandOsTest, PassMissingTransaction) {
  * @given initialized on-demand OS
  * @when add 3 batches, with second one being already commited
  * @then 2 new batches are in a proposal and already commited batch is discarded
+ * @and statuses of all batches are requested from the cache at once
  */
 TEST_F(OnDemandOsTest, SeveralTransactionsOneCommited) {
   auto batches = generateTransactions({1, 4});
-  auto &batch1 = *batches.at(0);
   auto &batch2 = *batches.at(1);
-  auto &batch3 = *batches.at(2);
 
-  EXPECT_CALL(*mock_cache, check(batchRef(batch1)))
-      .WillOnce(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
-          iroha::ametsuchi::tx_cache_status_responses::Missing()}));
-  EXPECT_CALL(*mock_cache, check(batchRef(batch2)))
-      .WillOnce(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
-          iroha::ametsuchi::tx_cache_status_responses::Committed()}));
-  EXPECT_CALL(*mock_cache, check(batchRef(batch3)))
+  EXPECT_CALL(*mock_cache, check(hashesOf(batches)))
       .WillOnce(Return(std::vector<iroha::ametsuchi::TxCacheStatusType>{
+          iroha::ametsuchi::tx_cache_status_responses::Missing(),
+          iroha::ametsuchi::tx_cache_status_responses::Committed(),
           iroha::ametsuchi::tx_cache_status_responses::Missing()}));
 
   os->onBatches(target_round, batches);
@@ -21,6 +21,7 @@
 #include "module/shared_model/builders/protobuf/test_proposal_builder.hpp"
 #include "module/shared_model/cryptography/crypto_model_signer_mock.hpp"
 #include "module/shared_model/validators/validators.hpp"
+#include "ordering/impl/on_demand_common.hpp"
 
 using namespace iroha;
 using namespace iroha::validation;
@@ -34,6 +35,7 @@ using ::testing::A;
 using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
+using ::testing::SaveArg;
 using ::testing::ReturnArg;
 
 using wBlock = std::shared_ptr<shared_model::interface::Block>;
@@ -65,13 +67,14 @@ class SimulatorTest : public ::testing::Test {
     shared_model::crypto::crypto_signer_expecter.reset();
   }
 
-  void init() {
+  void init(Simulator::SpeculativeProposalSource speculative_proposals = {}) {
     simulator = std::make_shared<Simulator>(ordering_gate,
                                             validator,
                                             factory,
                                             block_query_factory,
                                             crypto_signer,
-                                            std::move(block_factory));
+                                            std::move(block_factory),
+                                            std::move(speculative_proposals));
   }
 
   consensus::Round round;
@@ -363,3 +366,167 @@ TEST_F(SimulatorTest, SomeFailingTxs) {
 
   ASSERT_TRUE(proposal_wrapper.validate());
 }
+
+/**
+ * @given simulator with speculative proposal source
+ * @when a proposal is processed
+ * AND the proposal of the next commit round is validated in background
+ * AND the next commit round starts with the same proposal on top of the
+ * created block
+ * @then the proposal of the next round is not validated again
+ * AND its speculative validation result is used
+ */
+TEST_F(SimulatorTest, SpeculativeValidationUsed) {
+  auto proposal = makeProposal(2);
+  auto next_proposal = makeProposal(3);
+  auto next_round = ordering::nextCommitRound(round);
+  auto block = makeBlock(proposal->height() - 1);
+
+  auto verified = std::make_unique<VerifiedProposalAndErrors>();
+  verified->verified_proposal = proposal;
+  auto next_verified = std::make_unique<VerifiedProposalAndErrors>();
+  next_verified->verified_proposal = next_proposal;
+  auto next_verified_ptr = next_verified.get();
+
+  std::vector<consensus::Round> requested_rounds;
+  auto speculative_proposals = [&](const consensus::Round &round) {
+    requested_rounds.push_back(round);
+    return boost::make_optional(
+        std::shared_ptr<shared_model::interface::Proposal>(next_proposal));
+  };
+
+  std::shared_ptr<shared_model::interface::Block> created_block;
+  EXPECT_CALL(*query, getTopBlock())
+      .WillOnce(Return(expected::makeValue(wBlock(clone(block)))))
+      .WillOnce(Invoke([&created_block] {
+        return expected::makeValue(created_block);
+      }));
+  EXPECT_CALL(*query, getTopBlockHeight())
+      .WillOnce(Return(block.height()))
+      .WillOnce(Return(proposal->height()));
+  EXPECT_CALL(*validator, validate(_, _))
+      .WillOnce(Invoke([&](const auto &p, auto &) {
+        EXPECT_EQ(p.hash(), proposal->hash());
+        return std::move(verified);
+      }))
+      .WillOnce(Invoke([&](const auto &p, auto &) {
+        EXPECT_EQ(p.hash(), next_proposal->hash());
+        return std::move(next_verified);
+      }));
+  TemporaryFactory::PreparationWork work;
+  std::atomic<bool> cancelled{false};
+  EXPECT_CALL(*factory, prepareBlockAsync_(_, _))
+      .Times(2)
+      .WillRepeatedly(SaveArg<1>(&work));
+  EXPECT_CALL(*factory, prepareBlock_(_)).Times(0);
+  EXPECT_CALL(*ordering_gate, onProposal())
+      .WillOnce(Return(rxcpp::observable<>::empty<OrderingEvent>()));
+  EXPECT_CALL(*shared_model::crypto::crypto_signer_expecter,
+              sign(A<shared_model::interface::Block &>()))
+      .Times(2);
+
+  init(speculative_proposals);
+
+  auto proposal_wrapper =
+      make_test_subscriber<CallExact>(simulator->onVerifiedProposal(), 2);
+  std::vector<std::shared_ptr<VerifiedProposalAndErrors>> verified_proposals;
+  proposal_wrapper.subscribe([&](auto event) {
+    verified_proposals.push_back(getVerifiedProposalUnsafe(event));
+  });
+  simulator->onBlock().subscribe([&created_block](const auto &event) {
+    created_block = getBlockUnsafe(event);
+  });
+
+  simulator->processProposal(*proposal, round);
+  MockTemporaryWsv wsv;
+  EXPECT_CALL(wsv, createSavepoint("speculative_proposal"))
+      .WillOnce(Invoke([](const auto &) { return nullptr; }));
+  ASSERT_TRUE(work(wsv, cancelled));
+
+  simulator->processProposal(*next_proposal, next_round);
+
+  ASSERT_TRUE(proposal_wrapper.validate());
+  ASSERT_EQ(requested_rounds, std::vector<consensus::Round>{next_round});
+  ASSERT_EQ(verified_proposals.back().get(), next_verified_ptr);
+
+  // accepted transactions are applied again to build the state of the block
+  EXPECT_CALL(wsv, apply(_)).Times(next_proposal->transactions().size());
+  ASSERT_TRUE(work(wsv, cancelled));
+}
+
+/**
+ * @given simulator with speculative proposal source
+ * @when a proposal is processed
+ * AND the state of its block is needed before the proposal of the next
+ * commit round is validated in background
+ * @then the speculative validation is skipped
+ * AND the proposal of the next round is validated when the round starts
+ */
+TEST_F(SimulatorTest, SpeculativeValidationCancelled) {
+  auto proposal = makeProposal(2);
+  auto next_proposal = makeProposal(3);
+  auto next_round = ordering::nextCommitRound(round);
+  auto block = makeBlock(proposal->height() - 1);
+
+  auto verified = std::make_unique<VerifiedProposalAndErrors>();
+  verified->verified_proposal = proposal;
+  auto next_verified = std::make_unique<VerifiedProposalAndErrors>();
+  next_verified->verified_proposal = next_proposal;
+  auto next_verified_ptr = next_verified.get();
+
+  auto speculative_proposals = [&](const consensus::Round &) {
+    return boost::make_optional(
+        std::shared_ptr<shared_model::interface::Proposal>(next_proposal));
+  };
+
+  std::shared_ptr<shared_model::interface::Block> created_block;
+  EXPECT_CALL(*query, getTopBlock())
+      .WillOnce(Return(expected::makeValue(wBlock(clone(block)))))
+      .WillOnce(Invoke([&created_block] {
+        return expected::makeValue(created_block);
+      }));
+  EXPECT_CALL(*query, getTopBlockHeight())
+      .WillOnce(Return(block.height()))
+      .WillOnce(Return(proposal->height()));
+  EXPECT_CALL(*validator, validate(_, _))
+      .WillOnce(Invoke([&](const auto &p, auto &) {
+        EXPECT_EQ(p.hash(), proposal->hash());
+        return std::move(verified);
+      }))
+      .WillOnce(Invoke([&](const auto &p, auto &) {
+        EXPECT_EQ(p.hash(), next_proposal->hash());
+        return std::move(next_verified);
+      }));
+  TemporaryFactory::PreparationWork work;
+  EXPECT_CALL(*factory, prepareBlockAsync_(_, _))
+      .Times(2)
+      .WillRepeatedly(SaveArg<1>(&work));
+  EXPECT_CALL(*ordering_gate, onProposal())
+      .WillOnce(Return(rxcpp::observable<>::empty<OrderingEvent>()));
+  EXPECT_CALL(*shared_model::crypto::crypto_signer_expecter,
+              sign(A<shared_model::interface::Block &>()))
+      .Times(2);
+
+  init(speculative_proposals);
+
+  auto proposal_wrapper =
+      make_test_subscriber<CallExact>(simulator->onVerifiedProposal(), 2);
+  std::vector<std::shared_ptr<VerifiedProposalAndErrors>> verified_proposals;
+  proposal_wrapper.subscribe([&](auto event) {
+    verified_proposals.push_back(getVerifiedProposalUnsafe(event));
+  });
+  simulator->onBlock().subscribe([&created_block](const auto &event) {
+    created_block = getBlockUnsafe(event);
+  });
+
+  simulator->processProposal(*proposal, round);
+  MockTemporaryWsv wsv;
+  EXPECT_CALL(wsv, createSavepoint(_)).Times(0);
+  std::atomic<bool> cancelled{true};
+  ASSERT_TRUE(work(wsv, cancelled));
+
+  simulator->processProposal(*next_proposal, next_round);
+
+  ASSERT_TRUE(proposal_wrapper.validate());
+  ASSERT_EQ(verified_proposals.back().get(), next_verified_ptr);
+}
@@ -76,6 +76,50 @@ class SynchronizerTest : public ::testing::Test {
     return std::make_shared<shared_model::proto::Block>(std::move(block));
   }
 
+  std::shared_ptr<shared_model::interface::Block> makeBlock(
+      shared_model::interface::types::HeightType height) const {
+    auto block = TestUnsignedBlockBuilder()
+                     .height(height)
+                     .createdTime(iroha::time::now())
+                     .build()
+                     .signAndAddSignature(
+                         shared_model::crypto::DefaultCryptoAlgorithmType::
+                             generateKeypair())
+                     .finish();
+    return std::make_shared<shared_model::proto::Block>(std::move(block));
+  }
+
+  /**
+   * Emulate a peer which sends requested blocks following the given height
+   */
+  rxcpp::observable<std::shared_ptr<shared_model::interface::Block>>
+  loadBlocks(shared_model::interface::types::HeightType height,
+             uint32_t count) const {
+    std::vector<std::shared_ptr<shared_model::interface::Block>> blocks;
+    for (auto block_height = height + 1; block_height <= height + count;
+         ++block_height) {
+      blocks.push_back(makeBlock(block_height));
+    }
+    return rxcpp::observable<>::iterate(blocks);
+  }
+
+  /**
+   * Replace the synchronizer with the one which loads blocks in small ranges
+   */
+  void makeRangeSynchronizer(uint32_t blocks_per_range,
+                             size_t ranges_in_flight) {
+    synchronizer.reset();
+    EXPECT_CALL(*consensus_gate, onOutcome())
+        .WillOnce(Return(gate_outcome.get_observable()));
+    synchronizer = std::make_shared<SynchronizerImpl>(consensus_gate,
+                                                      chain_validator,
+                                                      mutable_factory,
+                                                      block_query_factory,
+                                                      block_loader,
+                                                      blocks_per_range,
+                                                      ranges_in_flight);
+  }
+
   const shared_model::interface::types::HeightType kHeight{5};
 
   std::shared_ptr<MockChainValidator> chain_validator;
@@ -111,7 +155,7 @@ TEST_F(SynchronizerTest, ValidWhenSingleCommitSynchronized) {
           }));
   EXPECT_CALL(*mutable_factory, commit_(_)).Times(1);
   EXPECT_CALL(*chain_validator, validateAndApply(_, _)).Times(0);
-  EXPECT_CALL(*block_loader, retrieveBlocks(_, _)).Times(0);
+  EXPECT_CALL(*block_loader, retrieveBlocks(_, _, _)).Times(0);
 
   auto wrapper =
       make_test_subscriber<CallExact>(synchronizer->on_commit_chain(), 1);
@@ -144,7 +188,7 @@ TEST_F(SynchronizerTest, ValidWhenBadStorage) {
       .WillOnce(Return(ByMove(expected::makeError("Connection was closed"))));
   EXPECT_CALL(*mutable_factory, commit_(_)).Times(0);
   EXPECT_CALL(*chain_validator, validateAndApply(_, _)).Times(0);
-  EXPECT_CALL(*block_loader, retrieveBlocks(_, _)).Times(0);
+  EXPECT_CALL(*block_loader, retrieveBlocks(_, _, _)).Times(0);
 
   auto wrapper =
       make_test_subscriber<CallExact>(synchronizer->on_commit_chain(), 0);
@@ -169,7 +213,7 @@ TEST_F(SynchronizerTest, ValidWhenValidChain) {
 
   EXPECT_CALL(*mutable_factory, commit_(_)).Times(1);
   EXPECT_CALL(*chain_validator, validateAndApply(_, _)).WillOnce(Return(true));
-  EXPECT_CALL(*block_loader, retrieveBlocks(_, _))
+  EXPECT_CALL(*block_loader, retrieveBlocks(_, _, _))
       .WillOnce(Return(rxcpp::observable<>::just(commit_message)));
 
   auto wrapper =
@@ -208,7 +252,7 @@ TEST_F(SynchronizerTest, ExactlyThreeRetrievals) {
         chain.as_blocking().subscribe([](auto) {});
         return true;
       }));
-  EXPECT_CALL(*block_loader, retrieveBlocks(_, _))
+  EXPECT_CALL(*block_loader, retrieveBlocks(_, _, _))
       .WillOnce(Return(rxcpp::observable<>::empty<
                        std::shared_ptr<shared_model::interface::Block>>()))
       .WillOnce(Return(rxcpp::observable<>::just(commit_message)))
@@ -234,7 +278,7 @@ TEST_F(SynchronizerTest, RetrieveBlockTwoFailures) {
       SetFactory(&createMockMutableStorage);
   EXPECT_CALL(*mutable_factory, createMutableStorage()).Times(1);
   EXPECT_CALL(*mutable_factory, commit_(_)).Times(1);
-  EXPECT_CALL(*block_loader, retrieveBlocks(_, _))
+  EXPECT_CALL(*block_loader, retrieveBlocks(_, _, _))
       .WillRepeatedly(Return(rxcpp::observable<>::just(commit_message)));
 
   // fail the chain validation two times so that synchronizer will try more
@@ -263,6 +307,128 @@ TEST_F(SynchronizerTest, RetrieveBlockTwoFailures) {
   ASSERT_TRUE(wrapper.validate());
 }
 
+/**
+ * @given synchronizer which loads two ranges of two blocks at once
+ * @when gate have voted for other block five blocks ahead of the storage
+ * @then ranges are requested from consecutive heights @and blocks are applied
+ * one by one in order of height @and all of them are in the commit event
+ */
+TEST_F(SynchronizerTest, RangesAppliedInOrder) {
+  makeRangeSynchronizer(2, 2);
+  DefaultValue<expected::Result<std::unique_ptr<MutableStorage>, std::string>>::
+      SetFactory(&createMockMutableStorage);
+  ON_CALL(*block_query, getTopBlockHeight()).WillByDefault(Return(0));
+
+  EXPECT_CALL(*mutable_factory, createMutableStorage()).Times(1);
+  EXPECT_CALL(*mutable_factory, commit_(_)).Times(1);
+  EXPECT_CALL(*block_loader, retrieveBlocks(0, _, 2))
+      .WillOnce(testing::Invoke(
+          [this](auto height, auto &, auto count) {
+            return this->loadBlocks(height, count);
+          }));
+  EXPECT_CALL(*block_loader, retrieveBlocks(2, _, 2))
+      .WillOnce(testing::Invoke(
+          [this](auto height, auto &, auto count) {
+            return this->loadBlocks(height, count);
+          }));
+  EXPECT_CALL(*block_loader, retrieveBlocks(4, _, 1))
+      .WillOnce(testing::Invoke(
+          [this](auto height, auto &, auto count) {
+            return this->loadBlocks(height, count);
+          }));
+  std::vector<shared_model::interface::types::HeightType> applied;
+  EXPECT_CALL(*chain_validator, validateAndApply(_, _))
+      .WillRepeatedly(testing::Invoke([&applied](auto chain, auto &) {
+        chain.as_blocking().subscribe(
+            [&applied](auto block) { applied.push_back(block->height()); });
+        return true;
+      }));
+
+  auto wrapper =
+      make_test_subscriber<CallExact>(synchronizer->on_commit_chain(), 1);
+  wrapper.subscribe([this](auto commit_event) {
+    auto block_wrapper =
+        make_test_subscriber<CallExact>(commit_event.synced_blocks, kHeight);
+    block_wrapper.subscribe();
+    ASSERT_EQ(commit_event.sync_outcome, SynchronizationOutcomeType::kCommit);
+    ASSERT_TRUE(block_wrapper.validate());
+  });
+
+  gate_outcome.get_subscriber().on_next(
+      consensus::VoteOther{public_keys, hash, consensus::Round{kHeight, 1}});
+
+  ASSERT_TRUE(wrapper.validate());
+  ASSERT_EQ(applied,
+            (std::vector<shared_model::interface::types::HeightType>{
+                1, 2, 3, 4, 5}));
+}
+
+/**
+ * @given synchronizer which loads two ranges of two blocks at once
+ * @when the block at height three fails to be applied once
+ * @then blocks are loaded again starting from height three @and previously
+ * applied blocks are kept
+ */
+TEST_F(SynchronizerTest, LoadingResumedFromFailedBlock) {
+  makeRangeSynchronizer(2, 2);
+  DefaultValue<expected::Result<std::unique_ptr<MutableStorage>, std::string>>::
+      SetFactory(&createMockMutableStorage);
+  ON_CALL(*block_query, getTopBlockHeight()).WillByDefault(Return(0));
+
+  EXPECT_CALL(*mutable_factory, createMutableStorage()).Times(1);
+  EXPECT_CALL(*mutable_factory, commit_(_)).Times(1);
+  EXPECT_CALL(*block_loader, retrieveBlocks(0, _, 2))
+      .WillOnce(testing::Invoke(
+          [this](auto height, auto &, auto count) {
+            return this->loadBlocks(height, count);
+          }));
+  EXPECT_CALL(*block_loader, retrieveBlocks(2, _, 2))
+      .Times(2)
+      .WillRepeatedly(testing::Invoke(
+          [this](auto height, auto &, auto count) {
+            return this->loadBlocks(height, count);
+          }));
+  EXPECT_CALL(*block_loader, retrieveBlocks(4, _, 1))
+      .Times(2)
+      .WillRepeatedly(testing::Invoke(
+          [this](auto height, auto &, auto count) {
+            return this->loadBlocks(height, count);
+          }));
+  std::vector<shared_model::interface::types::HeightType> applied;
+  bool failed = false;
+  EXPECT_CALL(*chain_validator, validateAndApply(_, _))
+      .WillRepeatedly(
+          testing::Invoke([&applied, &failed](auto chain, auto &) {
+            std::vector<shared_model::interface::types::HeightType> heights;
+            chain.as_blocking().subscribe(
+                [&heights](auto block) { heights.push_back(block->height()); });
+            if (heights == decltype(heights){3} and not failed) {
+              failed = true;
+              return false;
+            }
+            applied.insert(applied.end(), heights.begin(), heights.end());
+            return true;
+          }));
+
+  auto wrapper =
+      make_test_subscriber<CallExact>(synchronizer->on_commit_chain(), 1);
+  wrapper.subscribe([this](auto commit_event) {
+    auto block_wrapper =
+        make_test_subscriber<CallExact>(commit_event.synced_blocks, kHeight);
+    block_wrapper.subscribe();
+    ASSERT_EQ(commit_event.sync_outcome, SynchronizationOutcomeType::kCommit);
+    ASSERT_TRUE(block_wrapper.validate());
+  });
+
+  gate_outcome.get_subscriber().on_next(
+      consensus::VoteOther{public_keys, hash, consensus::Round{kHeight, 1}});
+
+  ASSERT_TRUE(wrapper.validate());
+  ASSERT_EQ(applied,
+            (std::vector<shared_model::interface::types::HeightType>{
+                1, 2, 3, 4, 5}));
+}
+
 /**
  * @given initialized components
  * @when gate have got reject on proposal
@@ -371,7 +537,7 @@ TEST_F(SynchronizerTest, VotedForOtherCommitPrepared) {
 
   EXPECT_CALL(*mutable_factory, commit_(_)).Times(1);
 
-  EXPECT_CALL(*block_loader, retrieveBlocks(_, _))
+  EXPECT_CALL(*block_loader, retrieveBlocks(_, _, _))
       .WillRepeatedly(Return(rxcpp::observable<>::just(commit_message)));
 
   EXPECT_CALL(*chain_validator, validateAndApply(_, _)).WillOnce(Return(true));
@@ -0,0 +1,99 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "torii/impl/status_dispatcher.hpp"
+
+#include <gtest/gtest.h>
+#include "backend/protobuf/proto_tx_status_factory.hpp"
+
+using namespace iroha::torii;
+
+class StatusDispatcherTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    dispatcher = std::make_shared<StatusDispatcher>(bus.get_observable());
+  }
+
+  void publish(const shared_model::crypto::Hash &hash) {
+    bus.get_subscriber().on_next(
+        StatusDispatcher::Response(status_factory->makeStatelessValid(hash)));
+  }
+
+  rxcpp::subjects::subject<StatusDispatcher::Response> bus;
+  std::shared_ptr<shared_model::interface::TxStatusFactory> status_factory =
+      std::make_shared<shared_model::proto::ProtoTxStatusFactory>();
+  std::shared_ptr<StatusDispatcher> dispatcher;
+
+  shared_model::crypto::Hash hash1{"hash1"};
+  shared_model::crypto::Hash hash2{"hash2"};
+};
+
+/**
+ * @given two streams for one transaction and one stream for another
+ * @when statuses of both transactions and of an unknown one are published
+ * @then each stream receives only statuses of its transaction, and metrics
+ * count each delivery and the unobserved status
+ */
+TEST_F(StatusDispatcherTest, DeliversByHash) {
+  std::vector<shared_model::crypto::Hash> received1, received2, received3;
+  auto save_to = [](auto &received) {
+    return [&received](const StatusDispatcher::Response &response) {
+      received.push_back(response->transactionHash());
+    };
+  };
+  dispatcher->statuses(hash1).subscribe(save_to(received1));
+  dispatcher->statuses(hash1).subscribe(save_to(received2));
+  dispatcher->statuses(hash2).subscribe(save_to(received3));
+
+  publish(hash1);
+  publish(hash2);
+  publish(shared_model::crypto::Hash("unknown"));
+
+  ASSERT_EQ(received1, std::vector<shared_model::crypto::Hash>{hash1});
+  ASSERT_EQ(received2, std::vector<shared_model::crypto::Hash>{hash1});
+  ASSERT_EQ(received3, std::vector<shared_model::crypto::Hash>{hash2});
+
+  auto metrics = dispatcher->metrics();
+  ASSERT_EQ(metrics.published, 3);
+  ASSERT_EQ(metrics.delivered, 3);
+  ASSERT_EQ(metrics.unobserved, 1);
+  ASSERT_EQ(metrics.active_hashes, 2);
+  ASSERT_EQ(metrics.active_streams, 3);
+}
+
+/**
+ * @given stream of a transaction
+ * @when the stream is unsubscribed
+ * @then it is removed from the index and receives no more statuses
+ */
+TEST_F(StatusDispatcherTest, RemovesUnsubscribedStream) {
+  size_t received = 0;
+  auto subscription =
+      dispatcher->statuses(hash1).subscribe([&](auto) { ++received; });
+  publish(hash1);
+  subscription.unsubscribe();
+  publish(hash1);
+
+  ASSERT_EQ(received, 1);
+  auto metrics = dispatcher->metrics();
+  ASSERT_EQ(metrics.active_hashes, 0);
+  ASSERT_EQ(metrics.active_streams, 0);
+  ASSERT_EQ(metrics.unobserved, 1);
+}
+
+/**
+ * @given stream which completes itself on the first status
+ * @when a status is published
+ * @then the stream is removed from the index during dispatch
+ */
+TEST_F(StatusDispatcherTest, CompletesDuringDispatch) {
+  size_t received = 0;
+  dispatcher->statuses(hash1).take(1).subscribe([&](auto) { ++received; });
+  publish(hash1);
+  publish(hash1);
+
+  ASSERT_EQ(received, 1);
+  ASSERT_EQ(dispatcher->metrics().active_streams, 0);
+}
@@ -19,21 +19,20 @@
 #include "interfaces/iroha_internal/transaction_batch.hpp"
 #include "interfaces/iroha_internal/transaction_batch_factory_impl.hpp"
 #include "interfaces/iroha_internal/transaction_batch_parser_impl.hpp"
+#include "main/server_runner.hpp"
 #include "module/irohad/ametsuchi/ametsuchi_mocks.hpp"
 #include "module/irohad/network/network_mocks.hpp"
 #include "module/irohad/torii/torii_mocks.hpp"
 #include "module/shared_model/interface/mock_transaction_batch_factory.hpp"
 #include "module/shared_model/validators/validators.hpp"
-#include "module/vendor/grpc_mocks.hpp"
+#include "torii/command_client.hpp"
 #include "torii/impl/status_bus_impl.hpp"
 #include "validators/protobuf/proto_transaction_validator.hpp"
 
 using ::testing::_;
 using ::testing::A;
 using ::testing::Invoke;
-using ::testing::Property;
 using ::testing::Return;
-using ::testing::StrEq;
 
 using namespace iroha::ametsuchi;
 using namespace iroha::torii;
@@ -110,6 +109,30 @@ class CommandServiceTransportGrpcTest : public testing::Test {
 
   const size_t kHashLength = 32;
   const size_t kTimes = 5;
+
+  /**
+   * Serve the transport and read the status stream with a client
+   * @param request - status stream request
+   * @return statuses written to the stream
+   */
+  std::vector<iroha::protocol::ToriiResponse> statusStream(
+      const iroha::protocol::TxStatusRequest &request) {
+    ServerRunner runner(kIp + ":0");
+    int port = 0;
+    runner.append(transport_grpc)
+        .run()
+        .match([&port](iroha::expected::Value<int> v) { port = v.value; },
+               [](iroha::expected::Error<std::string> e) {
+                 FAIL() << e.error;
+               });
+    runner.waitForServersReady();
+
+    std::vector<iroha::protocol::ToriiResponse> responses;
+    torii::CommandSyncClient(kIp, port).StatusStream(request, responses);
+    return responses;
+  }
+
+  const std::string kIp = "127.0.0.1";
 };
 
 /**
@@ -210,18 +233,22 @@ TEST_F(CommandServiceTransportGrpcTest, ListToriiPartialInvalid) {
 
   iroha::protocol::TxList request{};
   for (size_t i = 0; i < kTimes; ++i) {
-    request.add_transactions();
+    request.add_transactions()
+        ->mutable_payload()
+        ->mutable_reduced_payload()
+        ->set_created_time(i);
   }
 
-  size_t counter = 0;
+  // transactions are validated concurrently, so the invalid one is selected
+  // by its content instead of the order of calls
   EXPECT_CALL(*proto_tx_validator, validate(_))
       .Times(kTimes)
       .WillRepeatedly(Return(shared_model::validation::Answer{}));
   EXPECT_CALL(*tx_validator, validate(_))
       .Times(kTimes)
-      .WillRepeatedly(Invoke([this, &counter, kError](const auto &) mutable {
+      .WillRepeatedly(Invoke([this, kError](const auto &tx) {
         shared_model::validation::Answer res;
-        if (counter++ == kTimes - 1) {
+        if (tx.createdTime() == kTimes - 1) {
           res.addReason(std::make_pair(kError, std::vector<std::string>{}));
         }
         return res;
@@ -241,6 +268,52 @@ TEST_F(CommandServiceTransportGrpcTest, ListToriiPartialInvalid) {
   transport_grpc->ListTorii(&context, &request, &response);
 }
 
+/**
+ * @given torii service and a list of many valid transactions
+ * @when calling ListTorii, which validates the transactions concurrently
+ * @then batches are created in the order of transactions in the list
+ */
+TEST_F(CommandServiceTransportGrpcTest, ListToriiKeepsOrder) {
+  grpc::ServerContext context;
+  google::protobuf::Empty response;
+  const size_t kTransactions = 100;
+
+  iroha::protocol::TxList request;
+  for (size_t i = 0; i < kTransactions; ++i) {
+    request.add_transactions()
+        ->mutable_payload()
+        ->mutable_reduced_payload()
+        ->set_created_time(i);
+  }
+
+  EXPECT_CALL(*proto_tx_validator, validate(_))
+      .Times(kTransactions)
+      .WillRepeatedly(Return(shared_model::validation::Answer{}));
+  EXPECT_CALL(*tx_validator, validate(_))
+      .Times(kTransactions)
+      .WillRepeatedly(Return(shared_model::validation::Answer{}));
+  std::vector<shared_model::interface::types::TimestampType> created_times;
+  EXPECT_CALL(
+      *batch_factory,
+      createTransactionBatch(
+          A<const shared_model::interface::types::SharedTxsCollectionType &>()))
+      .Times(kTransactions)
+      .WillRepeatedly(Invoke([&created_times](const auto &txs) {
+        for (const auto &tx : txs) {
+          created_times.push_back(tx->createdTime());
+        }
+        return MockTransactionBatchFactory::FactoryResult<
+            std::unique_ptr<shared_model::interface::TransactionBatch>>{};
+      }));
+  EXPECT_CALL(*command_service, handleTransactionBatch(_))
+      .Times(kTransactions);
+
+  transport_grpc->ListTorii(&context, &request, &response);
+
+  ASSERT_EQ(created_times.size(), kTransactions);
+  EXPECT_TRUE(std::is_sorted(created_times.begin(), created_times.end()));
+}
+
 /**
  * @given torii service and command_service with empty status stream
  * @when calling StatusStream on transport
@@ -248,26 +321,23 @@ TEST_F(CommandServiceTransportGrpcTest, ListToriiPartialInvalid) {
  *       and nothing is written to the status stream
  */
 TEST_F(CommandServiceTransportGrpcTest, StatusStreamEmpty) {
-  grpc::ServerContext context;
   iroha::protocol::TxStatusRequest request;
 
   EXPECT_CALL(*command_service, getStatusStream(_))
       .WillOnce(Return(rxcpp::observable<>::empty<std::shared_ptr<
                            shared_model::interface::TransactionResponse>>()));
 
-  ASSERT_TRUE(transport_grpc->StatusStream(&context, &request, nullptr).ok());
+  ASSERT_TRUE(statusStream(request).empty());
 }
 
 /**
  * @given torii service with changed timeout, a transaction
  *        and a status stream with one NotRecieved status
  * @when calling StatusStream
- * @then ServerWriter calls Write method
+ * @then the status is written to the stream
  */
 TEST_F(CommandServiceTransportGrpcTest, StatusStreamOnNotReceived) {
-  grpc::ServerContext context;
   iroha::protocol::TxStatusRequest request;
-  iroha::MockServerWriter<iroha::protocol::ToriiResponse> response_writer;
 
   std::vector<std::shared_ptr<shared_model::interface::TransactionResponse>>
       responses;
@@ -275,18 +345,31 @@ TEST_F(CommandServiceTransportGrpcTest, StatusStreamOnNotReceived) {
   responses.emplace_back(status_factory->makeNotReceived(hash, {}));
   EXPECT_CALL(*command_service, getStatusStream(_))
       .WillOnce(Return(rxcpp::observable<>::iterate(responses)));
-  EXPECT_CALL(response_writer,
-              Write(Property(&iroha::protocol::ToriiResponse::tx_hash,
-                             StrEq(hash.hex())),
-                    _))
-      .WillOnce(Return(true));
-
-  ASSERT_TRUE(transport_grpc
-                  ->StatusStream(
-                      &context,
-                      &request,
-                      reinterpret_cast<
-                          grpc::ServerWriter<iroha::protocol::ToriiResponse> *>(
-                          &response_writer))
-                  .ok());
+
+  auto written = statusStream(request);
+  ASSERT_EQ(written.size(), 1);
+  ASSERT_EQ(written[0].tx_hash(), hash.hex());
+}
+
+/**
+ * @given torii service and a status stream with a repeated status
+ * @when calling StatusStream
+ * @then only changes of the status are written, in order of their arrival
+ */
+TEST_F(CommandServiceTransportGrpcTest, StatusStreamWritesStatusChanges) {
+  iroha::protocol::TxStatusRequest request;
+
+  shared_model::crypto::Hash hash("1");
+  std::vector<std::shared_ptr<shared_model::interface::TransactionResponse>>
+      responses{status_factory->makeNotReceived(hash, {}),
+                status_factory->makeNotReceived(hash, {}),
+                status_factory->makeEnoughSignaturesCollected(hash, {})};
+  EXPECT_CALL(*command_service, getStatusStream(_))
+      .WillOnce(Return(rxcpp::observable<>::iterate(responses)));
+
+  auto written = statusStream(request);
+  ASSERT_EQ(written.size(), 2);
+  ASSERT_EQ(written[0].tx_status(), iroha::protocol::TxStatus::NOT_RECEIVED);
+  ASSERT_EQ(written[1].tx_status(),
+            iroha::protocol::TxStatus::ENOUGH_SIGNATURES_COLLECTED);
 }
@@ -28,8 +28,10 @@ using ::testing::A;
 using ::testing::ByMove;
 using ::testing::ByRef;
 using ::testing::Eq;
+using ::testing::Ref;
 using ::testing::Return;
 using ::testing::ReturnArg;
+using ::testing::SizeIs;
 
 class SignaturesSubset : public testing::Test {
  public:
@@ -335,3 +337,57 @@ TEST_F(Validator, Batches) {
   EXPECT_EQ(verified_proposal_and_errors->rejected_transactions[1].tx_hash,
             txs[4].hash());
 }
+
+/**
+ * @given transfers, two of which use the same account
+ * @when statefully validating these transactions
+ * @then transfers are validated on two forks of the temporary wsv, one for
+ * the transfers using the same account and one for the other transfer @and
+ * verified proposal and errors are in the order of the proposal
+ */
+TEST_F(Validator, IndependentTransactionsInForks) {
+  auto transfer = [](const std::string &src, const std::string &dest) {
+    return TestTransactionBuilder()
+        .creatorAccountId(src)
+        .createdTime(iroha::time::now())
+        .quorum(1)
+        .transferAsset(src, dest, "coin#test", "", "1.0")
+        .build();
+  };
+  std::vector<shared_model::proto::Transaction> txs{
+      transfer("a@test", "b@test"),
+      transfer("c@test", "d@test"),
+      transfer("b@test", "e@test")};
+  auto proposal = TestProposalBuilder()
+                      .createdTime(iroha::time::now())
+                      .height(3)
+                      .transactions(txs)
+                      .build();
+
+  auto first_fork = std::make_unique<iroha::ametsuchi::MockTemporaryWsv>();
+  auto second_fork = std::make_unique<iroha::ametsuchi::MockTemporaryWsv>();
+  EXPECT_CALL(*first_fork, apply(Eq(ByRef(txs[0]))))
+      .WillOnce(Return(iroha::expected::Value<void>({})));
+  EXPECT_CALL(*first_fork, apply(Eq(ByRef(txs[2]))))
+      .WillOnce(Return(iroha::expected::makeError(
+          CommandError{"", sample_error_code, sample_error_extra, true})));
+  EXPECT_CALL(*second_fork, apply(Eq(ByRef(txs[1]))))
+      .WillOnce(Return(iroha::expected::Value<void>({})));
+  EXPECT_CALL(*temp_wsv_mock, join(Ref(*first_fork)));
+  EXPECT_CALL(*temp_wsv_mock, join(Ref(*second_fork)));
+  EXPECT_CALL(*temp_wsv_mock, fork(SizeIs(2)))
+      .WillOnce(Return(ByMove(std::move(first_fork))));
+  EXPECT_CALL(*temp_wsv_mock, fork(SizeIs(1)))
+      .WillOnce(Return(ByMove(std::move(second_fork))));
+  EXPECT_CALL(*temp_wsv_mock, apply(_)).Times(0);
+
+  auto verified_proposal_and_errors = sfv->validate(proposal, *temp_wsv_mock);
+  const auto &verified_txs =
+      verified_proposal_and_errors->verified_proposal->transactions();
+  ASSERT_EQ(verified_txs.size(), 2);
+  EXPECT_EQ(verified_txs[0], txs[0]);
+  EXPECT_EQ(verified_txs[1], txs[1]);
+  ASSERT_EQ(verified_proposal_and_errors->rejected_transactions.size(), 1);
+  EXPECT_EQ(verified_proposal_and_errors->rejected_transactions[0].tx_hash,
+            txs[2].hash());
+}
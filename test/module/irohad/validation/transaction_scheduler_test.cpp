@@ -0,0 +1,108 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "validation/impl/transaction_scheduler.hpp"
+
+#include <gtest/gtest.h>
+#include "datetime/time.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace iroha::validation;
+
+class TransactionSchedulerTest : public testing::Test {
+ public:
+  /**
+   * @return read and write set of a transfer from the creator
+   */
+  ReadWriteSet transfer(const std::string &src, const std::string &dest) {
+    std::vector<shared_model::proto::Transaction> txs{
+        TestTransactionBuilder()
+            .creatorAccountId(src)
+            .createdTime(iroha::time::now())
+            .quorum(1)
+            .transferAsset(src, dest, "coin#test", "", "1.0")
+            .build()};
+    return *readWriteSet(txs);
+  }
+};
+
+/**
+ * @given a transaction with asset commands and a transaction creating an
+ * account
+ * @when read and write sets are computed
+ * @then balances are written by the first one @and the set of the second one
+ * is unknown
+ */
+TEST_F(TransactionSchedulerTest, ReadWriteSet) {
+  std::vector<shared_model::proto::Transaction> assets{
+      TestTransactionBuilder()
+          .creatorAccountId("a@test")
+          .createdTime(iroha::time::now())
+          .quorum(1)
+          .addAssetQuantity("coin#test", "1.0")
+          .transferAsset("a@test", "b@test", "coin#test", "", "1.0")
+          .build()};
+  auto set = readWriteSet(assets);
+  ASSERT_TRUE(set);
+  EXPECT_EQ(set->writes,
+            (std::unordered_set<std::string>{"balance/a@test/coin#test",
+                                             "balance/b@test/coin#test"}));
+  EXPECT_EQ(1, set->reads.count("permissions/a@test"));
+  EXPECT_EQ(1, set->reads.count("permissions/b@test"));
+
+  std::vector<shared_model::proto::Transaction> accounts{
+      TestTransactionBuilder()
+          .creatorAccountId("a@test")
+          .createdTime(iroha::time::now())
+          .quorum(1)
+          .addAssetQuantity("coin#test", "1.0")
+          .createAccount("c", "test", shared_model::crypto::PublicKey("c"))
+          .build()};
+  EXPECT_FALSE(readWriteSet(accounts));
+}
+
+/**
+ * @given transfers between disjoint pairs of accounts
+ * @when they are partitioned
+ * @then every transfer is in its own group
+ */
+TEST_F(TransactionSchedulerTest, DisjointTransfers) {
+  auto groups = conflictFreeGroups({transfer("a@test", "b@test"),
+                                    transfer("c@test", "d@test"),
+                                    transfer("e@test", "f@test")});
+  EXPECT_EQ(groups, (std::vector<std::vector<size_t>>{{0}, {1}, {2}}));
+}
+
+/**
+ * @given transfers forming chains through common accounts
+ * @when they are partitioned
+ * @then transfers of a chain are in the same group in their order
+ */
+TEST_F(TransactionSchedulerTest, ChainedTransfers) {
+  auto groups = conflictFreeGroups({transfer("a@test", "b@test"),
+                                    transfer("c@test", "d@test"),
+                                    transfer("b@test", "e@test"),
+                                    transfer("f@test", "g@test"),
+                                    transfer("d@test", "a@test")});
+  EXPECT_EQ(groups, (std::vector<std::vector<size_t>>{{0, 1, 2, 4}, {3}}));
+}
+
+/**
+ * @given sets which only read the same part of the state @and a set which
+ * writes it later
+ * @when they are partitioned
+ * @then readers are independent of each other @and all of them are in the
+ * group of the writer
+ */
+TEST_F(TransactionSchedulerTest, ReadersAndWriter) {
+  ReadWriteSet reader1{{"x"}, {"a"}};
+  ReadWriteSet reader2{{"x"}, {"b"}};
+  ReadWriteSet other{{"y"}, {"c"}};
+  ReadWriteSet writer{{}, {"x"}};
+  EXPECT_EQ(conflictFreeGroups({reader1, reader2, other}),
+            (std::vector<std::vector<size_t>>{{0}, {1}, {2}}));
+  EXPECT_EQ(conflictFreeGroups({reader1, other, reader2, writer}),
+            (std::vector<std::vector<size_t>>{{0, 2, 3}, {1}}));
+}
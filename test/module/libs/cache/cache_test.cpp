@@ -5,6 +5,9 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+
 #include "cache/cache.hpp"
 #include "endpoint.pb.h"
 
@@ -31,22 +34,26 @@ TEST(CacheTest, InsertValues) {
 
 /**
  * @given initialized cache
- * @when insert cache.getIndexSizeHigh() items into it + 1
- * @then after the last insertion amount of items should decrease to
- * cache.getIndexSizeLow()
+ * @when insert cache.getCapacity() items into it + 1
+ * @then after the last insertion amount of items stays at the capacity and
+ * one item is evicted
  */
 TEST(CacheTest, InsertMoreThanLimit) {
   Cache<std::string, ToriiResponse> cache;
-  for (uint32_t i = 0; i < cache.getIndexSizeHigh(); ++i) {
+  for (size_t i = 0; i < cache.getCapacity(); ++i) {
     ToriiResponse response;
     response.set_tx_status(TxStatus::STATEFUL_VALIDATION_FAILED);
     cache.addItem("abcdefg" + std::to_string(i), response);
   }
-  ASSERT_EQ(cache.getCacheItemCount(), cache.getIndexSizeHigh());
+  ASSERT_LE(cache.getCacheItemCount(), cache.getCapacity());
+  auto count = cache.getCacheItemCount();
   ToriiResponse resp;
   resp.set_tx_status(TxStatus::COMMITTED);
   cache.addItem("1234", resp);
-  ASSERT_EQ(cache.getCacheItemCount(), cache.getIndexSizeLow());
+  ASSERT_LE(cache.getCacheItemCount(), count + 1);
+  ASSERT_EQ(cache.getCacheItemCount() + cache.getMetrics().evictions,
+            cache.getCapacity() + 1);
+  ASSERT_TRUE(cache.findItem("1234"));
 }
 
 /**
@@ -102,18 +109,20 @@ TEST(CacheTest, FindInEmptyCache) {
 }
 
 /**
- * @given Initialized cache
- * @when insert cache.getIndexSizeHigh() items into it + 1
+ * @given Initialized cache with a single shard, since eviction order is kept
+ * within a shard
+ * @when insert cache.getCapacity() items into it + 1
  * @then the oldest inserted item was in cache initially but not in cache
  * anymore
  */
 TEST(CacheTest, FindVeryOldTransaction) {
-  Cache<std::string, ToriiResponse> cache;
+  Cache<std::string, ToriiResponse> cache(
+      Cache<std::string, ToriiResponse>::kDefaultCapacity, 1);
   ToriiResponse resp;
   resp.set_tx_status(TxStatus::COMMITTED);
   cache.addItem("0", resp);
   ASSERT_EQ(cache.findItem("0")->tx_status(), TxStatus::COMMITTED);
-  for (uint32_t i = 0; i < cache.getIndexSizeHigh(); ++i) {
+  for (size_t i = 0; i < cache.getCapacity(); ++i) {
     ToriiResponse response;
     response.set_tx_status(TxStatus::STATEFUL_VALIDATION_FAILED);
     cache.addItem("abcdefg" + std::to_string(i), response);
@@ -161,21 +170,126 @@ TEST(CacheTest, CustomHasher) {
 
 /**
  * @given initialized cache with given parameters
- * @when insert cache.getIndexSizeHigh() items into it + 1
- * @then after the last insertion amount of items should decrease to
- * cache.getIndexSizeLow()
+ * @when insert cache.getCapacity() items into it + 1
+ * @then after the last insertion the oldest item is evicted
  */
 TEST(CacheTest, InsertCustomSize) {
   Cache<std::string, std::string> cache(1, 1);
   cache.addItem("key", "value");
-  ASSERT_EQ(cache.getCacheItemCount(), cache.getIndexSizeHigh());
+  ASSERT_EQ(cache.getCacheItemCount(), cache.getCapacity());
   auto val = cache.findItem("key");
   ASSERT_TRUE(val);
   ASSERT_EQ(val.value(), "value");
   cache.addItem("key2", "value2");
-  ASSERT_EQ(cache.getCacheItemCount(), cache.getIndexSizeLow());
+  ASSERT_EQ(cache.getCacheItemCount(), cache.getCapacity());
   val = cache.findItem("key");
   ASSERT_FALSE(val);
   ASSERT_TRUE(cache.findItem("key2"));
   ASSERT_EQ(cache.findItem("key2").value(), "value2");
 }
+
+/**
+ * @given full cache with a single shard
+ * @when the oldest item is found and a new item is inserted
+ * @then the found item stays in cache, the least recently used one is evicted
+ */
+TEST(CacheTest, FindRefreshesRecency) {
+  Cache<std::string, std::string> cache(2, 1);
+  cache.addItem("first", "1");
+  cache.addItem("second", "2");
+  ASSERT_TRUE(cache.findItem("first"));
+  cache.addItem("third", "3");
+  ASSERT_TRUE(cache.findItem("first"));
+  ASSERT_FALSE(cache.findItem("second"));
+  ASSERT_TRUE(cache.findItem("third"));
+}
+
+/**
+ * @given full cache with a single shard
+ * @when an existing item is inserted again and a new item is inserted
+ * @then the reinserted item stays in cache, there is no duplicate of it
+ */
+TEST(CacheTest, ReinsertRefreshesRecency) {
+  Cache<std::string, std::string> cache(2, 1);
+  cache.addItem("first", "1");
+  cache.addItem("second", "2");
+  cache.addItem("first", "10");
+  cache.addItem("third", "3");
+  ASSERT_EQ(cache.getCacheItemCount(), 2);
+  ASSERT_EQ(cache.findItem("first").value(), "10");
+  ASSERT_FALSE(cache.findItem("second"));
+}
+
+/**
+ * @given cache
+ * @when items are inserted, found and missed
+ * @then counters reflect the use
+ */
+TEST(CacheTest, Metrics) {
+  Cache<std::string, std::string> cache(1, 1);
+  cache.addItem("key", "value");
+  cache.findItem("key");
+  cache.findItem("other");
+  cache.addItem("key2", "value2");
+
+  auto metrics = cache.getMetrics();
+  ASSERT_EQ(metrics.hits, 1);
+  ASSERT_EQ(metrics.misses, 1);
+  ASSERT_EQ(metrics.insertions, 2);
+  ASSERT_EQ(metrics.evictions, 1);
+}
+
+/// Weight of an item is the length of its value
+struct LengthWeigher {
+  size_t operator()(const std::string &, const std::string &value) const {
+    return value.size();
+  }
+};
+
+/**
+ * @given cache with capacity in bytes of values
+ * @when items exceeding the capacity in total are inserted
+ * @then least recently used items are evicted until the rest fits
+ */
+TEST(CacheTest, WeightedCapacity) {
+  Cache<std::string, std::string, std::hash<std::string>, LengthWeigher>
+      cache(10, 1);
+  cache.addItem("a", "1234");
+  cache.addItem("b", "1234");
+  ASSERT_EQ(cache.getCacheItemCount(), 2);
+  cache.addItem("c", "12345");
+  ASSERT_FALSE(cache.findItem("a"));
+  ASSERT_TRUE(cache.findItem("b"));
+  ASSERT_TRUE(cache.findItem("c"));
+}
+
+/**
+ * @given cache
+ * @when items are inserted and found from several threads
+ * @then every thread finds its items and capacity is not exceeded
+ */
+TEST(CacheTest, ConcurrentAccess) {
+  constexpr size_t kThreads = 4;
+  constexpr size_t kItems = 1000;
+  Cache<std::string, size_t> cache(kThreads * kItems);
+
+  std::vector<std::thread> threads;
+  std::atomic<size_t> found{0};
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < kItems; ++i) {
+        auto key = std::to_string(t) + "_" + std::to_string(i);
+        cache.addItem(key, i);
+        if (cache.findItem(key) == i) {
+          ++found;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(found, kThreads * kItems);
+  ASSERT_LE(cache.getCacheItemCount(), cache.getCapacity());
+}
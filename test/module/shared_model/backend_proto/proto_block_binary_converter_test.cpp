@@ -0,0 +1,142 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "backend/protobuf/proto_block_binary_converter.hpp"
+
+#include <gtest/gtest.h>
+#include "cryptography/crypto_provider/crypto_defaults.hpp"
+#include "datetime/time.hpp"
+#include "framework/result_fixture.hpp"
+#include "module/shared_model/builders/protobuf/test_block_builder.hpp"
+#include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
+
+using namespace shared_model;
+using namespace framework::expected;
+
+class ProtoBlockBinaryConverterTest : public ::testing::Test {
+ public:
+  proto::Block makeBlock() {
+    auto tx =
+        TestTransactionBuilder()
+            .createdTime(iroha::time::now())
+            .creatorAccountId("admin@test")
+            .quorum(1)
+            .transferAsset("admin@test", "user@test", "coin#test", "", "1.0")
+            .build();
+    return TestBlockBuilder()
+        .height(5)
+        .createdTime(iroha::time::now())
+        .prevHash(crypto::Hash(std::string(32, '1')))
+        .transactions(std::vector<proto::Transaction>{tx})
+        .build();
+  }
+
+  proto::ProtoBlockBinaryConverter converter;
+};
+
+/**
+ * @given block
+ * @when it is serialized and deserialized back
+ * @then the restored block is equal to the original one
+ */
+TEST_F(ProtoBlockBinaryConverterTest, SerializeDeserialize) {
+  auto block = makeBlock();
+
+  auto record = val(converter.serialize(block));
+  ASSERT_TRUE(record);
+  ASSERT_TRUE(proto::ProtoBlockBinaryConverter::isBinary(record->value));
+
+  auto restored = val(converter.deserialize(record->value));
+  ASSERT_TRUE(restored);
+  ASSERT_EQ(*restored->value, block);
+}
+
+/**
+ * @given block signed after it was built
+ * @when it is serialized and deserialized back
+ * @then the restored block has the signature
+ */
+TEST_F(ProtoBlockBinaryConverterTest, SerializeSignedBlock) {
+  auto block = makeBlock();
+  auto keypair = crypto::DefaultCryptoAlgorithmType::generateKeypair();
+  ASSERT_TRUE(block.addSignature(
+      crypto::DefaultCryptoAlgorithmType::sign(block.payload(), keypair),
+      keypair.publicKey()));
+
+  auto record = val(converter.serialize(block));
+  ASSERT_TRUE(record);
+
+  auto restored = val(converter.deserialize(record->value));
+  ASSERT_TRUE(restored);
+  ASSERT_EQ(1, boost::size(restored->value->signatures()));
+  ASSERT_EQ(keypair.publicKey(),
+            restored->value->signatures().front().publicKey());
+  ASSERT_EQ(*restored->value, block);
+}
+
+/**
+ * @given block serialized to json
+ * @when it is deserialized with binary converter
+ * @then the legacy record is parsed and equal to the original block
+ */
+TEST_F(ProtoBlockBinaryConverterTest, ReadsLegacyJson) {
+  auto block = makeBlock();
+
+  auto json = val(proto::ProtoBlockJsonConverter().serialize(block));
+  ASSERT_TRUE(json);
+  ASSERT_FALSE(proto::ProtoBlockBinaryConverter::isBinary(json->value));
+
+  auto restored = val(converter.deserialize(json->value));
+  ASSERT_TRUE(restored);
+  ASSERT_EQ(*restored->value, block);
+}
+
+/**
+ * @given serialized block with a corrupted payload byte
+ * @when it is deserialized
+ * @then checksum mismatch error is returned
+ */
+TEST_F(ProtoBlockBinaryConverterTest, CorruptedPayload) {
+  auto record = val(converter.serialize(makeBlock()));
+  ASSERT_TRUE(record);
+  record->value.back() ^= 0x1;
+
+  ASSERT_TRUE(err(converter.deserialize(record->value)));
+}
+
+/**
+ * @given serialized block with cut tail
+ * @when it is deserialized
+ * @then size mismatch error is returned
+ */
+TEST_F(ProtoBlockBinaryConverterTest, TruncatedRecord) {
+  auto record = val(converter.serialize(makeBlock()));
+  ASSERT_TRUE(record);
+  record->value.resize(record->value.size() - 1);
+
+  ASSERT_TRUE(err(converter.deserialize(record->value)));
+}
+
+/**
+ * @given binary and json records placed in a buffer not owned by a string
+ * @when they are deserialized from the array
+ * @then both are parsed and equal to the original block
+ */
+TEST_F(ProtoBlockBinaryConverterTest, DeserializeFromArray) {
+  auto block = makeBlock();
+
+  auto record = val(converter.serialize(block));
+  ASSERT_TRUE(record);
+  auto json = val(proto::ProtoBlockJsonConverter().serialize(block));
+  ASSERT_TRUE(json);
+
+  for (const auto &serialized : {record->value, json->value}) {
+    std::vector<char> buffer(serialized.begin(), serialized.end());
+    auto restored =
+        val(converter.deserializeFromArray(buffer.data(), buffer.size()));
+    ASSERT_TRUE(restored);
+    ASSERT_EQ(*restored->value, block);
+  }
+}
@@ -9,6 +9,7 @@
 
 #include "cryptography/crypto_provider/crypto_model_signer.hpp"
 #include "cryptography/crypto_provider/crypto_verifier.hpp"
+#include "cryptography/ed25519_sha3_impl/verifier.hpp"
 #include "module/shared_model/builders/protobuf/test_block_builder.hpp"
 #include "module/shared_model/builders/protobuf/test_query_builder.hpp"
 #include "module/shared_model/builders/protobuf/test_transaction_builder.hpp"
@@ -194,3 +195,36 @@ TEST_F(CryptoUsageTest, SignAndVerifyTransactionkWithWrongSignature) {
 
   ASSERT_FALSE(verify(*transaction));
 }
+
+/**
+ * @given data signed by many keys, enough to be verified by several threads
+ * @when the signatures are verified in a batch
+ * @then the batch is verified
+ * AND the batch is not verified if any of the signatures is wrong
+ */
+TEST_F(CryptoUsageTest, BatchVerify) {
+  const size_t kSignatures = 4 * Verifier::kMinItemsPerThread;
+  Blob wrong_data("wrong payload");
+  std::vector<Keypair> keypairs;
+  std::vector<Signed> signatures;
+  for (size_t i = 0; i < kSignatures; ++i) {
+    keypairs.push_back(DefaultCryptoAlgorithmType::generateKeypair());
+    signatures.push_back(DefaultCryptoAlgorithmType::sign(data, keypairs[i]));
+  }
+  auto batch = [&](size_t wrong_index) {
+    VerificationBatch batch;
+    for (size_t i = 0; i < kSignatures; ++i) {
+      batch.push_back(VerificationItem{signatures[i],
+                                       i == wrong_index ? wrong_data : data,
+                                       keypairs[i].publicKey()});
+    }
+    return batch;
+  };
+
+  ASSERT_TRUE(CryptoVerifier<>::batchVerify(batch(kSignatures)));
+  ASSERT_TRUE(CryptoVerifier<>::batchVerify(VerificationBatch{}));
+  for (auto wrong_index : {size_t{0}, kSignatures / 2, kSignatures - 1}) {
+    ASSERT_FALSE(CryptoVerifier<>::batchVerify(batch(wrong_index)))
+        << "signature " << wrong_index << " is wrong";
+  }
+}